@@ -0,0 +1,219 @@
+#!/usr/bin/env python3
+"""
+   File: mqttFlakyBroker.py
+   Project: PixelRadio, an RBDS/RDS FM Transmitter (QN8027 Digital FM IC)
+   Version: 1.1.2
+   Creation: Oct-18-2022
+   Revised:  Oct-18-2022
+   Project Leader: T. Black (thomastech)
+   Contributors: thomastech
+
+   (c) copyright T. Black 2021-2022, Licensed under GNU GPL 3.0 and later, under this
+   license absolutely no warranty is given.
+
+   Unreliable MQTT broker stand-in, for testing the MQTT Controller's Connect Task and reconnect backoff
+   (see src/mqtt.cpp). No extra Python packages are needed.
+
+   It listens for the radio (set its MQTT Broker IP to this PC) and either forwards to a real broker
+   (--broker) or answers by itself (CONNACK, SUBACK, PINGRESP; PUBLISH messages are printed). Each new
+   connection is then:
+     refused      closed at once (--refuse, fraction of connections),
+     stalled      held open with no CONNACK, so the radio's connect times out (--stall),
+     dropped      cut after a random 1..--drop-after secs online (--drop, fraction of connections),
+   and all traffic is delayed by --delay mS (plus up to --jitter mS).
+
+   Examples:
+     python3 mqttFlakyBroker.py --refuse 0.3 --stall 0.2 --drop 0.5 --drop-after 30
+     python3 mqttFlakyBroker.py --broker 192.168.1.10:1883 --delay 200 --jitter 800
+
+   While it runs, change the MQTT Device Name in the Web UI: The radio must keep connecting with the
+   name it started the attempt with. Each connection's client id, topics, and fate are printed.
+"""
+
+import argparse
+import asyncio
+import random
+import sys
+import time
+
+CONNECT = 1
+CONNACK = 2
+PUBLISH = 3
+SUBSCRIBE = 8
+SUBACK = 9
+PINGREQ = 12
+PINGRESP = 13
+DISCONNECT = 14
+
+
+def log(conn_id, msg):
+    print("%s #%u %s" % (time.strftime("%H:%M:%S"), conn_id, msg), flush=True)
+
+
+async def read_packet(reader):
+    """Read one MQTT control packet. Returns (type, flags, body, raw bytes)."""
+    head = await reader.readexactly(1)
+    raw = bytearray(head)
+    length = 0
+    shift = 0
+    while True:
+        byte = (await reader.readexactly(1))[0]
+        raw.append(byte)
+        length |= (byte & 0x7F) << shift
+        shift += 7
+        if not byte & 0x80:
+            break
+        if shift > 21:
+            raise ValueError("bad remaining length")
+    body = await reader.readexactly(length)
+    raw += body
+    return head[0] >> 4, head[0] & 0x0F, body, bytes(raw)
+
+
+def mqtt_str(body, pos):
+    size = (body[pos] << 8) | body[pos + 1]
+    return body[pos + 2:pos + 2 + size].decode("utf-8", "replace"), pos + 2 + size
+
+
+def describe(ptype, flags, body):
+    """Short text for the packets worth showing."""
+    try:
+        if ptype == CONNECT:
+            pos = mqtt_str(body, 0)[1] + 4  # Protocol name, level, flags, keep alive.
+            return "CONNECT client id \"%s\"" % mqtt_str(body, pos)[0]
+        if ptype == PUBLISH:
+            topic, pos = mqtt_str(body, 0)
+            if (flags >> 1) & 0x03:
+                pos += 2  # Packet id.
+            return "PUBLISH %s %s" % (topic, body[pos:].decode("utf-8", "replace"))
+        if ptype == SUBSCRIBE:
+            return "SUBSCRIBE %s" % mqtt_str(body, 2)[0]
+    except (IndexError, UnicodeDecodeError):
+        return "malformed packet type %u" % ptype
+    return None
+
+
+async def late_write(writer, data, args):
+    delay = (args.delay + random.uniform(0, args.jitter)) / 1000.0
+    if delay > 0:
+        await asyncio.sleep(delay)
+    if not writer.is_closing():
+        writer.write(data)
+        await writer.drain()
+
+
+async def standalone(conn_id, reader, writer, args):
+    """Answer the radio without a real broker."""
+    while True:
+        ptype, flags, body, _ = await read_packet(reader)
+        text = describe(ptype, flags, body)
+        if text:
+            log(conn_id, text)
+        if ptype == CONNECT:
+            await late_write(writer, bytes([CONNACK << 4, 2, 0, 0]), args)
+        elif ptype == SUBSCRIBE:
+            await late_write(writer, bytes([SUBACK << 4 | 0, 3, body[0], body[1], 0]), args)
+        elif ptype == PINGREQ:
+            await late_write(writer, bytes([PINGRESP << 4, 0]), args)
+        elif ptype == DISCONNECT:
+            return
+
+
+async def forward(conn_id, reader, writer, args, name):
+    """Copy packets from one side to the other, late."""
+    while True:
+        ptype, flags, body, raw = await read_packet(reader)
+        text = describe(ptype, flags, body) if name == "radio" else None
+        if text:
+            log(conn_id, text)
+        await late_write(writer, raw, args)
+
+
+async def proxy(conn_id, reader, writer, args):
+    host, port = args.broker.rsplit(":", 1)
+    broker_reader, broker_writer = await asyncio.open_connection(host, int(port))
+    try:
+        await asyncio.gather(forward(conn_id, reader, broker_writer, args, "radio"),
+                             forward(conn_id, broker_reader, writer, args, "broker"))
+    finally:
+        broker_writer.close()
+
+
+async def handle(reader, writer, args, counts):
+    counts["conn"] += 1
+    conn_id = counts["conn"]
+    peer = writer.get_extra_info("peername")
+    pick = random.random()
+
+    if pick < args.refuse:
+        counts["refused"] += 1
+        log(conn_id, "%s:%u refused" % peer)
+        writer.close()
+        return
+
+    if pick < args.refuse + args.stall:
+        counts["stalled"] += 1
+        log(conn_id, "%s:%u stalled, no CONNACK" % peer)
+        try:
+            while await reader.read(1024):
+                pass
+        except ConnectionError:
+            pass
+        writer.close()
+        return
+
+    drop_secs = random.uniform(1, args.drop_after) if random.random() < args.drop else None
+    log(conn_id, "%s:%u accepted%s" % (peer + ("" if drop_secs is None else ", drop in %.1f secs" % drop_secs,)))
+    session = proxy(conn_id, reader, writer, args) if args.broker else standalone(conn_id, reader, writer, args)
+
+    try:
+        await asyncio.wait_for(session, drop_secs)
+        log(conn_id, "disconnected by radio")
+    except asyncio.TimeoutError:
+        counts["dropped"] += 1
+        log(conn_id, "dropped")
+    except asyncio.IncompleteReadError:
+        log(conn_id, "closed")
+    except (ConnectionError, ValueError) as err:
+        log(conn_id, "closed (%s)" % (type(err).__name__))
+    writer.close()
+
+
+async def report(counts):
+    while True:
+        await asyncio.sleep(60)
+        print("-- %u connections: %u refused, %u stalled, %u dropped" %
+              (counts["conn"], counts["refused"], counts["stalled"], counts["dropped"]), flush=True)
+
+
+async def main():
+    parser = argparse.ArgumentParser(description="Unreliable MQTT broker stand-in for the PixelRadio MQTT Controller.")
+    parser.add_argument("--port", type=int, default=1883, help="listen port (default 1883)")
+    parser.add_argument("--broker", help="real broker host:port to forward to (default: answer by itself)")
+    parser.add_argument("--refuse", type=float, default=0.2, help="fraction of connections closed at once")
+    parser.add_argument("--stall", type=float, default=0.2, help="fraction of connections never sent a CONNACK")
+    parser.add_argument("--drop", type=float, default=0.5, help="fraction of connections cut while online")
+    parser.add_argument("--drop-after", type=float, default=60, help="cut a dropped connection within this many secs")
+    parser.add_argument("--delay", type=float, default=100, help="added delay, mS")
+    parser.add_argument("--jitter", type=float, default=400, help="random extra delay, up to mS")
+    parser.add_argument("--seed", type=int, help="random seed, repeats a run")
+    args = parser.parse_args()
+
+    if args.refuse + args.stall > 1:
+        parser.error("--refuse + --stall must not be over 1")
+    random.seed(args.seed)
+
+    counts = {"conn": 0, "refused": 0, "stalled": 0, "dropped": 0}
+    server = await asyncio.start_server(lambda r, w: handle(r, w, args, counts), "0.0.0.0", args.port)
+    print("Listening on port %u, %s" % (args.port, ("forwarding to " + args.broker) if args.broker else "standalone"),
+          flush=True)
+    asyncio.ensure_future(report(counts))
+    async with server:
+        await server.serve_forever()
+
+
+if __name__ == "__main__":
+    try:
+        asyncio.run(main())
+    except KeyboardInterrupt:
+        sys.exit(0)
@@ -0,0 +1,205 @@
+#!/usr/bin/env python3
+"""
+   File: serialBinaryClient.py
+   Project: PixelRadio, an RBDS/RDS FM Transmitter (QN8027 Digital FM IC)
+   Version: 1.1.2
+   Creation: Oct-18-2022
+   Revised:  Oct-18-2022
+   Project Leader: T. Black (thomastech)
+   Contributors: thomastech
+
+   (c) copyright T. Black 2021-2022, Licensed under GNU GPL 3.0 and later, under this
+   license absolutely no warranty is given.
+
+   Reference host client for the Serial Controller's Binary Mode (see src/serialFrame.h).
+   Requires pyserial (pip install pyserial).
+
+   Examples:
+     python3 serialBinaryClient.py /dev/ttyUSB0 "rtm=Jingle Bells" "freq=1011"
+     python3 serialBinaryClient.py COM3 --bench 200
+     python3 serialBinaryClient.py COM3 --bench 500 --bench-cmds "gpio19=outhigh,gpio19=outlow"
+
+   --bench sends real command frames (default: GPIO writes and RadioText), so each one goes through
+   the command dispatcher and its rate limits. Replies are counted per command: ok, limited (dropped
+   by a rate limit), or fail. "{n}" in a bench command is replaced by the frame number.
+"""
+
+import argparse
+import json
+import sys
+import time
+
+import serial
+
+ESC_SEQ = b"\x1bbin\r"
+CMD = 0x01
+PING = 0x02
+EXIT = 0x03
+REPLY = 0x80
+NAK = 0xFF
+
+
+def crc16_ccitt(data):
+    crc = 0xFFFF
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else crc << 1
+            crc &= 0xFFFF
+    return crc
+
+
+def cobs_encode(data):
+    out = bytearray([0])
+    code_pos = 0
+    code = 1
+    for byte in data:
+        if byte == 0:
+            out[code_pos] = code
+            code_pos = len(out)
+            out.append(0)
+            code = 1
+            continue
+        out.append(byte)
+        code += 1
+        if code == 0xFF:
+            out[code_pos] = code
+            code_pos = len(out)
+            out.append(0)
+            code = 1
+    out[code_pos] = code
+    return bytes(out)
+
+
+def cobs_decode(data):
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        code = data[i]
+        i += 1
+        if code == 0 or i + code - 1 > len(data):
+            return None
+        out += data[i:i + code - 1]
+        i += code - 1
+        if code != 0xFF and i < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+class PixelRadioBinary:
+    def __init__(self, port, baud, timeout=1.0, retries=3):
+        self.ser = serial.Serial(port, baud, timeout=timeout)
+        self.retries = retries
+        self.seq = 0
+        self.rx = bytearray()
+
+    def start(self):
+        self.ser.reset_input_buffer()
+        self.ser.write(ESC_SEQ)
+        self.ser.flush()
+        time.sleep(0.2)
+        self.ser.reset_input_buffer()  # Drop the text reply and any Serial Log text.
+        return self.ping()
+
+    def close(self):
+        self.transact(EXIT, b"")
+        self.ser.close()
+
+    def send_frame(self, ftype, seq, payload):
+        raw = bytes([ftype, seq]) + payload
+        crc = crc16_ccitt(raw)
+        self.ser.write(b"\x00" + cobs_encode(raw + bytes([crc >> 8, crc & 0xFF])) + b"\x00")
+
+    def read_frame(self):
+        deadline = time.monotonic() + self.ser.timeout
+        while time.monotonic() < deadline:
+            end = self.rx.find(b"\x00")
+            if end < 0:
+                self.rx += self.ser.read(max(1, self.ser.in_waiting))
+                continue
+            frame, self.rx = bytes(self.rx[:end]), self.rx[end + 1:]
+            raw = cobs_decode(frame) if frame else None
+            if raw is None or len(raw) < 4:
+                continue  # Partial frame or log text, resync.
+            if crc16_ccitt(raw[:-2]) != (raw[-2] << 8 | raw[-1]):
+                continue
+            return raw[0], raw[1], raw[2:-2]
+        return None
+
+    def transact(self, ftype, payload):
+        """Send a frame and wait for its reply. A retry keeps the Seq, so a command is never run twice."""
+        self.seq = (self.seq + 1) & 0xFF
+        for _ in range(self.retries + 1):
+            self.send_frame(ftype, self.seq, payload)
+            while True:
+                reply = self.read_frame()
+                if reply is None or reply[0] == NAK:
+                    break  # Timeout or damaged frame, send again.
+                if reply[0] == (ftype | REPLY) and reply[1] == self.seq:
+                    return reply[2].decode("utf-8", "replace")
+        raise TimeoutError("No reply from PixelRadio")
+
+    def command(self, cmd_str):
+        return self.transact(CMD, cmd_str.encode("utf-8"))
+
+    def ping(self):
+        return self.transact(PING, b"") is not None
+
+
+def run_bench(radio, count, cmd_list):
+    """Send count command frames, cycling through cmd_list. Report the frame rate, round trip times and
+    the replies of each command."""
+    stats = {}
+    times = []
+    start = time.monotonic()
+
+    for n in range(count):
+        cmd_str = cmd_list[n % len(cmd_list)]
+        sent = time.monotonic()
+        reply = radio.command(cmd_str.replace("{n}", str(n)))
+        times.append(time.monotonic() - sent)
+        try:
+            result = str(next(iter(json.loads(reply).values())))
+        except (ValueError, StopIteration, AttributeError):
+            result = "bad reply"
+        if result not in ("ok", "limited", "fail"):
+            result = "ok" if result.isdigit() else result  # GPIO read returns the pin state.
+        key = cmd_str.split("=")[0]
+        stats.setdefault(key, {})
+        stats[key][result] = stats[key].get(result, 0) + 1
+
+    secs = time.monotonic() - start
+    times.sort()
+    print("%u command frames in %1.2f secs: %1.1f frames/sec." % (count, secs, count / secs))
+    print("Round trip: mean %1.2f mS, median %1.2f mS, 99%% %1.2f mS, max %1.2f mS." %
+          (secs * 1000.0 / count, times[len(times) // 2] * 1000.0, times[int(len(times) * 0.99)] * 1000.0,
+           times[-1] * 1000.0))
+    for key, results in sorted(stats.items()):
+        print("  %-8s %s" % (key, ", ".join("%s %u" % item for item in sorted(results.items()))))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="PixelRadio Serial Controller Binary Mode client.")
+    parser.add_argument("port", help="Serial port, such as /dev/ttyUSB0 or COM3")
+    parser.add_argument("commands", nargs="*", help='Commands to send, such as "rtm=Hello"')
+    parser.add_argument("--baud", type=int, default=115200, help="Serial Controller baud rate")
+    parser.add_argument("--bench", type=int, metavar="N", help="Send N command frames and report the rate and replies")
+    parser.add_argument("--bench-cmds", default="gpio19=outhigh,gpio19=outlow,rtm=Bench {n}",
+                        help="Comma separated commands sent by --bench, in turn")
+    args = parser.parse_args()
+
+    radio = PixelRadioBinary(args.port, args.baud)
+    radio.start()
+
+    for cmd_str in args.commands:
+        print(cmd_str, "->", radio.command(cmd_str))
+
+    if args.bench:
+        run_bench(radio, args.bench, args.bench_cmds.split(","))
+
+    radio.close()
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
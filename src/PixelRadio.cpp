@@ -83,6 +83,7 @@ bool activeTextHttpFlg   = false;            // HTTP Controller Is Sending Radio
 bool activeTextLocalFlg  = false;            // Local Controller Is Sending RadioText if true.
 bool activeTextMqttFlg   = false;            // MQTT Controller Is Sending RadioText if true.
 bool activeTextSerialFlg = false;            // Serial Controller Is Sending RadioText if true.
+bool activeTextUdpFlg    = false;            // UDP Controller Is Sending RadioText if true.
 
 bool mqttOnlineFlg   = false;                // MQTT is online if true.
 bool newAutoRfFlg    = false;                // new RF Auto Off Setting Avail Semaphore.
@@ -99,13 +100,7 @@ bool newPreEmphFlg   = false;                // New Radio Pre-Emphasis Setting A
 bool newRfPowerFlg   = false;                // New RfPower Setting Avail Semaphore.
 bool newVgaGainFlg   = false;                // New Analog VGA Gain Setting Avail Semaphore.
 bool rebootFlg       = false;                // Reboot System if true;
-bool stopHttpFlg     = false;                // HTTP Controller Stop Command was sent if true.
-bool stopMqttFlg     = false;                // MQTT Controller Stop Command was sent if true.
-bool stopSerialFlg   = false;                // Serial Controller Stop Command was sent if true.
 bool testModeFlg     = false;                // Audio Test Tone Mode if true. Do NOT save in config file.
-bool textSerialFlg   = false;                // Serial supplied RDS Text Avail, #1 Priority.
-bool textHttpFlg     = false;                // HTTP supplied RDS Text Avail,   #2 Priority.
-bool textMqttFlg     = false;                // MQTT supplied RDS Text Avail,   #3 Priority.
 
 uint8_t fmRadioTestCode = FM_TEST_OK;        // FM Radio Module Test Result Code.
 
@@ -114,19 +109,23 @@ uint16_t mqttPort = MQTT_PORT_DEF;           // mqttPort is a Fixed Value. Does
 uint16_t rdsHttpPiCode   = RDS_PI_CODE_DEF;  // HTTP Controller PI Code, can be changed by HTTP Command.
 uint16_t rdsMqttPiCode   = RDS_PI_CODE_DEF;  // MQTT Controller PI Code, can be changed by MQTT Command.
 uint16_t rdsSerialPiCode = RDS_PI_CODE_DEF;  // Serial Controller PI Code, can be changed by Serial Command.
+uint16_t rdsUdpPiCode    = RDS_PI_CODE_DEF;  // UDP Controller PI Code, can be changed by UDP Command.
 
 uint8_t rdsHttpPtyCode   = RDS_PTY_CODE_DEF; // HTTP Controller PTY Code, can be changed by HTTP Command.
 uint8_t rdsMqttPtyCode   = RDS_PTY_CODE_DEF; // MQTT Controller PTY Code, can be changed by MQTT Command.
 uint8_t rdsSerialPtyCode = RDS_PTY_CODE_DEF; // Serial Controller PTY Code, can be changed by Serial Command.
+uint8_t rdsUdpPtyCode    = RDS_PTY_CODE_DEF; // UDP Controller PTY Code, can be changed by UDP Command.
 
 unsigned long rdsHttpMsgTime   = RDS_DSP_TM_DEF;  // HTTP Controller's Message Time Can be Changed by HTTP Command.
 unsigned long rdsLocalMsgTime  = RDS_DSP_TM_DEF;  // Local Controller's Message Time Can be Changed by Web UI.
 unsigned long rdsMsgTime       = RDS_DSP_TM_DEF;  // Global (Master) RDS Message Time. Set by RDS Controllers.
 unsigned long rdsMqttMsgTime   = RDS_DSP_TM_DEF;  // MQTT Controller's Message Time Can be Changed by MQTT Command.
 unsigned long rdsSerialMsgTime = RDS_DSP_TM_DEF;  // Serial Controller's Message Time Can be Changed by Serial Command.
+unsigned long rdsUdpMsgTime    = RDS_DSP_TM_DEF;  // UDP Controller's Message Time Can be Changed by UDP Command.
 
 float vbatVolts = 0.0f;                      // ESP32's Onboard "VBAT" Voltage. Typically 5V.
 float paVolts   = 0.0f;                      // RF Power Amp's Power Supply Voltage. Typically 9V.
+float rdsGroupRate = 0.0f;                   // Measured RDS Group Rate, groups/sec.
 
 String gpio19CtrlStr    = "";                // GPIO-19 State if Changed by Serial/MQTT/HTTP Controller.
 String gpio23CtrlStr    = "";                // GPIO-23 State if Changed by Serial/MQTT/HTTP Controller.
@@ -135,10 +134,12 @@ String ipAddrStr        = "";                // DHCP IP Address;
 String rdsHttpPsnStr    = RDS_PSN_DEF_STR;   // HTTP Supplied Program Service Name.
 String rdsMqttPsnStr    = RDS_PSN_DEF_STR;   // MQTT Supplied Program Service Name.
 String rdsSerialPsnStr  = RDS_PSN_DEF_STR;   // Serial Supplied Program Service Name.
+String rdsUdpPsnStr     = RDS_PSN_DEF_STR;   // UDP Supplied Program Service Name.
 String rdsSerialTextStr = "";                // RDS RadioText for Serial Controller.
 String rdsHttpTextStr   = "";                // RDS RadioText for HTTP Controller.
 String rdsMqttTextStr   = "";                // RDS RadioText for MQTT Controller.
-String rdsTextMsgStr    = "";                // Current RDS RadioText Message.
+String rdsUdpTextStr    = "";                // RDS RadioText for UDP Controller.
+String rdsTextMsgStr    = "";                // On-air RDS RadioText Message, set by processRdsUi().
 
 IPAddress hotSpotIP   = HOTSPOT_IP_DEF;
 IPAddress mqttIP      = MQTT_IP_DEF;
@@ -154,6 +155,7 @@ bool apFallBackFlg = AP_FALLBACK_DEF_FLG;                  // Control, Switch to
 bool ctrlLocalFlg  = CTRL_LOCAL_DEF_FLG;                   // Control, Permit Local Control if true.
 bool ctrlHttpFlg   = CTRL_HTTP_DEF_FLG;                    // Control, Permit HTTP Control if true.
 bool ctrlMqttFlg   = CTRL_MQTT_DEF_FLG;                    // Control, Permit MQTT if true.
+bool ctrlUdpFlg    = CTRL_UDP_DEF_FLG;                     // Control, Permit UDP Control if true.
 // bool ctrlSerialFlg  = CTRL_SERIAL_DEF_FLG;              // Replaced by ctrlSerialFlg() function.
 bool muteFlg        = RADIO_MUTE_DEF_FLG;                  // Control, Mute audio if true.
 bool rfAutoFlg      = RF_AUTO_OFF_DEF_FLG;                 // Control, Turn Off RF carrier if no audio for 60Sec. false=Never turn off.
@@ -230,7 +232,7 @@ void setup()
 
     // Initialize i2c.
     Wire.begin(SDA_PIN, SCL_PIN);
-    Wire.setClock(I2C_FREQ_HZ);     // 100KHz i2c speed.
+    Wire.setClock(I2C_FREQ_HZ);     // 100KHz i2c speed (400KHz if I2C_FAST_MODE).
     pinMode(SCL_PIN, INPUT_PULLUP); // I2C Clock Pin.
 
     // delay(3000);                 // DEBUG ONLY, wait for Platformio's monitor terminal.
@@ -266,6 +268,7 @@ void setup()
     // Setup the File System.
     littlefsInit();
     instalLogoImageFile();
+    initTelemetry();
 
     // Restore System Settings from File System.
     restoreConfiguration(LITTLEFS_MODE, BACKUP_FILE_NAME);
@@ -296,6 +299,7 @@ void setup()
     i2cScanner();                      // Scan the i2c bus and report all devices.
     fmRadioTestCode = initRadioChip(); // If QN8027 fails we will warn user on UI homeTab.
     Log.infoln("FM Radio RDS/RBDS Started.");
+    initRdsTask();                     // Start sending RDS, runs in its own task.
 
     // Startup the Web GUI. DO THIS LAST!
     Log.infoln("Initializing Web UI ...");
@@ -322,7 +326,6 @@ void loop()
     // Background tasks
     serialCommands();       // Process USB Serial Controller Commands.
     processDnsServer();     // AP ESPUI DNS Server
-    processRDS();           // Send any available RadioText.
     processMeasurements();  // Measure the two system voltages.
 
     updateUiRSSI();         // Update the WiFi Signal Strength on UI homeTab & wifiTab.
@@ -330,6 +333,10 @@ void loop()
     updateUiAudioLevel();   // Update the Audio Level value on UI diagtab.
     updateUiDiagTimer();    // Upddate the Elapsed Timer on UI diagTab.
     updateUiVolts();        // Update the two system voltages on UI diagTab.
+    updateUiCmdDrops();     // Update the Command Drop Counts on UI diagTab.
+
+    postRdsLocalJob();      // Hand changed Local Controller RDS settings to the RDS Task.
+    processRdsUi();         // Show the RDS Task's RadioText, Controller, and Timer updates on the UI.
 
     updateRadioSettings();  // Update the QN8027 device registers.
     updateGpioBootPins();   // Update the User Programmable GPIO Pins.
@@ -339,15 +346,16 @@ void loop()
     wifiReconnect();        // Reconnect to WiFi if not connected to router.
     rebootSystem();         // Check to see if Reboot has been requested.
 
+    #ifdef HTTP_ENB
+    updateHttpEvents();     // Publish HTTP Controller status events.
+    #endif // ifdef HTTP_ENB
+
     #ifdef MQTT_ENB
     mqttReconnect(false);
     processMQTT();
+    processTelemetry();     // Save telemetry while MQTT is offline, replay it when back online.
     #endif // ifdef MQTT_ENB
 
-    #ifdef HTTP_ENB
-    processWebClient();     // Process Any Available HTTP RDS commands.
-    #endif // ifdef HTTP_ENB
-
     #ifdef OTA_ENB
     ArduinoOTA.handle(); // OTA Service.
     #endif // ifdef OTA_ENB
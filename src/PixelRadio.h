@@ -40,8 +40,10 @@
 
 // Controller Command Limits
 const uint8_t CMD_AUD_MAX_SZ  = 6;  // AUD Command Arg max length is 6 ("mono" / "stereo").
+const uint16_t CMD_BATCH_MAX_SZ = 320; // BATCH Command Arg max length (JSON object of commands).
 const uint8_t CMD_FREQ_MAX_SZ = 4;  // FREQ Command Arg max length is 4 (879 - 1079).
 const uint8_t CMD_GPIO_MAX_SZ = 7;  // GPIO Cmd Code max length is 7 ("input/inputpd/inputpu/outhigh/outlow/read").
+const uint8_t CMD_INFO_MAX_SZ = 7;  // INFO Cmd Code max length is 7 ("system" / "latency").
 const uint8_t CMD_LOG_MAX_SZ  = 7;  // Serial Log Level Arg max length is 7 ("silent" / "restore");
 const uint8_t CMD_MUTE_MAX_SZ = 3;  // MUTE Command Arg max length is 3 ("on" / "off").
 const uint8_t CMD_PI_MAX_SZ   = 7;  // PI Command Arg max length is 6 (Examples, "ffff" and/or "0xffff"). Add +1 to trap typos.
@@ -73,9 +75,11 @@ const uint8_t CMD_TIME_MAX_SZ = 4;  // Time Command Arg length is 3 (5-900). Add
 #define CMD_RF_ON_STR     "on"
 
 #define CMD_SYS_CODE_STR  "system"
+#define CMD_LATENCY_STR   "latency"
 
 // Controller Command Keywords
 #define  CMD_AUDMODE_STR     "aud"    // Radio Stereo / Mono Audio Mode.
+#define  CMD_BATCH_STR       "batch"  // Several commands (JSON object) applied as one transaction.
 #define  CMD_FREQ_STR        "freq"   // FM Transmit Frequency, value is MHz x10.
 #define  CMD_GPIO_STR        "gpio"   // GPIO Control.
 #define  CMD_GPIO19_STR      "gpio19" // GPIO Pin-19 Control.
@@ -99,6 +103,7 @@ const bool CTRL_DHCP_DEF_FLG   = true;
 const bool CTRL_LOCAL_DEF_FLG  = true;
 const bool CTRL_HTTP_DEF_FLG   = true;
 const bool CTRL_MQTT_DEF_FLG   = true;
+const bool CTRL_UDP_DEF_FLG    = false;
 
 // const bool CTRL_SERIAL_DEF_FLG = true;
 const bool RADIO_MUTE_DEF_FLG  = false;
@@ -114,6 +119,7 @@ const uint8_t SERIAL_CNTRL = 1;
 const uint8_t MQTT_CNTRL   = 2;
 const uint8_t HTTP_CNTRL   = 3;
 const uint8_t LOCAL_CNTRL  = 4;
+const uint8_t UDP_CNTRL    = 5;
 
 // EEPROM: (Currently Not Used in PixelRadio)
 const uint16_t EEPROM_SZ = 32;            // E2Prom Size, must be large enough to hold all values below.
@@ -197,18 +203,24 @@ const int TONE_OFF = 1;
 const int TONE_ON  = 0;
 
 // HTTP Controller
-#define  HTTP_CMD_STR         "/cmd?"             // Command preamble.
-#define  HTTP_EMPTY_RESP_STR  "get /favicon.ico"  // Empty Reply, ignore this payload.
-#define  HTTP_POST_STR        "content-length:"   // Post data length Keyword.
-#define  HTTP_CMD_END_STR     "http/"             // This string marks the End of HTTP Controller Command.
-
-
-const uint16_t HTTP_RESPONSE_MAX_SZ = 225;        // Maximum Chars Allowed in HTTP client response.
+#define  HTTP_BATCH_PATH_STR  "/batch"            // Batch command URL path, POST data is the JSON object.
+#define  HTTP_CMD_PATH_STR    "/cmd"              // Command URL path, command is the first query parameter.
+#define  HTTP_EMPTY_PATH_STR  "/favicon.ico"      // Empty Reply, ignore this request.
+#define  HTTP_EVENTS_PATH_STR "/events"           // Status event stream (Server-Sent Events) URL path.
+const uint8_t  HTTP_EVENT_CLIENT_MAX     = 4;     // Maximum status event stream clients.
+const uint8_t  HTTP_EVENT_RSSI_HYST      = 3;     // RSSI change that sends a status event, in dBm.
+const uint16_t HTTP_EVENT_SZ             = 120 + CMD_RT_MAX_SZ * 2; // Status event size (RadioText may be escaped).
+const unsigned long HTTP_EVENT_KEEP_TIME = 15000; // Status event stream keep-alive time, in mS.
+const unsigned long HTTP_EVENT_TIME      = 250;   // Status event coalescing window, in mS.
 
 // I2C:
 const uint8_t  I2C_QN8027_ADDR = 0x2c;            // I2C Address of QN8027 FM Radio Chip.
 const uint8_t  I2C_DEV_CNT     = 1;               // Number of expected i2c devices on bus.
+#ifdef I2C_FAST_MODE
+const uint32_t I2C_FREQ_HZ     = 400000;          // I2C master clock frequency, Fast Mode (see config.h).
+#else // ifdef I2C_FAST_MODE
 const uint32_t I2C_FREQ_HZ     = 100000;          // I2C master clock frequency
+#endif // ifdef I2C_FAST_MODE
 
 // Measurement:
 const int32_t MEAS_TIME = 50;                     // Measurement Refresh Time, in mS.
@@ -221,10 +233,24 @@ const uint8_t  MQTT_FAIL_CNT       = 10;          // Maximum failed MQTT reconne
 const uint16_t MQTT_KEEP_ALIVE     = 90;          // MQTT Keep Alive Time, in Secs.
 const int32_t  MQTT_MSG_TIME       = 30000;       // MQTT Periodic Message Broadcast Time, in mS.
 const uint8_t  MQTT_NAME_MAX_SZ    = 18;
-const uint8_t  MQTT_PAYLD_MAX_SZ   = 100;         // Must be larger than RDS_TEXT_MAX_SZ.
+const uint8_t  MQTT_NAME_TOPIC_SZ  = MQTT_NAME_MAX_SZ + 14; // Device Name + Topic suffix ("/state/delta", etc) + terminator.
+const uint16_t MQTT_BUFF_SZ        = 512;         // PubSubClient packet buffer size (topic + payload).
+const uint16_t MQTT_PAYLD_MAX_SZ   = CMD_BATCH_MAX_SZ; // Must be larger than RDS_TEXT_MAX_SZ.
+const uint8_t  MQTT_PUB_DRAIN_CNT  = 2;           // MQTT Publish Queue messages sent per processMQTT() pass.
+const uint16_t MQTT_PUB_PAYLD_SZ   = 300;         // MQTT Publish Queue payload size, must hold a command reply (CMD_REPLY_MAX_SZ).
+const uint8_t  MQTT_PUB_QUEUE_CNT  = 8;           // MQTT Publish Queue size, in messages.
 const uint8_t  MQTT_PW_MAX_SZ      = 48;
-const int32_t  MQTT_RECONNECT_TIME = 30000;       // MQTT Reconnect Delay Time, in mS;
-const uint8_t  MQTT_RETRY_CNT      = 6;           // MQTT Reconnection Count (max attempts).
+const uint32_t MQTT_BACKOFF_MAX    = 300000;      // MQTT Reconnect max wait between attempts, in mS.
+const uint32_t MQTT_BACKOFF_MIN    = 2000;        // MQTT Reconnect wait after the first failure, doubles with each failure, in mS.
+const uint8_t  MQTT_BACKOFF_STEPS  = 8;           // MQTT Reconnect wait doubles this many times at most.
+const uint8_t  MQTT_TASK_CORE      = 1;           // MQTT Connect Task runs on the Arduino core.
+const uint8_t  MQTT_TASK_PRIORITY  = 1;           // MQTT Connect Task priority, same as loop(). It waits on the network.
+const uint16_t MQTT_TASK_STACK_SZ  = 4096;        // MQTT Connect Task stack size, in bytes.
+const unsigned long MQTT_STATE_KEY_TIME    = 300000; // MQTT State keyframe is republished at least this often, in mS.
+const unsigned long MQTT_STATE_POLL_TIME   = 250;    // MQTT State is checked for changes this often, in mS.
+const unsigned long MQTT_STATE_SETTLE_TIME = 5000;   // MQTT State keyframe follows a change once it is this old, in mS.
+const uint8_t  MQTT_REPLY_TOPIC_CNT = 4;          // Different command reply topics (/info, /gpio, etc).
+const uint8_t  MQTT_ROUTE_SLOTS    = 32;          // Command Routing Table hash slots, power of 2 and more than the commands.
 const uint8_t  MQTT_TOPIC_MAX_SZ   = 45;
 const uint8_t  MQTT_USER_MAX_SZ    = 48;
 #define MQTT_NAME_DEF_STR "pixelradio"            // Default MQTT Topic / Subscription Name.
@@ -236,9 +262,13 @@ const uint8_t  MQTT_USER_MAX_SZ    = 48;
 #define MQTT_CMD_SUB_STR   "/cmd/#"               // MQTT wildcard Subscription, receive all /cmd messages.
 
 // MQTT Publish Topics
+#define MQTT_BATCH_STR   "/batch"                 // Publish topic, Client MQTT Subscription.
 #define MQTT_CONNECT_STR "/connect"               // Publish topic, Client MQTT Subscription.
 #define MQTT_GPIO_STR    "/gpio"                  // Publish topic, Client MQTT Subscription.
 #define MQTT_INFORM_STR  "/info"                  // Publish topic, Client MQTT Subscription.
+#define MQTT_STATE_STR   "/state"                 // Publish topic (retained), Client MQTT Subscription.
+#define MQTT_DELTA_STR   "/state/delta"           // Publish topic, Client MQTT Subscription.
+#define MQTT_TLM_STR     "/telemetry"             // Publish topic, Client MQTT Subscription.
 #define MQTT_VOLTS_STR   "/volts"                 // Publish topic, Client MQTT Subscription.
 
 // Radio
@@ -261,14 +291,49 @@ const uint8_t  RDS_PSN_MAX_SZ   = CMD_PSN_MAX_SZ; // RDS Program Service Name, M
 const uint8_t  RDS_PTY_CODE_DEF = 9;              // Default RDS PTY Code "Top 40", 0-29 allowed.
 const uint8_t  RDS_PTY_CODE_MIN = 0;              // Min RDS PTY Code "None", See https://en.wikipedia.org/wiki/Radio_Data_System
 const uint8_t  RDS_PTY_CODE_MAX = 29;             // Max RDS PTY Code "Weather".
-const uint8_t  RDS_REFRESH_TM   = 5;              // RadioText Refresh Time, in Seconds.
+const float    RDS_GROUP_RATE_MAX = 1187.5f / 104.0f; // Theoretical RDS Group Rate (1187.5bps, 104 bits/group), ~11.4 groups/sec.
+const unsigned long RDS_RATE_UPD_TIME = 10000;    // RDS Group Rate Report Time, in mS.
+const uint8_t  RDS_SCHED_PSN_CNT  = 4;            // RDS Scheduler Sequence: Send this many 0A (PSN) Groups ...
+const uint8_t  RDS_SCHED_RT_CNT   = 4;            // ... then this many 2A (RadioText) Groups. 4:4 sends one full PSN then 16 RadioText chars.
+                                                  // 4:1 favors PSN, but a 64 char RadioText then takes ~7 secs per cycle (vs ~2.8 secs).
+const uint8_t  RDS_SCHED_QUEUE_CNT = 2;           // RDS Groups the Scheduler keeps queued. Small value = fast message changes.
+const uint8_t  RDS_JOB_QUEUE_CNT = 8;             // RDS Job Queue depth, Controller Jobs waiting for the RDS Task.
+const uint8_t  RDS_JOB_START     = 0;             // RDS Job Action: Load the Controller's RDS values and send them.
+const uint8_t  RDS_JOB_STOP      = 1;             // RDS Job Action: Stop the Controller's RadioText.
+const uint8_t  RDS_LOCAL_MSG_CNT = 3;             // Local Controller RadioText Messages (homeTab Messages 1-3).
+const uint8_t  RDS_TASK_CORE     = 1;             // RDS Task runs on the Arduino core. The WiFi stack uses core 0.
+const uint8_t  RDS_TASK_PRIORITY = 2;             // RDS Task priority, above loop() (priority 1).
+const uint16_t RDS_TASK_STACK_SZ = 4096;          // RDS Task stack size, in bytes.
+const uint8_t  RDS_TASK_TIME     = 2;             // RDS Task service period, in mS.
 const uint8_t  RDS_TEXT_MAX_SZ  = CMD_RT_MAX_SZ;  // RDS RadioText Message, Max Allowed Length.
+const unsigned long RDS_RT_HOLD_TIME = (unsigned long)(1000.0f * (RDS_TEXT_MAX_SZ / 4) * (RDS_SCHED_PSN_CNT + RDS_SCHED_RT_CNT) /
+                                                       RDS_SCHED_RT_CNT / RDS_GROUP_RATE_MAX); // One full PSN + RadioText cycle, in mS.
 
 // RSSI:
 const uint16_t RSSI_UPD_TIME = 2500;              // RSSI GUI Update time (on homeTab), in mS.
 
 // Serial Controller
 #define SERIAL_LOG_STR       "log"                // Serial Log Command Keyword.
+#define SERIAL_BIN_ESC_STR   "\x1b" "bin"        // Escape Sequence (<ESC>bin<CR>) that starts the Binary Mode.
+const unsigned long SERIAL_BIN_IDLE_TIME = 30000; // Binary Mode returns to the text CLI after this time without a good frame, in mS.
+
+// Command Latency Traces (cmdTrace.cpp)
+const uint8_t CMD_TRACE_CNT      = 32; // Traces kept, the oldest is overwritten.
+const uint8_t CMD_TRACE_RX       = 0;  // Trace Stamps: Command received by the controller.
+const uint8_t CMD_TRACE_DISPATCH = 1;  // Command handler runs (dispatchCommand()).
+const uint8_t CMD_TRACE_WIN      = 2;  // Controller won the RDS arbitration, RDS is on-air.
+const uint8_t CMD_TRACE_FIRST    = 3;  // First RadioText group written to the QN8027.
+const uint8_t CMD_TRACE_LAST     = 4;  // Last RadioText group acknowledged by the QN8027.
+const uint8_t CMD_TRACE_STAGES   = 5;
+
+// Telemetry (Offline Buffer)
+#define TLM_FILE_NAME "/telemetry.bin"                  // Telemetry spill file, see TLM_SPILL_ENB in config.h.
+const uint16_t TLM_FILE_MAX_SZ      = 16384;            // Telemetry spill file max size, in bytes.
+const uint8_t  TLM_REPLAY_CNT       = 6;                // Telemetry records per replay message.
+const unsigned long TLM_REPLAY_TIME = 1000;             // Telemetry replay message interval, in mS.
+const uint8_t  TLM_RING_CNT         = 128;              // Telemetry RAM ring size, in records.
+const unsigned long TLM_SAMPLE_TIME = 30000;            // Telemetry measurement record interval, in mS.
+const uint8_t  TLM_SPILL_CNT        = 64;               // Telemetry records moved from the ring to the spill file at once.
 
 // Test Tone
 const uint8_t  TEST_TONE_CHNL = 0;                // Test Tone PWM Channel.
@@ -287,6 +352,15 @@ const uint32_t SECS_PER_HOUR = 3600UL;
 const uint32_t SECS_PER_DAY  = SECS_PER_HOUR * 24UL;
 const uint32_t SECS_PER_MIN  = 60UL;
 
+// UDP Controller
+const uint16_t UDP_PKT_MAX_SZ    = CMD_BATCH_MAX_SZ + 20; // Command datagram max size ("<seq> <cmd>=<arg>").
+const uint8_t  UDP_QUEUE_CNT     = 4;                     // Datagrams waiting for the UDP Task.
+const uint8_t  UDP_SENDER_MAX    = 4;                     // Senders tracked for sequence numbers.
+const unsigned long UDP_SEQ_RESET_TIME = 10000;           // Sender idle time that resets its sequence number, in mS.
+const uint8_t  UDP_TASK_CORE     = 1;                     // UDP Task runs on the Arduino core, same as the RDS Task.
+const uint8_t  UDP_TASK_PRIORITY = 2;                     // UDP Task priority, above loop() (priority 1).
+const uint16_t UDP_TASK_STACK_SZ = 8192;                  // UDP Task stack size, in bytes. Handlers update the Web UI.
+
 // OTA:
 const uint16_t OTA_PORT    = 3232;     // Port for OTA.
 const uint16_t OTA_TIMEOUT = 3000;     // Max allowed time to receive OTA data.
@@ -295,17 +369,23 @@ const uint16_t OTA_TIMEOUT = 3000;     // Max allowed time to receive OTA data.
 const float MIN_VOLTS         = 4.5f;  // Minimum Power Supply volts.
 const float VOLTS_HYSTERESIS  = 0.15f; // Voltage Hysterisis.
 const uint16_t VOLTS_UPD_TIME = 3750;  // Power Supply Volts GUI Update time (on diagTab), in mS.
-const unsigned long CLIENT_TIMEOUT = 500; // Webserver Client Timeout, in mS.
+const unsigned long CLIENT_TIMEOUT = 500; // HTTP Controller Client Timeout, in mS. Checked on AsyncTCP poll (~500mS).
+const unsigned long HTTP_KEEP_ALIVE_TIME = 5000; // HTTP Controller idle connection timeout (between requests), in mS.
+const uint8_t  HTTP_KEEP_ALIVE_MAX = 100;  // HTTP Controller maximum requests per connection.
 
 // Web Server
-#define HTML_HEADER_STR   "HTTP/1.1 200 OK\r\nContent-Type: text/html\r\n\r\n"
+#define HTML_HEADER_STR   "HTTP/1.1 200 OK\r\nContent-Type: text/html\r\n" // Content-Length and Connection follow.
+#define HTML_CONN_CLOSE_STR "Connection: close\r\n\r\n"
+#define HTML_CONN_KEEP_STR  "Connection: keep-alive\r\n\r\n"
 #define HTML_DOCTYPE_STR  "<!DOCTYPE HTML>\r\n<html>"
 #define HTML_CLOSE_STR    "</html>\r\n\r\n"
+#define HTML_EVENT_HEADER_STR "HTTP/1.1 200 OK\r\nContent-Type: text/event-stream\r\nCache-Control: no-cache\r\n\r\n"
 
 // WiFi:
 const uint8_t  AP_NAME_MAX_SZ    = 18;
 const uint16_t DNS_PORT          = 53;   // Webserver DNS port.
 const uint16_t HTTP_PORT         = 8080; // Port for HTTP commands
+const uint16_t UDP_PORT          = 8081; // Port for UDP commands
 const uint8_t  MAX_CON_FAIL_CNT  = 10;   // Max Allowed Connection Attempts before reboot (if WiFiRebootFlg=true)
 const uint8_t  MDNS_NAME_MAX_SZ  = 18;
 const uint8_t  PASSPHRASE_MAX_SZ = 48;
@@ -345,19 +425,115 @@ const IPAddress WIFI_ADDR_DEF   = { 0u, 0u, 0u, 0u };
 const IPAddress HOTSPOT_IP_DEF  = { 192u, 168u, 4u, 1u };
 const IPAddress SUBNET_MASK_DEF = { 255u, 255u, 255u, 0u };
 
+// Command Registry:
+const uint8_t  CMD_REMOTE_CNTRLS   = (1 << SERIAL_CNTRL) | (1 << MQTT_CNTRL) | (1 << HTTP_CNTRL) | (1 << UDP_CNTRL); // Controllers that can use a command.
+const uint8_t  CMD_BATCH_FIELD_MAX = 10;  // Maximum commands in one batch command.
+const uint8_t  CMD_BATCH_NAME_SZ   = 8;   // Batch result command name size, including terminator.
+const uint16_t CMD_REPLY_MAX_SZ    = 40 + CMD_BATCH_FIELD_MAX * (CMD_BATCH_NAME_SZ + 16); // Command JSON reply buffer size.
+// The info reply is 228 chars plus the version and host name, with every count at its maximum.
+static_assert(CMD_REPLY_MAX_SZ >= 230 + sizeof(VERSION_STR) + STA_NAME_MAX_SZ, "CMD_REPLY_MAX_SZ is too small for the info reply.");
+
+// Command Classes, each has its own rate limit (token bucket) per controller.
+const uint8_t  CMD_CLASS_RDS    = 0;  // RDS values (PSN, RadioText, PI, PTY, Time), start/stop.
+const uint8_t  CMD_CLASS_RADIO  = 1;  // Radio settings (Frequency, Audio, Mute, RF Carrier), batch.
+const uint8_t  CMD_CLASS_SYSTEM = 2;  // Info, Log, Reboot.
+const uint8_t  CMD_CLASS_GPIO   = 3;  // GPIO outputs, may be streamed. Not counted in the controller's bucket.
+const uint8_t  CMD_CLASS_CNT    = 4;
+const uint8_t  CMD_CNTRL_ID_MAX = 8;  // Controller IDs are 0-7 (cntrlMask is 8 bits).
+
+// Command Rate Limits (token buckets). Burst = commands accepted back to back, Rate = commands per minute after that.
+// A command must pass its controller's bucket and its class bucket (GPIO: class bucket only). A Rate of zero disables the limit.
+const uint8_t  CMD_CNTRL_BURST  = 20;
+const uint16_t CMD_CNTRL_RATE   = 600;
+const uint8_t  CMD_RDS_BURST    = 8;
+const uint16_t CMD_RDS_RATE     = 120;
+const uint8_t  CMD_RADIO_BURST  = 5;
+const uint16_t CMD_RADIO_RATE   = 30;
+const uint8_t  CMD_SYSTEM_BURST = 5;
+const uint16_t CMD_SYSTEM_RATE  = 60;
+const uint8_t  CMD_GPIO_BURST   = 50;
+const uint16_t CMD_GPIO_RATE    = 6000;
+const unsigned long CMD_DROP_UPD_TIME = 2000; // Command Drop Count GUI Update time (on diagTab), in mS.
+
 // *********************************************************************************************
 
+// RDS Job: A Controller's RDS values, copied when the command is received and queued for the
+// RDS Task. A posted job is never modified, so the two tasks share no RDS strings.
+typedef struct {
+    uint8_t       controller;                    // SERIAL_CNTRL, MQTT_CNTRL, HTTP_CNTRL, or UDP_CNTRL.
+    uint8_t       action;                        // RDS_JOB_START or RDS_JOB_STOP.
+    uint8_t       ptyCode;
+    uint16_t      piCode;
+    unsigned long msgTime;                       // RadioText Display Time, in mS.
+    uint32_t      traceId;                       // Command Latency Trace ID, zero if none.
+    char          psnStr[RDS_PSN_MAX_SZ + 1];
+    char          textStr[RDS_TEXT_MAX_SZ + 1];
+} rdsJob_t;
+
+// Local Controller RDS Job: The Local Controller's settings, copied by loop() when they change and
+// handed to the RDS Task (latest wins). See postRdsLocalJob().
+typedef struct {
+    bool          enbFlg;                        // Local Controller is enabled (ctrlLocalFlg).
+    uint8_t       textEnbMask;                   // Enabled RadioText Messages, bit 0 = Message 1.
+    uint8_t       ptyCode;
+    uint16_t      piCode;
+    unsigned long msgTime;                       // RadioText Display Time, in mS.
+    char          psnStr[RDS_PSN_MAX_SZ + 1];
+    char          textStr[RDS_LOCAL_MSG_CNT][RDS_TEXT_MAX_SZ + 1];
+} rdsLocalJob_t;
+
+// Command Registry Entry: One per controller command, shared by the Serial, MQTT, HTTP, and UDP controllers.
+struct cmdEntry_t;
+typedef void (*cmdReplyFn_t)(char *replyBuff, const cmdEntry_t *cmd, bool successFlg, const String& payloadStr);
+
+struct cmdEntry_t {
+    const char   *nameStr;                       // Command keyword, lower case.
+    const char   *logStr;                        // Command description for the log.
+    bool          (*handler)(String  payloadStr,
+                             uint8_t controller);
+    cmdReplyFn_t  replyFn;                       // JSON reply formatter.
+    uint8_t       cmdClass;                      // Command Class (CMD_CLASS_RDS, etc), for rate limiting.
+    const char   *mqttTopicStr;                  // MQTT reply topic suffix, NULL = no reply.
+    bool          (*checkFn)(String payloadStr); // Argument check, no side effects. NULL = not allowed in a batch.
+    uint16_t      maxSize;                       // Argument max length.
+    uint8_t       pin;                           // GPIO Pin, zero if not a GPIO command.
+    uint8_t       cntrlMask;                     // Controllers allowed to use the command (bit = controller).
+};
+
+// *********************************************************************************************
+
+// Command Latency Trace Prototypes
+void         cmdTraceReply(char       *replyBuff,
+                           const char *nameStr);
+void         endCmdTrace(void);
+uint32_t     getCmdTraceId(void);
+void         stampCmdTrace(uint32_t id,
+                           uint8_t  stage);
+void         startCmdTrace(uint8_t  controller,
+                           uint32_t rxMicros);
+
 // Controller Command Prototypes
 bool    audioModeCmd(String  payloadStr,
                      uint8_t controller);
+bool    batchCmd(String  payloadStr,
+                 uint8_t controller);
 bool    frequencyCmd(String  payloadStr,
                      uint8_t controller);
 bool    infoCmd(String  payloadStr,
                 uint8_t controller);
-int16_t getCommandArg(String& requestStr,
-                      uint8_t maxSize);
+bool    dispatchCommand(const cmdEntry_t *cmd,
+                        String            payloadStr,
+                        uint8_t           controller,
+                        char             *replyBuff,
+                        uint32_t          rxMicros);
+const cmdEntry_t *findCommand(const char *nameStr,
+                              uint8_t     controller);
+const cmdEntry_t *getCommand(uint8_t index);
+int16_t getCommandArg(char    *argStr,
+                      uint16_t maxSize);
+uint32_t getCmdDropCnt(uint8_t controller);
 String  getControllerName(uint8_t controller);
-uint8_t getControllerStatus(void);
+uint16_t getControllerStatus(void);
 bool    gpioCmd(String  payloadStr,
                 uint8_t controller,
                 uint8_t pin);
@@ -390,11 +566,14 @@ void   displayActiveController(uint8_t controller);
 void   displayRdsText(void);
 void   displaySaveWarning(void);
 int8_t getAudioGain(void);
+uint8_t getUiActiveController(void);
+String getUiRdsText(void);
 void   initCustomCss(void);
 void   startGUI(void);
 void   updateUiAudioLevel(void);
 void   updateUiAudioMode(void);
 void   updateUiAudioMute(void);
+void   updateUiCmdDrops(void);
 void   updateUiFreeMemory(void);
 void   updateUiFrequency(void);
 bool   updateUiGpioMsg(uint8_t pin,
@@ -403,6 +582,7 @@ void   updateUiIpaddress(String ipStr);
 void   updateUiLocalMsgTime(void);
 void   updateUiLocalPiCode(void);
 void   updateUiLocalPtyCode(void);
+void   updateUiRdsGroupRate(void);
 void   updateUiRdsText(String textStr);
 void   updateUiRDSTmr(unsigned long rdsMillis);
 void   updateUiRfCarrier(void);
@@ -511,9 +691,11 @@ void         processMeasurements(void);
 
 // Misc Prototypes
 const String addChipID(const char *name);
+unsigned long getClockMillis(void);
 void         initEprom(void);
 uint8_t      i2cScanner(void);
 void         rebootSystem(void);
+void         setClockSource(unsigned long (*source)(void));
 void         setGpioBootPins(void);
 void         spiSdCardShutDown(void);
 bool         strIsUint(String intStr);
@@ -527,10 +709,17 @@ void         updateGpioBootPins(void);
 void         updateTestTones(bool resetTimerFlg);
 
 // MQTT Prototypes
+uint8_t      getMqttPubStats(uint32_t *dropCnt,
+                             uint32_t *mergeCnt);
 void         mqttInit(void);
+bool         mqttPublish(const char *topicStr,
+                         const char *payloadStr,
+                         bool        retainFlg,
+                         bool        coalesceFlg);
 void         mqttReconnect(bool resetFlg);
 void         mqttSendMessages(void);
 void         mqttService(void);
+void         mqttUpdateTopics(void);
 void         processMQTT(void);
 void         updateUiMqttMsg(String msgStr);
 const String returnClientCode(int code);
@@ -543,6 +732,8 @@ bool         calibrateAntenna(void);
 bool         checkRadioIsPresent(void);
 uint8_t      initRadioChip(void);
 uint16_t     measureAudioLevel(void);
+void         radioLock(void);
+void         radioUnlock(void);
 void         setAudioImpedance(void);
 void         setAudioMute(void);
 void         setDigitalGain(void);
@@ -565,8 +756,16 @@ bool         checkLocalRdsAvail(void);
 bool         checkControllerRdsAvail(void);
 bool         checkRemoteRdsAvail(void);
 bool         checkRemoteTextAvail(void);
+uint32_t     getRdsCoalesceCnt(void);
+void         initRdsTask(void);
+bool         postRdsJob(uint8_t controller,
+                        uint8_t action);
+void         postRdsLocalJob(void);
 void         processRDS(void);
+void         processRdsScheduler(void);
+void         processRdsUi(void);
 void         resetControllerRdsValues(void);
+void         resetRdsScheduler(void);
 
 // Serial Controller
 bool         ctrlSerialFlg(void);
@@ -577,11 +776,24 @@ void         serialCommands(void);
 uint8_t      getLogLevel(void);
 void         initSerialLog(bool verbose);
 
+// Telemetry
+void         initTelemetry(void);
+void         logTelemetryCmd(uint8_t controller,
+                             uint8_t cmdIndex);
+void         processTelemetry(void);
+void         setTelemetryAudio(uint16_t mV);
+void         startTelemetryReplay(void);
+
+// UDP Controller
+uint32_t     getUdpStaleCnt(void);
+void         udpInit(void);
+
 // webServer Prototypes
 int8_t       getWifiMode(void);
 int8_t       getRSSI(void);
+void         httpInit(void);
+void         updateHttpEvents(void);
 void         processDnsServer(void);
-void         processWebClient(void);
 void         refresh_mDNS(void);
 void         scanmDNS(void);
 bool         wifiValidateSettings(void);
@@ -589,8 +801,6 @@ bool         wifiConnect(void);
 void         wifiReconnect(void);
 String       getWifiModeStr(void);
 String       IpAddressToString(const IPAddress& ipAddress);
-String       urlDecode(String urlStr);
-uint8_t      urlDecodeHex(char c);
 IPAddress    convertIpString(String ipStr);
 
 // *********************************************************************************************
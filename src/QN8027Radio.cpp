@@ -145,15 +145,15 @@ void QN8027Radio::setFrequency(float frequency)
 	freqH = frequencyH;
 	uint8_t frequencyL = frequencyB & 0XFF;
 	//freqL = frequencyL;
-	write1Byte(SYSTEM_REG,frequencyH);
-	write1Byte(CH1_REG,frequencyL);
+	writeReg(SYSTEM_REG,frequencyH);
+	writeReg(CH1_REG,frequencyL);
 }
 
 /* Get Currently Transmitting Frequency with decimal point */
 float QN8027Radio::getFrequency()
 {
-	uint8_t frequencyH = read1Byte(SYSTEM_REG) & CH0_MASK;
-	uint8_t frequencyL = read1Byte(CH1_REG);
+	uint8_t frequencyH = readReg(SYSTEM_REG) & CH0_MASK;
+	uint8_t frequencyL = readReg(CH1_REG);
 	float freqCombine = (float)(((frequencyH<<8) | frequencyL)*5+7600)/100;
 
 	return freqCombine;
@@ -166,6 +166,7 @@ uint8_t QN8027Radio::read1Byte(uint8_t regAddr)
     uint8_t readData =0xff;
 
 //    noInterrupts();  // Mod by TEB, Feb-01-2022
+	i2cTxnCnt++;
 	Wire.beginTransmission(QN8027_I2C_ADDR);
 	Wire.write(regAddr);
 	Wire.endTransmission();
@@ -186,24 +187,118 @@ uint8_t QN8027Radio::read1Byte(uint8_t regAddr)
 void QN8027Radio::write1Byte(uint8_t regAddr,uint8_t comData)
 {
 //    noInterrupts();  // Mod by TEB, Feb-01-2022
+	i2cTxnCnt++;
 	Wire.beginTransmission(QN8027_I2C_ADDR);
 	Wire.write(regAddr);
 	Wire.write(comData);
     Wire.endTransmission();		//ACK read
 //    interrupts();
+
+	if(regAddr < REG_SHADOW_SIZE){	// Keep the register shadow in sync with the chip.
+		regShadow[regAddr] = comData;
+		regValid |= (1UL << regAddr);
+		regDirty &= ~(1UL << regAddr);
+	}
+}
+
+/* Write several consecutive registers in one I2C transaction.
+	The QN8027 auto-increments the register address after each data byte.
+	regAddr = Address of first Register.
+	comData = data bytes, len = number of registers to write.
+*/
+void QN8027Radio::writeBytes(uint8_t regAddr,const uint8_t *comData,uint8_t len)
+{
+	i2cTxnCnt++;
+	Wire.beginTransmission(QN8027_I2C_ADDR);
+	Wire.write(regAddr);
+	Wire.write(comData,len);
+    Wire.endTransmission();		//ACK read
+
+	for(uint8_t i=0;i<len;i++){
+		uint8_t reg = regAddr + i;
+		if(reg < REG_SHADOW_SIZE){
+			regShadow[reg] = comData[i];
+			regValid |= (1UL << reg);
+			regDirty &= ~(1UL << reg);
+		}
+	}
+}
+
+//---------------------------Register Shadow---------------------------------------------------
+/*
+All setters write through writeReg(). Normally the register is written right away.
+Between beginUpdate() and flush() the new value is only stored in the shadow and its dirty bit is set,
+then flush() writes just the registers that changed, using one burst per run of adjacent registers.
+*/
+void QN8027Radio::writeReg(uint8_t regAddr,uint8_t comData)
+{
+	if(!regDeferFlg || regAddr >= REG_SHADOW_SIZE){
+		write1Byte(regAddr,comData);
+		return;
+	}
+	if(!(regValid & (1UL << regAddr)) || regShadow[regAddr] != comData){
+		regShadow[regAddr] = comData;
+		regDirty |= (1UL << regAddr);
+	}
+}
+
+/* Read a register. Non-volatile registers come from the shadow, no I2C traffic. */
+uint8_t QN8027Radio::readReg(uint8_t regAddr)
+{
+	if(regAddr < REG_SHADOW_SIZE && !(REG_VOLATILE_MASK & (1UL << regAddr)) &&
+	   ((regValid | regDirty) & (1UL << regAddr))){
+		return regShadow[regAddr];
+	}
+	return read1Byte(regAddr);
+}
+
+/* Defer register writes until flush(). */
+void QN8027Radio::beginUpdate()
+{
+	regDeferFlg = true;
+}
+
+/* Write all dirty registers and leave deferred mode. Returns number of I2C transactions used. */
+uint8_t QN8027Radio::flush()
+{
+	uint8_t txnCnt = 0;
+	uint8_t reg = 0;
+
+	regDeferFlg = false;
+	while(regDirty && reg < REG_SHADOW_SIZE){
+		if(!(regDirty & (1UL << reg))){
+			reg++;
+			continue;
+		}
+		uint8_t len = 1;
+		while((reg + len) < REG_SHADOW_SIZE && (regDirty & (1UL << (reg + len)))){
+			len++;
+		}
+		if(len == 1){
+			write1Byte(reg,regShadow[reg]);
+		}else{
+			writeBytes(reg,&regShadow[reg],len);
+		}
+		txnCnt++;
+		reg += len;
+	}
+	return txnCnt;
 }
+
 /* base Function For RDS data sending.
 */
 void QN8027Radio::sendRDS(char By0,char By1,char By2,char By3,char By4,char By5,char By6,char By7){
+	uint8_t grp[RDS_GROUP_SIZE] = {(uint8_t)By0,(uint8_t)By1,(uint8_t)By2,(uint8_t)By3,(uint8_t)By4,(uint8_t)By5,(uint8_t)By6,(uint8_t)By7};
+
 	rdsSentStatus = read1Byte(STATUS_REG) & 8;
-	write1Byte(RDSD0_REG,By0);
-	write1Byte(RDSD1_REG,By1);
-	write1Byte(RDSD2_REG,By2);
-	write1Byte(RDSD3_REG,By3);
-	write1Byte(RDSD4_REG,By4);
-	write1Byte(RDSD5_REG,By5);
-	write1Byte(RDSD6_REG,By6);
-	write1Byte(RDSD7_REG,By7);
+	writeRDSGroup(grp);
+}
+
+/* Burst write one group to RDSD0..RDSD7 and toggle the RDS ready bit.
+	Caller must have updated rdsSentStatus. Costs two I2C transactions (was nine).
+*/
+void QN8027Radio::writeRDSGroup(const uint8_t *grp){
+	writeBytes(RDSD0_REG,grp,RDS_GROUP_SIZE);
 	if(rdsReady==4){
 		rdsReady = 0;
 	}else{
@@ -216,7 +311,7 @@ void QN8027Radio::sendRDS(char By0,char By1,char By2,char By3,char By4,char By5,
 Resets all registers(settings) to default.
 */
 void QN8027Radio::updateSYSTEM_REG(){
-	write1Byte(SYSTEM_REG,(radioStatus | monoAudio | muteAudio | rdsReady | freqH));
+	writeReg(SYSTEM_REG,(radioStatus | monoAudio | muteAudio | rdsReady | freqH));
 }
 
 void QN8027Radio::reset()
@@ -224,6 +319,8 @@ void QN8027Radio::reset()
 	write1Byte(SYSTEM_REG,0x80);
     delayMicroseconds(100);
 	write1Byte(SYSTEM_REG,0x00); // Mod by TEB, Jan-29-2022.
+	regValid = (1UL << SYSTEM_REG); // All other registers are back to chip defaults, shadow is stale.
+	regDirty = 0;
 }
 
 /* Recalibrates internal RF power amplifier for load antenna attached. this process is automatic and you just need to use this function only.*/
@@ -272,7 +369,7 @@ void QN8027Radio::Switch(uint8_t onOffCtrl)
 
 //---------------------------GPLT_REG----------------------------------------------------------
 void QN8027Radio::updateGPLT_REG(){
-	write1Byte(GPLT_REG,(preEmphTime | privateMode | PAAutoOffTime | TxPilotFreqDeviation));
+	writeReg(GPLT_REG,(preEmphTime | privateMode | PAAutoOffTime | TxPilotFreqDeviation));
 }
 // I really dont know why is this option there. it gave mono audio with narrow CarrierWave bandwidth in my tests.
 // you can provide ON or OFF in parameter to this function.
@@ -314,11 +411,19 @@ void QN8027Radio::setTxPilotFreqDeviation(uint8_t PGain){
 // Change the PI Code. Be sure to use a valid PI Code.
 // See https://picodes.nrscstandards.org/ and https://www.fmsystems-inc.com/rds-pi-code-formula-station-callsigns/
 void QN8027Radio::setPiCode(uint16_t piCodeVal){
+	if(piCode != piCodeVal){
+		psnCacheFlg = false;	// PI Code is part of every group, rebuild the group caches.
+		rtCacheFlg = false;
+	}
 	piCode = piCodeVal;
 }
 
 // Change the PTY Code. Be sure to use a valid PTY Code.
 void QN8027Radio::setPtyCode(uint8_t ptyCodeVal){
+	if(ptyCode != ptyCodeVal){
+		psnCacheFlg = false;	// PTY Code is part of every group, rebuild the group caches.
+		rtCacheFlg = false;
+	}
 	ptyCode = ptyCodeVal;
 }
 
@@ -339,7 +444,7 @@ void QN8027Radio::radioNoAudioAutoOFF(uint8_t onOffCtrl){
 
 //------------------------XTL_REG-------------------------------------------------------------
 void QN8027Radio::updateXTL_REG(){
-	write1Byte(XTL_REG,(clockSource | CrystalCurrentuA));
+	writeReg(XTL_REG,(clockSource | CrystalCurrentuA));
 }
 /*
 Type::meaning
@@ -367,7 +472,7 @@ void QN8027Radio::setCrystalCurrent(float percentOfMax){  //current between 0 to
 
 //-----------------------VGA_REG--------------------------------------------------------------
 void QN8027Radio::updateVGA_REG(){
-	write1Byte(VGA_REG,(crystalFreqMHz | TxInputBufferGain | TxDigitalGain | LRInputImpdKOhm));
+	writeReg(VGA_REG,(crystalFreqMHz | TxInputBufferGain | TxDigitalGain | LRInputImpdKOhm));
 }
 
 /*
@@ -442,7 +547,7 @@ default is 129 which means 74.82 KHz
 maximum bandwidth can be 148 KHz by setting Fdev value to 255
 */
 void QN8027Radio::setTxFreqDeviation(uint8_t Fdev){
-	write1Byte(FDEV_REG,Fdev);
+	writeReg(FDEV_REG,Fdev);
 }
 
 //---------------------------RDS_REG-------------------------------------------------------
@@ -453,7 +558,7 @@ void QN8027Radio::RDS(uint8_t onOffCtrl){
 	}else{
 		RDSEnable = 0;
 	}
-	write1Byte(RDS_REG,(RDSEnable | RDSFreqDeviationKHz));
+	writeReg(RDS_REG,(RDSEnable | RDSFreqDeviationKHz));
 }
 
 /* set bandwidth of RDS channel.
@@ -464,7 +569,7 @@ maximum bandwidth can be 44.45 KHz by setting RDSFreqDev value to 127
 */
 void QN8027Radio::setRDSFreqDeviation(uint8_t RDSFreqDev){
 	RDSFreqDeviationKHz = RDSFreqDev;
-	write1Byte(RDS_REG,(RDSEnable | RDSFreqDeviationKHz));
+	writeReg(RDS_REG,(RDSEnable | RDSFreqDeviationKHz));
 }
 
 //--------------------------PAC_REG---------------------------------------------------------
@@ -501,7 +606,7 @@ NOTE: Power will not be updated until RF carrier state is toggled Off-On (radioS
 void QN8027Radio::setTxPower(uint8_t setX)
 {
 	PAOutputPower = setX & 0x7F;  // Mod by TEB, Jan-31-2022.
-	write1Byte(PAC_REG,(AudioPeakClear | PAOutputPower));
+	writeReg(PAC_REG,(AudioPeakClear | PAOutputPower));
 }
 
 //----------------------STATUS_REG ----------------------------------------------------------
@@ -555,73 +660,316 @@ Sends Program Service Name (PSN = Station ID) such as "KZAP FM" to a RDS enabled
 PSN must be maximum 8 byte long String.
 PSN shorter than 8 bytes will contain a null termination. This tells the RDS Receiver when to end decoding.
 */
-void QN8027Radio::sendStationName(String SN){
+void QN8027Radio::sendStationName(const char *SN){
+	if(!psnCacheFlg || strncmp(SN, psnCacheStr, PSN_SIZE) != 0){
+		buildStationNameCache(SN);
+	}
+	for(uint8_t i=0;i<psnCacheCnt;i++){
+		queueRDS(psnCache[i]);
+	}
+}
+
+void QN8027Radio::sendStationName(const String &SN){
+	sendStationName(SN.c_str());
+}
+
+/*
+Load the PSN used by a group scheduler (see getPsnGroup()). Nothing is queued.
+Returns true if the PSN is different from the one already loaded.
+*/
+bool QN8027Radio::setStationName(const char *SN){
+	bool newFlg = !psnEnbFlg || strncmp(SN, psnCacheStr, PSN_SIZE) != 0;
+
+	if(newFlg || !psnCacheFlg){
+		buildStationNameCache(SN);
+	}
+	psnEnbFlg = true;
+	return newFlg;
+}
+
+bool QN8027Radio::setStationName(const String &SN){
+	return setStationName(SN.c_str());
+}
+
+/* Number of 0A groups in the loaded PSN. Zero if no PSN is loaded. */
+uint8_t QN8027Radio::getPsnGroupCnt(){
+	if(!psnEnbFlg){
+		return 0;
+	}
+	if(!psnCacheFlg){ // PI or PTY changed.
+		buildStationNameCache(psnCacheStr);
+	}
+	return psnCacheCnt;
+}
+
+const uint8_t *QN8027Radio::getPsnGroup(uint8_t index){
+	return psnCache[index % PSN_GROUP_CNT];
+}
+
+/*
+Encode the PSN into packed 0A groups. The cache is only rebuilt when the PSN, PI or PTY changes,
+so the once-per-second PSN refresh just replays it.
+*/
+void QN8027Radio::buildStationNameCache(const char *SN){
+    uint8_t str_len;
+    uint8_t rds_len;
+
     char char_array[PSN_SIZE+1];
-    int str_len;
-    int rds_len;
 
-    if(SN.length() > PSN_SIZE) {            // Prevent Buffer Overflow.
-        SN = SN.substring(0, PSN_SIZE);
-    }
+    memset(char_array,char(NULL),sizeof(char_array)); // Clear PSN Buffer (fill with nulls). Mod By TEB, Feb-03-2022.
+    strncpy(char_array, SN, PSN_SIZE);                 // Prevent Buffer Overflow. SN may point to psnCacheStr.
+    memcpy(psnCacheStr, char_array, sizeof(psnCacheStr));
 
-	str_len = SN.length() + 1;
+	str_len = strlen(psnCacheStr) + 1;
 	rds_len = str_len + (str_len%2);    // Make it a multiple of 2.
 
-    memset(char_array,char(NULL),PSN_SIZE); // Clear PSN Buffer (fill with nulls). Mod By TEB, Feb-03-2022.
-	SN.toCharArray(char_array, str_len);
+    uint8_t ptyHi = (ptyCode & 0x18) >> 3; //top 2 bits of PTY are in bottom 2 bits of byte 3, Mod By dkulp, Jun-13-2022
+    uint8_t ptyLo = (ptyCode << 5) & 0xE0; //bottom 3 bits of PTY are in top 3 bits of byte 4, Mod By dkulp, Jun-13-2022
 
+	psnCacheCnt = 0;
 	for(int i=0;i<rds_len;i+=2){
         if(i>=PSN_SIZE) break; // Prevent RDS buffer overflow. Mod By TEB, Jan-31-2022.
-        uint8_t ptyHi = (ptyCode & 0x18) >> 3; //top 2 bits of PTY are in bottom 2 bits of byte 3, Mod By dkulp, Jun-13-2022
-        uint8_t ptyLo = (ptyCode << 5) & 0xE0; //bottom 3 bits of PTY are in top 3 bits of byte 4, Mod By dkulp, Jun-13-2022
-		sendRDS(highByte(piCode),lowByte(piCode),ptyHi, ptyLo | (0x08+(i/2)),0xE0,0xCD,char_array[i],char_array[i+1]);
-		waitForRDSSend();
+		uint8_t *grp = psnCache[psnCacheCnt++];
+		grp[0] = highByte(piCode);
+		grp[1] = lowByte(piCode);
+		grp[2] = ptyHi;
+		grp[3] = ptyLo | (0x08+(i/2));
+		grp[4] = 0xE0;
+		grp[5] = 0xCD;
+		grp[6] = psnCacheStr[i];
+		grp[7] = psnCacheStr[i+1];
 	}
+	psnCacheFlg = true;
 }
 
 /*
-waits for previous Group send. when previous group will finish sending, this function will return.
-Typical Group send time is ~70mS. Equivalent bit rate is ~475 baud.
+RDS Group FIFO. Groups are queued here and sent one at a time by serviceRDS().
+Typical Group send time is ~88mS (104 bits at 1187.5 bps).
+A full FIFO discards the new group and bumps rdsDropCnt. Returns false if the group was dropped.
 */
-const uint8_t RDS_SEND_DELAY = 5;
-void QN8027Radio::waitForRDSSend(){
-    uint8_t status = rdsSentStatus;
-    uint8_t timeout = 0;
-    do{
-        status = read1Byte(STATUS_REG);
-        status = status & 8;
-        if(timeout++ > (100/RDS_SEND_DELAY)) {  // Allow up to 100mS RDS Send time. Mod by TEB, Dec-27-2021
-            Log.errorln("-> Abort: waitForRDSSend() function time-out!");
-            break;
-        }
-        delay(RDS_SEND_DELAY); //This wait time allows the RDS buffer contents to be sent.
-    }while(status==rdsSentStatus); // Wait for rdsSentStatus to toggle.
-    rdsSentStatus = status;
+const uint8_t RDS_SEND_DELAY = 5;       // STATUS_REG poll interval, in mS.
+const uint8_t RDS_SEND_TIMEOUT = 100;   // Allow up to 100mS RDS Send time. Mod by TEB, Dec-27-2021
+bool QN8027Radio::queueRDS(char By0,char By1,char By2,char By3,char By4,char By5,char By6,char By7){
+	if(rdsFifoCnt >= RDS_FIFO_SIZE){
+		rdsDropCnt++;
+		return false;
+	}
+	uint8_t *grp = rdsFifo[rdsFifoHead];
+	grp[0] = By0; grp[1] = By1; grp[2] = By2; grp[3] = By3;
+	grp[4] = By4; grp[5] = By5; grp[6] = By6; grp[7] = By7;
+	rdsFifoHead = (rdsFifoHead + 1) % RDS_FIFO_SIZE;
+	rdsFifoCnt++;
+	return true;
+}
+
+bool QN8027Radio::queueRDS(const uint8_t *grp){
+	return queueRDS(grp[0],grp[1],grp[2],grp[3],grp[4],grp[5],grp[6],grp[7]);
 }
+
+/*
+Non-blocking RDS pump, call it from the main loop.
+A new group is written to RDSD0..7 only after STATUS_REG's RDS sent bit has toggled (previous group is on-air),
+so callers never wait for the 57KHz sub-carrier.
+*/
+void QN8027Radio::serviceRDS(){
+	unsigned long currentMillis = millis();
+
+	if(currentMillis - rdsPollMillis < RDS_SEND_DELAY){
+		return;
+	}
+	rdsPollMillis = currentMillis;
+
+	if(!rdsBusyFlg && rdsFifoCnt == 0){
+		return;
+	}
+
+	uint8_t status = read1Byte(STATUS_REG) & 8; // One STATUS_REG read serves both the toggle test and the next group.
+	if(rdsBusyFlg){
+		if(status == rdsSentStatus){ // Previous group has not been sent yet.
+			if(currentMillis - rdsSendMillis < RDS_SEND_TIMEOUT){
+				return;
+			}
+			Log.errorln("-> Abort: serviceRDS() RDS Group send time-out!");
+		}
+		else{
+			rdsAckCnt = rdsSentCnt; // Toggled, the last group written is on-air.
+		}
+		rdsBusyFlg = false;
+	}
+	rdsSentStatus = status;
+
+	if(rdsFifoCnt == 0){
+		return;
+	}
+
+	writeRDSGroup(rdsFifo[rdsFifoTail]);
+	rdsSentCnt++;
+	rdsFifoTail = (rdsFifoTail + 1) % RDS_FIFO_SIZE;
+	rdsFifoCnt--;
+	rdsBusyFlg = true;
+	rdsSendMillis = currentMillis;
+}
+
+/* Discard all queued RDS groups. Used when a new message must replace the old one immediately. */
+void QN8027Radio::clearRDSQueue(){
+	rdsFifoHead = 0;
+	rdsFifoTail = 0;
+	rdsFifoCnt = 0;
+}
+
+uint8_t QN8027Radio::getRDSQueueCnt(){
+	return rdsFifoCnt;
+}
+
 /*Sends Song Artist Album Name. RT must be maximum 64 Byte long*/
 //RadioText shorter than 64 bytes will contain a null termination. This tells the RDS Receiver when to end decoding.
-/* Execution time is about 1.2mS */
-void QN8027Radio::sendRadioText(String RT){
-	char char_array[RADIOTEXT_SIZE+1];
-    int rds_len;
-    int str_len;
-
-    if(RT.length() > RADIOTEXT_SIZE) {            // Prevent Buffer Overflow.
-         RT = RT.substring(0, RADIOTEXT_SIZE);
-    }
+/* Groups are queued, serviceRDS() sends them. */
+void QN8027Radio::sendRadioText(const char *RT){
+	if(!rtCacheFlg || strncmp(RT, rtCacheStr, RADIOTEXT_SIZE) != 0){
+		buildRadioTextCache(RT);
+	}
+	for(uint8_t i=0;i<rtCacheCnt;i++){
+		queueRDS(rtCache[i]);
+	}
+}
+
+void QN8027Radio::sendRadioText(const String &RT){
+	sendRadioText(RT.c_str());
+}
+
+/*
+Load the RadioText used by a group scheduler (see getRtGroup()). Nothing is queued.
+Returns true if the RadioText is different from the one already loaded.
+*/
+bool QN8027Radio::setRadioText(const char *RT){
+	bool newFlg = !rtEnbFlg || strncmp(RT, rtCacheStr, RADIOTEXT_SIZE) != 0;
+
+	if(newFlg || !rtCacheFlg){
+		buildRadioTextCache(RT);
+	}
+	rtEnbFlg = true;
+	return newFlg;
+}
+
+bool QN8027Radio::setRadioText(const String &RT){
+	return setRadioText(RT.c_str());
+}
 
-	str_len = RT.length() + 1;
+/* Number of 2A groups in the loaded RadioText. Zero if no RadioText is loaded. */
+uint8_t QN8027Radio::getRtGroupCnt(){
+	if(!rtEnbFlg){
+		return 0;
+	}
+	if(!rtCacheFlg){ // PI or PTY changed.
+		buildRadioTextCache(rtCacheStr);
+	}
+	return rtCacheCnt;
+}
+
+const uint8_t *QN8027Radio::getRtGroup(uint8_t index){
+	return rtCache[index % RT_GROUP_CNT];
+}
+
+/*
+Next 2A group for a group scheduler. Call getRtGroupCnt() first, it must be non-zero.
+Segments changed by the last setRadioText() are sent first. The remaining segments follow in cyclic
+order, and segments already sent in the current cycle are skipped. A text change restarts the cycle.
+*/
+const uint8_t *QN8027Radio::getNextRtGroup(){
+	uint16_t allMask = (uint16_t)((1UL << rtCacheCnt) - 1);
+	uint16_t pendMask;
+	uint8_t seg;
+
+	if((rtSentMask & allMask) == allMask){ // Every segment is on-air, start a new cycle.
+		rtSentMask = 0;
+	}
+
+	pendMask = rtChgMask & ~rtSentMask & allMask;
+	if(pendMask){
+		for(seg=0; !(pendMask & (1U << seg)); seg++);
+	}
+	else{
+		seg = rtSegPos % rtCacheCnt;
+		while(rtSentMask & (1U << seg)){
+			seg = (seg + 1) % rtCacheCnt;
+		}
+		rtSegPos = (seg + 1) % rtCacheCnt;
+	}
+
+	rtSentMask |= (1U << seg);
+	rtChgMask &= ~(1U << seg);
+	return rtCache[seg];
+}
+
+/* true if every RadioText segment has been picked by getNextRtGroup() in the current cycle. */
+bool QN8027Radio::isRtCycleDone(){
+	uint16_t allMask = (uint16_t)((1UL << rtCacheCnt) - 1);
+
+	return rtEnbFlg && rtCacheCnt && (rtSentMask & allMask) == allMask;
+}
+
+/* Forget which RadioText segments were sent. Use it when receivers may have lost the RadioText (e.g. carrier was off). */
+void QN8027Radio::restartRtCycle(){
+	rtChgMask = 0;
+	rtSentMask = 0;
+	rtSegPos = 0;
+}
+
+/* Unload the PSN and RadioText. A group scheduler will have nothing to send. */
+void QN8027Radio::clearRDSProgram(){
+	psnEnbFlg = false;
+	rtEnbFlg = false;
+	restartRtCycle();
+}
+
+/*
+Encode the RadioText into packed 2A groups. Rebuilt only when the RadioText, PI or PTY changes.
+Segments whose text differs from the previous RadioText are flagged in rtChgMask, and any text change toggles the A/B flag
+and starts a new cycle. A rebuild with the same text keeps the A/B flag and the current cycle.
+*/
+void QN8027Radio::buildRadioTextCache(const char *RT){
+    uint8_t rds_len;
+    uint8_t str_len;
+    uint8_t oldCnt = rtCacheCnt;
+    uint16_t chgMask = 0;
+
+    char char_array[RADIOTEXT_SIZE+1];
+
+    memset(char_array, char(NULL), sizeof(char_array)); // Clear RadioText Buffer (fill with nulls). Mod By TEB, Feb-03-2022.
+    strncpy(char_array, RT, RADIOTEXT_SIZE);            // Copy RadioText to Buffer, prevent Buffer Overflow. RT may point to rtCacheStr.
+
+	str_len = strlen(char_array) + 1;
 	rds_len = str_len + (str_len%4);             // Make it a multiple of 4.
-    memset(char_array, char(NULL), RADIOTEXT_SIZE); // Clear RadioText Buffer (fill with nulls). Mod By TEB, Feb-03-2022.
-	RT.toCharArray(char_array, str_len);            // Copy RadioText to Buffer.
 
+	for(uint8_t seg=0; seg*4 < rds_len && seg < RT_GROUP_CNT; seg++){
+		if(seg >= oldCnt || memcmp(&rtCacheStr[seg*4], &char_array[seg*4], 4) != 0){
+			chgMask |= (1U << seg);
+		}
+	}
+	if(chgMask){
+		rtAbFlg = !rtAbFlg;                      // New text, receivers clear their RadioText display.
+		rtChgMask = chgMask;                     // Changed segments go first ...
+		rtSentMask = 0;                          // ... then all the others, the receivers have none of them now.
+	}                                            // Same text (PI/PTY refresh): A/B kept, segments sent this cycle are skipped.
+    memcpy(rtCacheStr, char_array, sizeof(rtCacheStr));
+
+    uint8_t ptyHi = (ptyCode & 0x18) >> 3; //top 2 bits of PTY are in bottom 2 bits of byte 3, Mod By dkulp, Jun-13-2022
+    uint8_t ptyLo = (ptyCode << 5) & 0xE0; //bottom 3 bits of PTY are in top 3 bits of byte 4, Mod By dkulp, Jun-13-2022
+
+	rtCacheCnt = 0;
 	for (int i=0;i<rds_len;i+=4){
         if (i >= RADIOTEXT_SIZE) break; // Prevent RDS buffer overflow. Mod By TEB, Jan-31-2022.
-        uint8_t ptyHi = (ptyCode & 0x18) >> 3; //top 2 bits of PTY are in bottom 2 bits of byte 3, Mod By dkulp, Jun-13-2022
-        uint8_t ptyLo = (ptyCode << 5) & 0xE0; //bottom 3 bits of PTY are in top 3 bits of byte 4, Mod By dkulp, Jun-13-2022
-		sendRDS(highByte(piCode),lowByte(piCode),0x20 | ptyHi,ptyLo | (i/4),char_array[i],char_array[i+1],char_array[i+2],char_array[i+3]);
-		waitForRDSSend();
+		uint8_t *grp = rtCache[rtCacheCnt++];
+		grp[0] = highByte(piCode);
+		grp[1] = lowByte(piCode);
+		grp[2] = 0x20 | ptyHi;
+		grp[3] = ptyLo | (rtAbFlg ? 0x10 : 0x00) | (i/4);
+		grp[4] = rtCacheStr[i];
+		grp[5] = rtCacheStr[i+1];
+		grp[6] = rtCacheStr[i+2];
+		grp[7] = rtCacheStr[i+3];
 	}
+	rtCacheFlg = true;
 }
 
 
@@ -17,6 +17,10 @@ Edits by TEB (thomastech) and dkulp, Jun-13-2022
 
 #define         RADIOTEXT_SIZE        64
 #define         PSN_SIZE              8
+#define         RDS_GROUP_SIZE        8     // RDSD0..RDSD7, one RDS Group.
+#define         PSN_GROUP_CNT         (PSN_SIZE/2)          // 0A Groups needed for a full PSN.
+#define         RT_GROUP_CNT          (RADIOTEXT_SIZE/4)    // 2A Groups needed for a full RadioText.
+#define         RDS_FIFO_SIZE         32    // RDS Group FIFO depth. Holds a full PSN + RadioText (4+16 groups) with room to spare.
 
 //QN8027 Register
 #define     	SYSTEM_REG            0x00
@@ -40,6 +44,9 @@ Edits by TEB (thomastech) and dkulp, Jun-13-2022
 #define     	RDS_REG               0x12
 #define     	ANT_REG               0x1E
 
+#define     	REG_SHADOW_SIZE       0x20  // Registers 0x00-0x1F are mirrored in regShadow[].
+#define     	REG_VOLATILE_MASK     ((1UL << STATUS_REG) | (1UL << ANT_REG)) // Always read these from the chip.
+
 
 //indicate self definition
 #define 		ON				  	  0x01
@@ -61,6 +68,43 @@ private:
   uint8_t _address = QN8027_I2C_ADDR; // TEB, MAR-07-2022
   uint8_t freqH = 0x00;               // TEB, MAR-07-2022
 
+  // RDS Group FIFO. Groups are queued by sendStationName()/sendRadioText() and drained by serviceRDS().
+  uint8_t rdsFifo[RDS_FIFO_SIZE][RDS_GROUP_SIZE];
+  uint8_t rdsFifoHead = 0;            // Next free slot.
+  uint8_t rdsFifoTail = 0;            // Next group to send.
+  uint8_t rdsFifoCnt = 0;             // Number of queued groups.
+  bool rdsBusyFlg = false;            // true = Group written, waiting for rdsSentStatus toggle.
+  unsigned long rdsSendMillis = 0;    // Time of last group write.
+  unsigned long rdsPollMillis = 0;    // Time of last STATUS_REG poll.
+
+  // Pre-encoded RDS Group caches. Rebuilt only when PSN, RadioText, PI or PTY changes.
+  uint8_t psnCache[PSN_GROUP_CNT][RDS_GROUP_SIZE];      // 0A Groups.
+  uint8_t psnCacheCnt = 0;
+  char psnCacheStr[PSN_SIZE+1];
+  bool psnCacheFlg = false;                             // true = psnCache is valid.
+  uint8_t rtCache[RT_GROUP_CNT][RDS_GROUP_SIZE];        // 2A Groups.
+  uint8_t rtCacheCnt = 0;
+  char rtCacheStr[RADIOTEXT_SIZE+1];
+  bool rtCacheFlg = false;                              // true = rtCache is valid.
+  bool psnEnbFlg = false;                               // true = PSN loaded by setStationName().
+  bool rtEnbFlg = false;                                // true = RadioText loaded by setRadioText().
+
+  // RadioText segment tracking, used by getNextRtGroup(). Bit N refers to 2A segment N.
+  bool rtAbFlg = false;                                 // Text A/B flag, toggled when the RadioText content changes.
+  uint16_t rtChgMask = 0;                               // Segments changed and not yet sent.
+  uint16_t rtSentMask = 0;                              // Segments sent in the current RadioText cycle.
+  uint8_t rtSegPos = 0;                                 // Next segment in cyclic order.
+
+  // Register shadow. Bit N of regValid/regDirty refers to register N.
+  uint8_t regShadow[REG_SHADOW_SIZE];
+  uint32_t regValid = 0;              // Shadow holds the value last written to the chip.
+  uint32_t regDirty = 0;              // Shadow has a new value that flush() must write.
+  bool regDeferFlg = false;           // true = writeReg() only updates the shadow (see beginUpdate()).
+
+  void writeRDSGroup(const uint8_t *grp);
+  void buildStationNameCache(const char *SN);
+  void buildRadioTextCache(const char *RT);
+
 public:
   //SYSTEM
   uint8_t radioStatus = 32;			//32==ON, 0==OFF
@@ -98,11 +142,20 @@ public:
   uint8_t PAOutputPower = 75;		//PowerAmp Output = 0.62*N + 71 dBu ; N={20 to 75}
 
   uint8_t rdsSentStatus = 0;		//Toggle between 8 and 0 when RDS is sent successfully.
+  uint16_t rdsDropCnt = 0;			//Number of RDS Groups discarded because the FIFO was full.
+  uint32_t rdsSentCnt = 0;			//Number of RDS Groups written to the chip.
+  uint32_t rdsAckCnt = 0;			//rdsSentCnt of the last RDS Group the chip reported as sent.
+  uint32_t i2cTxnCnt = 0;			//Number of I2C register transactions issued (diagnostic).
 
 
   QN8027Radio();
   QN8027Radio(int address);
   void write1Byte(uint8_t regAddr,uint8_t comData);
+  void writeBytes(uint8_t regAddr,const uint8_t *comData,uint8_t len);
+  void writeReg(uint8_t regAddr,uint8_t comData);
+  uint8_t readReg(uint8_t regAddr);
+  void beginUpdate();
+  uint8_t flush();
 
   void setFrequency(float frequency);
   void reset();
@@ -113,9 +166,27 @@ public:
   void setPreEmphTime50(uint8_t onOffCtrl);
   void Switch(uint8_t onOffCtrl); //radioPower
   void sendRDS(char By0,char By1,char By2,char By3,char By4,char By5,char By6,char By7);
-  void sendStationName(String SN);
-  void sendRadioText(String RT);
-  void waitForRDSSend();
+  void sendStationName(const char *SN);
+  void sendStationName(const String &SN);
+  void sendRadioText(const char *RT);
+  void sendRadioText(const String &RT);
+  bool setStationName(const char *SN);
+  bool setStationName(const String &SN);
+  bool setRadioText(const char *RT);
+  bool setRadioText(const String &RT);
+  void clearRDSProgram();
+  uint8_t getPsnGroupCnt();
+  const uint8_t *getPsnGroup(uint8_t index);
+  uint8_t getRtGroupCnt();
+  const uint8_t *getRtGroup(uint8_t index);
+  const uint8_t *getNextRtGroup();
+  bool isRtCycleDone();
+  void restartRtCycle();
+  bool queueRDS(char By0,char By1,char By2,char By3,char By4,char By5,char By6,char By7);
+  bool queueRDS(const uint8_t *grp);
+  void serviceRDS();
+  void clearRDSQueue();
+  uint8_t getRDSQueueCnt();
 
   float getFrequency();
   uint8_t read1Byte(uint8_t regAddr);
@@ -225,6 +225,7 @@ bool saveConfiguration(uint8_t saveMode, const char *fileName)
     doc["CTRL_LOCAL_FLAG"]  = ctrlLocalFlg;
     doc["CTRL_MQTT_FLAG"]   = ctrlMqttFlg;
     doc["CTRL_HTTP_FLAG"]   = ctrlHttpFlg;
+    doc["CTRL_UDP_FLAG"]    = ctrlUdpFlg;
     //doc["CTRL_SERIAL_FLAG"] = ctrlSerialFlg;
     doc["CTRL_SERIAL_STR"]  = ctrlSerialStr;
 
@@ -512,6 +513,10 @@ bool restoreConfiguration(uint8_t restoreMode, const char *fileName)
         ctrlHttpFlg = doc["CTRL_HTTP_FLAG"];
     }
 
+    if (doc.containsKey("CTRL_UDP_FLAG")) {
+        ctrlUdpFlg = doc["CTRL_UDP_FLAG"];
+    }
+
 //    if (doc.containsKey("CTRL_SERIAL_FLAG")) {
 //        ctrlSerialFlg = doc["CTRL_SERIAL_FLAG"];
 //    }
@@ -304,6 +304,17 @@ void controllerCallback(Control *sender, int type)
         tempStr  = "HTTP Controller Set to: ";
         tempStr += ctrlHttpFlg ? "On" : "Off";
     }
+    else if (sender->id == ctrlUdpID) {
+        if (type == S_ACTIVE) {
+            ctrlUdpFlg = true;
+        }
+        else if (type == S_INACTIVE) {
+            ctrlUdpFlg = false;
+        }
+        displaySaveWarning();
+        tempStr  = "UDP Controller Set to: ";
+        tempStr += ctrlUdpFlg ? "On" : "Off";
+    }
 
     // ------------- START OF OPTIONAL MQTT CONTROLLER ------------------------
     #ifdef MQTT_ENB
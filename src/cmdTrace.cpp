@@ -0,0 +1,169 @@
+/*
+   File: cmdTrace.cpp
+   Project: PixelRadio, an RBDS/RDS FM Transmitter (QN8027 Digital FM IC)
+   Version: 1.1.2
+   Creation: Oct-18-2022
+   Revised:  Oct-18-2022
+   Revision History: See PixelRadio.cpp
+   Project Leader: T. Black (thomastech)
+   Contributors: thomastech
+
+   (c) copyright T. Black 2021-2022, Licensed under GNU GPL 3.0 and later, under this
+   license absolutely no warranty is given.
+   This Code was formatted with the uncrustify extension.
+
+   Note 1: Command Latency Traces. Each controller command is time stamped as it moves from the
+           controller to the air: Received, Dispatched (handler runs), Won RDS arbitration (on-air),
+           first RadioText group written to the QN8027, and last RadioText group acknowledged by the
+           QN8027 (STATUS_REG toggle), which is when the whole RadioText has been sent once.
+           Commands that do not change the RDS only have the first two stamps.
+   Note 2: The last CMD_TRACE_CNT traces are kept. Use "info=latency" on any controller to see the
+           percentiles of each step.
+   Note 3: The traces are only used while radioLock() is held (dispatchCommand() and the RDS Task).
+ */
+
+// *********************************************************************************************
+
+#include <Arduino.h>
+#include "PixelRadio.h"
+
+// *********************************************************************************************
+
+typedef struct {
+    uint32_t id;                        // Trace ID, zero if unused.
+    uint8_t  controller;
+    uint8_t  stampMask;                 // Stamps that are set (bit = CMD_TRACE_RX, etc).
+    uint32_t stamps[CMD_TRACE_STAGES];  // micros() time stamps.
+} cmdTrace_t;
+
+// Trace Spans reported by cmdTraceReply(), from one stamp to another.
+typedef struct {
+    const char *nameStr;
+    uint8_t     fromStage;
+    uint8_t     toStage;
+} traceSpan_t;
+
+static const traceSpan_t traceSpans[] = {
+    { "dispatch",   CMD_TRACE_RX,       CMD_TRACE_DISPATCH },
+    { "onAir",      CMD_TRACE_DISPATCH, CMD_TRACE_WIN      },
+    { "firstGroup", CMD_TRACE_WIN,      CMD_TRACE_FIRST    },
+    { "lastAck",    CMD_TRACE_FIRST,    CMD_TRACE_LAST     },
+    { "total",      CMD_TRACE_RX,       CMD_TRACE_LAST     },
+};
+
+static cmdTrace_t cmdTraces[CMD_TRACE_CNT];
+static uint32_t   nextTraceId = 1;
+static uint32_t   curTraceId  = 0; // Trace of the command being dispatched, zero if none.
+
+// *********************************************************************************************
+// findCmdTrace(): Return the trace with the ID, NULL if it has been overwritten.
+static cmdTrace_t *findCmdTrace(uint32_t id)
+{
+    cmdTrace_t *trace = &cmdTraces[id % CMD_TRACE_CNT];
+
+    return ((id != 0) && (trace->id == id)) ? trace : NULL;
+}
+
+// *********************************************************************************************
+// getTraceSpans(): Collect the span times (in uS) of the traces that have both stamps, sorted.
+// Returns the number of spans.
+static uint8_t getTraceSpans(const traceSpan_t *span, uint32_t *spans)
+{
+    uint8_t  cnt  = 0;
+    uint8_t  mask = (1 << span->fromStage) | (1 << span->toStage);
+    uint32_t value;
+
+    for (uint8_t i = 0; i < CMD_TRACE_CNT; i++) {
+        if ((cmdTraces[i].id == 0) || ((cmdTraces[i].stampMask & mask) != mask)) {
+            continue;
+        }
+        value = cmdTraces[i].stamps[span->toStage] - cmdTraces[i].stamps[span->fromStage];
+
+        uint8_t j = cnt++; // Insertion sort, the ring is small.
+
+        for (; j > 0 && spans[j - 1] > value; j--) {
+            spans[j] = spans[j - 1];
+        }
+        spans[j] = value;
+    }
+    return cnt;
+}
+
+// *********************************************************************************************
+// cmdTraceReply(): JSON reply with the trace count and the 50th and 95th percentile of each trace
+// span, in mS. Fits in CMD_REPLY_MAX_SZ.
+void cmdTraceReply(char *replyBuff, const char *nameStr)
+{
+    char    *buffPtr = replyBuff;
+    uint8_t  cnt;
+    uint8_t  traceCnt = 0;
+    uint32_t spans[CMD_TRACE_CNT];
+
+    for (uint8_t i = 0; i < CMD_TRACE_CNT; i++) {
+        traceCnt += cmdTraces[i].id ? 1 : 0;
+    }
+    buffPtr += sprintf(buffPtr, "{\"%s\": \"ok\", \"traces\": %u", nameStr, traceCnt);
+
+    for (uint8_t i = 0; i < sizeof(traceSpans) / sizeof(traceSpans[0]); i++) {
+        cnt = getTraceSpans(&traceSpans[i], spans);
+
+        if (cnt == 0) {
+            buffPtr += sprintf(buffPtr, ", \"%s\": []", traceSpans[i].nameStr);
+        }
+        else {
+            buffPtr += sprintf(buffPtr, ", \"%s\": [%1.1f, %1.1f]", traceSpans[i].nameStr,
+                               spans[(cnt - 1) * 50 / 100] / 1000.0f, spans[(cnt - 1) * 95 / 100] / 1000.0f);
+        }
+    }
+    sprintf(buffPtr, "}");
+}
+
+// *********************************************************************************************
+// endCmdTrace(): The dispatched command is done, RDS jobs posted from now on are not traced.
+void endCmdTrace(void)
+{
+    curTraceId = 0;
+}
+
+// *********************************************************************************************
+// getCmdTraceId(): Return the trace ID of the command being dispatched, zero if none. Saved in its
+// RDS job so the RDS Task can add the on-air stamps.
+uint32_t getCmdTraceId(void)
+{
+    return curTraceId;
+}
+
+// *********************************************************************************************
+// stampCmdTrace(): Time stamp a trace stage (CMD_TRACE_WIN, etc). Only the first stamp of a stage
+// is kept. Ignored if the trace has been overwritten.
+void stampCmdTrace(uint32_t id, uint8_t stage)
+{
+    cmdTrace_t *trace = findCmdTrace(id);
+
+    if ((trace != NULL) && !(trace->stampMask & (1 << stage))) {
+        trace->stamps[stage] = micros();
+        trace->stampMask    |= (1 << stage);
+    }
+}
+
+// *********************************************************************************************
+// startCmdTrace(): Start the trace of a command that is being dispatched. rxMicros is the time the
+// controller received the command. The oldest trace is overwritten.
+void startCmdTrace(uint8_t controller, uint32_t rxMicros)
+{
+    cmdTrace_t *trace = &cmdTraces[nextTraceId % CMD_TRACE_CNT];
+
+    trace->id                          = nextTraceId;
+    trace->controller                  = controller;
+    trace->stamps[CMD_TRACE_RX]        = rxMicros;
+    trace->stamps[CMD_TRACE_DISPATCH]  = micros();
+    trace->stampMask                   = (1 << CMD_TRACE_RX) | (1 << CMD_TRACE_DISPATCH);
+    curTraceId                         = nextTraceId;
+
+    if (++nextTraceId == 0) {
+        nextTraceId = 1; // Zero means no trace.
+    }
+}
+
+// *********************************************************************************************
+// EOF
@@ -17,6 +17,7 @@
  */
 
 // *************************************************************************************************************************
+#include <ArduinoJson.h>
 #include <ArduinoLog.h>
 #include "config.h"
 #include "PixelRadio.h"
@@ -29,9 +30,37 @@
 // Radio
 extern QN8027Radio radio;
 
+// Batch Command
+typedef struct {
+    char        nameStr[CMD_BATCH_NAME_SZ];      // Command keyword as sent, may be truncated.
+    const char *resultStr;                       // "ok", "fail", "invalid", "unknown", or "skipped".
+} batchResult_t;
+
+static const uint16_t BATCH_JSON_SZ = JSON_OBJECT_SIZE(CMD_BATCH_FIELD_MAX) + CMD_BATCH_MAX_SZ;
+
+static batchResult_t batchResults[CMD_BATCH_FIELD_MAX]; // Last batch's results, guarded by radioLock().
+static uint8_t batchResultCnt = 0;
+static bool    batchActiveFlg = false;                  // Batch is being applied, RDS restarts are deferred.
+static bool    batchRdsFlg    = false;                  // RDS restart requested during the batch.
+
+// *************************************************************************************************************************
+// restartRds(): Reload the Controller's RDS values. During a batch command the restart is deferred so the whole
+// batch causes one restart.
+static void restartRds(uint8_t controller)
+{
+    if (batchActiveFlg) {
+        batchRdsFlg = true;
+    }
+    else {
+        postRdsJob(controller, RDS_JOB_START);
+    }
+}
+
 // *************************************************************************************************************************
 // getControllerStatus(): Returns Hex formatted value that represents which controllers are enabled and which are
 // currently sending RadioText.
+//  Bit D9: UDP Controller is Enabled.
+//  Bit D8: UDP Controller is Sending RDS.
 //  Bit D7: Serial Controller is Enabled.
 //  Bit D6: MQTT Controller is Enabled.
 //  Bit D5: HTTP Controller is Enabled.
@@ -41,9 +70,17 @@ extern QN8027Radio radio;
 //  Bit D1: HTTP Controller is Sending RDS.
 //  Bit D0: Local Controller is Sending RDS.
 //
-uint8_t getControllerStatus(void)
+uint16_t getControllerStatus(void)
 {
-    uint8_t status = 0;
+    uint16_t status = 0;
+
+    if (ctrlUdpFlg) {
+        status = status | 0x200; // Set Bit D9.
+    }
+
+    if (activeTextUdpFlg) {
+        status = status | 0x100; // Set Bit D8.
+    }
 
     if (ctrlSerialFlg()) {
         status = status | 0x80; // Set Bit D7.
@@ -125,6 +162,116 @@ bool audioModeCmd(String payloadStr, uint8_t controller)
     return true;
 }
 
+// *************************************************************************************************************************
+// batchValue(): Return a batch field's value as a command argument. Numbers and booleans are accepted unquoted.
+static String batchValue(JsonVariantConst value)
+{
+    String valueStr;
+
+    if (value.is<const char *>()) {
+        valueStr = value.as<const char *>();
+    }
+    else {
+        serializeJson(value, valueStr);
+    }
+    return valueStr;
+}
+
+// *************************************************************************************************************************
+// batchCmd(): Apply a JSON object of commands, {"freq": "1011", "psn": "Pixel"}, as one transaction. Every field is
+// checked first; If any field is invalid then nothing is changed. The commands are applied under radioLock() (see
+// dispatchCommand()), so updateRadioSettings() writes the radio registers in one flush with at most one RF Carrier
+// toggle, and the RDS is restarted once. Per-field results are kept for batchReply(). On exit, return true if success.
+bool batchCmd(String payloadStr, uint8_t controller)
+{
+    bool    validFlg = true;
+    char    logBuff[100];
+    uint8_t i;
+    String  controllerStr;
+    const cmdEntry_t    *cmd;
+    DeserializationError error;
+    StaticJsonDocument<BATCH_JSON_SZ> doc;
+
+    batchResultCnt = 0;
+    controllerStr  = getControllerName(controller);
+
+    if (controllerStr.length() == 0) {
+        Log.errorln("-> batchCmd: Undefined Controller!");
+        return false;
+    }
+
+    payloadStr.trim();
+    error = deserializeJson(doc, payloadStr);
+
+    if (error || !doc.is<JsonObject>() || (doc.size() == 0) || (doc.size() > CMD_BATCH_FIELD_MAX)) {
+        sprintf(logBuff, "-> %s Controller: Invalid BATCH Payload (%s), Ignored.", controllerStr.c_str(), error ? error.c_str() : "Field Count");
+        Log.errorln(logBuff);
+        return false;
+    }
+
+    // Check every field before changing anything.
+    for (JsonPairConst field : doc.as<JsonObjectConst>()) {
+        batchResult_t *result = &batchResults[batchResultCnt++];
+
+        strncpy(result->nameStr, field.key().c_str(), CMD_BATCH_NAME_SZ - 1);
+        result->nameStr[CMD_BATCH_NAME_SZ - 1] = '\0';
+
+        for (char *namePtr = result->nameStr; *namePtr; namePtr++) {
+            if (!isalnum(*namePtr)) {
+                *namePtr = '_'; // Name is echoed in the JSON reply.
+            }
+        }
+
+        cmd = findCommand(field.key().c_str(), controller);
+
+        if ((cmd == NULL) || (cmd->checkFn == NULL)) {
+            result->resultStr = "unknown";
+            validFlg          = false;
+        }
+        else if (!cmd->checkFn(batchValue(field.value()))) {
+            result->resultStr = "invalid";
+            validFlg          = false;
+        }
+        else {
+            result->resultStr = "skipped";
+        }
+    }
+
+    if (!validFlg) {
+        sprintf(logBuff, "-> %s Controller: BATCH Has Invalid Fields, Nothing Changed.", controllerStr.c_str());
+        Log.errorln(logBuff);
+        return false;
+    }
+
+    // All fields are valid, apply them.
+    i              = 0;
+    batchActiveFlg = true;
+    batchRdsFlg    = false;
+
+    for (JsonPairConst field : doc.as<JsonObjectConst>()) {
+        cmd = findCommand(field.key().c_str(), controller);
+
+        if (cmd->handler(batchValue(field.value()), controller)) {
+            batchResults[i].resultStr = "ok";
+        }
+        else {
+            batchResults[i].resultStr = "fail";
+            validFlg                  = false;
+        }
+        i++;
+    }
+    batchActiveFlg = false;
+
+    if (batchRdsFlg) {
+        postRdsJob(controller, RDS_JOB_START); // One RDS restart for the whole batch.
+    }
+
+    sprintf(logBuff, "-> %s Controller: BATCH of %u Commands Applied.", controllerStr.c_str(), batchResultCnt);
+    Log.verboseln(logBuff);
+
+    return validFlg;
+}
+
 // *************************************************************************************************************************
 bool frequencyCmd(String payloadStr, uint8_t controller)
 {
@@ -181,6 +328,9 @@ String getControllerName(uint8_t controller)
     else if (controller == LOCAL_CNTRL) {
         controllerStr = "Local";
     }
+    else if (controller == UDP_CNTRL) {
+        controllerStr = "UDP";
+    }
     else {
         controllerStr = ""; // Return empty String if invalid controller type.
     }
@@ -323,7 +473,7 @@ bool gpioCmd(String payloadStr, uint8_t controller, uint8_t pin)
 bool infoCmd(String payloadStr, uint8_t controller)
 {
     char logBuff[100];
-    const  uint8_t maxSize = CMD_SYS_MAX_SZ;
+    const  uint8_t maxSize = CMD_INFO_MAX_SZ;
     String controllerStr;
 
     controllerStr = getControllerName(controller);
@@ -340,7 +490,7 @@ bool infoCmd(String payloadStr, uint8_t controller)
         payloadStr = payloadStr.substring(0, maxSize);
     }
 
-    if (payloadStr == CMD_SYS_CODE_STR) {
+    if ((payloadStr == CMD_SYS_CODE_STR) || (payloadStr == CMD_LATENCY_STR)) {
         sprintf(logBuff, "-> %s Controller: Info Command.", controllerStr.c_str());
         Log.verboseln(logBuff);
     }
@@ -474,16 +624,17 @@ bool piCodeCmd(String payloadStr, uint8_t controller)
         if (radio.getPiCode() != (uint16_t)(tempPiCode)) { // New PI Code.
             if (controller == SERIAL_CNTRL) {
                 rdsSerialPiCode = tempPiCode;
-                textSerialFlg   = true;                    // Reload Serial RDS values
             }
             else if (controller == MQTT_CNTRL) {
                 rdsMqttPiCode = tempPiCode;
-                textMqttFlg   = true; // Reload MQTT RDS values
             }
             else if (controller == HTTP_CNTRL) {
                 rdsHttpPiCode = tempPiCode;
-                textHttpFlg   = true; // Reload HTTP RDS values
             }
+            else if (controller == UDP_CNTRL) {
+                rdsUdpPiCode = tempPiCode;
+            }
+            restartRds(controller); // Reload Controller's RDS values.
 
             displaySaveWarning();
             sprintf(logBuff, "-> %s Controller: PI Code Set to 0x%04X.", controllerStr.c_str(), tempPiCode);
@@ -529,16 +680,17 @@ bool ptyCodeCmd(String payloadStr, uint8_t controller)
         if (radio.getPTYCode() != (uint8_t)(tempPtyCode)) { // New PTY Code.
             if (controller == SERIAL_CNTRL) {
                 rdsSerialPtyCode = (uint8_t)(tempPtyCode);
-                textSerialFlg    = true;                    // Reload Serial RDS values
             }
             else if (controller == MQTT_CNTRL) {
                 rdsMqttPtyCode = (uint8_t)(tempPtyCode);
-                textMqttFlg    = true; // Reload MQTT RDS values
             }
             else if (controller == HTTP_CNTRL) {
                 rdsHttpPtyCode = (uint8_t)(tempPtyCode);
-                textHttpFlg    = true; // Reload HTTP RDS values
             }
+            else if (controller == UDP_CNTRL) {
+                rdsUdpPtyCode = (uint8_t)(tempPtyCode);
+            }
+            restartRds(controller); // Reload Controller's RDS values.
 
             displaySaveWarning();
             sprintf(logBuff, "-> %s Controller: PTY Code Set to %d.", controllerStr.c_str(), tempPtyCode);
@@ -573,16 +725,17 @@ bool programServiceNameCmd(String payloadStr, uint8_t controller)
 
     if (controller == SERIAL_CNTRL) {
         rdsSerialPsnStr = payloadStr;
-        textSerialFlg   = true; // Reload Serial RDS values
     }
     else if (controller == MQTT_CNTRL) {
         rdsMqttPsnStr = payloadStr;
-        textMqttFlg   = true; // Reload MQTT RDS values
     }
     else if (controller == HTTP_CNTRL) {
         rdsHttpPsnStr = payloadStr;
-        textHttpFlg   = true; // Reload HTTP RDS values
     }
+    else if (controller == UDP_CNTRL) {
+        rdsUdpPsnStr = payloadStr;
+    }
+    restartRds(controller); // Reload Controller's RDS values.
 
     sprintf(logBuff, "-> %s Controller: RDS PSN Set to %s", controllerStr.c_str(), payloadStr.c_str());
     Log.verboseln(logBuff);
@@ -610,17 +763,18 @@ bool radioTextCmd(String payloadStr, uint8_t controller)
     }
 
     if (controller == SERIAL_CNTRL) {
-        textSerialFlg    = true; // Reload Serial RDS values
         rdsSerialTextStr = payloadStr;
     }
     else if (controller == MQTT_CNTRL) {
-        textMqttFlg    = true; // Reload MQTT RDS values
         rdsMqttTextStr = payloadStr;
     }
     else if (controller == HTTP_CNTRL) {
-        textHttpFlg    = true; // Reload HTTP RDS values
         rdsHttpTextStr = payloadStr;
     }
+    else if (controller == UDP_CNTRL) {
+        rdsUdpTextStr = payloadStr;
+    }
+    restartRds(controller); // Reload Controller's RDS values.
 
     sprintf(logBuff, "-> %s Controller: RadioText Changed to %s", controllerStr.c_str(), payloadStr.c_str());
     Log.verboseln(logBuff);
@@ -660,17 +814,18 @@ bool rdsTimePeriodCmd(String payloadStr, uint8_t controller)
     }
 
     if (controller == SERIAL_CNTRL) {
-        textSerialFlg    = true; // Restart Serial Controller's RDS.
         rdsSerialMsgTime = rtTime * 1000;
     }
     else if (controller == MQTT_CNTRL) {
-        textMqttFlg    = true; // Restart MQTT Controller's RDS.
         rdsMqttMsgTime = rtTime * 1000;
     }
     else if (controller == HTTP_CNTRL) {
-        textHttpFlg    = true; // Restart HTTP Controller's RDS.
         rdsHttpMsgTime = rtTime * 1000;
     }
+    else if (controller == UDP_CNTRL) {
+        rdsUdpMsgTime = rtTime * 1000;
+    }
+    restartRds(controller); // Restart Controller's RDS.
 
     if (capFlg) {
         sprintf(logBuff, "-> %s Controller: RDS Time Period Value out-of-range, set to %d secs.", controllerStr.c_str(), rtTime);
@@ -786,15 +941,7 @@ bool startCmd(String payloadStr, uint8_t controller)
         sprintf(logBuff, "-> %s Controller: Start RDS.", controllerStr.c_str());
         Log.verboseln(logBuff);
 
-        if (controller == SERIAL_CNTRL) {
-            textSerialFlg = true; // Restart Serial Controller's RadioText.
-        }
-        else if (controller == MQTT_CNTRL) {
-            textMqttFlg = true;   // Restart MQTT Controller's RadioText.
-        }
-        else if (controller == HTTP_CNTRL) {
-            textHttpFlg = true;   // Restart HTTP Controller's RadioText.
-        }
+        postRdsJob(controller, RDS_JOB_START); // Restart Controller's RadioText.
     }
     else {
         sprintf(logBuff, "-> %s Controller: Invalid START Payload (%s), Ignored.", controllerStr.c_str(), payloadStr.c_str());
@@ -829,15 +976,7 @@ bool stopCmd(String payloadStr, uint8_t controller)
         sprintf(logBuff, "-> %s Controller: Stop RDS.", controllerStr.c_str());
         Log.verboseln(logBuff);
 
-        if (controller == SERIAL_CNTRL) {
-            stopSerialFlg = true; // Restart Serial Controller's RadioText.
-        }
-        else if (controller == MQTT_CNTRL) {
-            stopMqttFlg = true;   // Restart MQTT Controller's RadioText.
-        }
-        else if (controller == HTTP_CNTRL) {
-            stopHttpFlg = true;   // Restart HTTP Controller's RadioText.
-        }
+        postRdsJob(controller, RDS_JOB_STOP); // Stop Controller's RadioText.
     }
     else {
         sprintf(logBuff, "-> %s Controller: Invalid STOP Payload (%s), Ignored.", controllerStr.c_str(), payloadStr.c_str());
@@ -847,5 +986,372 @@ bool stopCmd(String payloadStr, uint8_t controller)
     return true;
 }
 
+// *************************************************************************************************************************
+// COMMAND REGISTRY: One table of controller commands, shared by the Serial, MQTT, HTTP, and UDP controllers.
+// The table must be kept sorted by name (checked at compile time), lookup is a binary search.
+// To add a command, add its handler above and its entry to cmdTable[] below.
+
+// gpioXXCmd(): GPIO command handlers, one per GPIO pin.
+static bool gpio19Cmd(String payloadStr, uint8_t controller)
+{
+    return gpioCmd(payloadStr, controller, GPIO19_PIN);
+}
+
+static bool gpio23Cmd(String payloadStr, uint8_t controller)
+{
+    return gpioCmd(payloadStr, controller, GPIO23_PIN);
+}
+
+static bool gpio33Cmd(String payloadStr, uint8_t controller)
+{
+    return gpioCmd(payloadStr, controller, GPIO33_PIN);
+}
+
+// *************************************************************************************************************************
+// Argument checks for the batch command. Each one accepts exactly the arguments its command handler accepts, but has
+// no side effects.
+static bool audioModeCheck(String payloadStr)
+{
+    payloadStr.trim();
+    payloadStr.toLowerCase();
+    payloadStr = payloadStr.substring(0, CMD_AUD_MAX_SZ);
+
+    return (payloadStr == CMD_MODE_STER_STR) || (payloadStr == CMD_MODE_MONO_STR);
+}
+
+static bool frequencyCheck(String payloadStr)
+{
+    int16_t freq;
+
+    payloadStr.trim();
+    payloadStr = payloadStr.substring(0, CMD_FREQ_MAX_SZ);
+    freq       = payloadStr.toInt();
+
+    return strIsUint(payloadStr) && (freq >= FM_FREQ_MIN_X10) && (freq <= FM_FREQ_MAX_X10);
+}
+
+static bool muteCheck(String payloadStr)
+{
+    payloadStr.trim();
+    payloadStr.toLowerCase();
+    payloadStr = payloadStr.substring(0, CMD_MUTE_MAX_SZ);
+
+    return (payloadStr == CMD_MUTE_ON_STR) || (payloadStr == CMD_MUTE_OFF_STR);
+}
+
+static bool piCodeCheck(String payloadStr)
+{
+    uint32_t tempPiCode;
+
+    payloadStr.trim();
+    payloadStr = payloadStr.substring(0, CMD_PI_MAX_SZ);
+    tempPiCode = strtol(payloadStr.c_str(), NULL, HEX);
+
+    return (tempPiCode >= RDS_PI_CODE_MIN) && (tempPiCode <= RDS_PI_CODE_MAX);
+}
+
+static bool ptyCodeCheck(String payloadStr)
+{
+    int16_t tempPtyCode;
+
+    payloadStr.trim();
+    payloadStr  = payloadStr.substring(0, CMD_PTY_MAX_SZ);
+    tempPtyCode = payloadStr.toInt();
+
+    return strIsUint(payloadStr) && (tempPtyCode >= RDS_PTY_CODE_MIN) && (tempPtyCode <= RDS_PTY_CODE_MAX);
+}
+
+static bool rdsTimePeriodCheck(String payloadStr)
+{
+    payloadStr.trim();
+
+    return (payloadStr.length() <= CMD_TIME_MAX_SZ) && (strtol(payloadStr.c_str(), NULL, 10) > 0);
+}
+
+static bool rfCarrierCheck(String payloadStr)
+{
+    payloadStr.trim();
+    payloadStr.toLowerCase();
+    payloadStr = payloadStr.substring(0, CMD_RF_MAX_SZ);
+
+    return (payloadStr == CMD_RF_ON_STR) || (payloadStr == CMD_RF_OFF_STR);
+}
+
+static bool textCheck(String payloadStr)
+{
+    return true; // Any text is accepted, it is truncated by the handler.
+}
+
+// *************************************************************************************************************************
+// batchReply(): JSON reply formatter for the batch command, one result per field in the order received.
+static void batchReply(char *replyBuff, const cmdEntry_t *cmd, bool successFlg, const String& payloadStr)
+{
+    char *buffPtr = replyBuff;
+
+    buffPtr += sprintf(buffPtr, "{\"%s\": \"%s\", \"results\": [", cmd->nameStr, successFlg ? "ok" : "fail");
+
+    for (uint8_t i = 0; i < batchResultCnt; i++) {
+        buffPtr += sprintf(buffPtr, "%s{\"%s\": \"%s\"}", i ? ", " : "", batchResults[i].nameStr, batchResults[i].resultStr);
+    }
+    sprintf(buffPtr, "]}");
+}
+
+// *************************************************************************************************************************
+// gpioReply(): JSON reply formatter for the GPIO commands. A read command returns the pin state.
+static void gpioReply(char *replyBuff, const cmdEntry_t *cmd, bool successFlg, const String& payloadStr)
+{
+    if (!successFlg) {
+        sprintf(replyBuff, "{\"%s%d\": \"fail\"}", CMD_GPIO_STR, cmd->pin);
+    }
+    else if (payloadStr.equalsIgnoreCase(CMD_GPIO_READ_STR)) {
+        sprintf(replyBuff, "{\"%s%d\": \"%d\"}", CMD_GPIO_STR, cmd->pin, digitalRead(cmd->pin));
+    }
+    else {
+        sprintf(replyBuff, "{\"%s%d\": \"ok\"}", CMD_GPIO_STR, cmd->pin);
+    }
+}
+
+// *************************************************************************************************************************
+// infoReply(): JSON reply formatter for the info command. "info=latency" reports the command latency percentiles.
+static void infoReply(char *replyBuff, const cmdEntry_t *cmd, bool successFlg, const String& payloadStr)
+{
+    uint8_t  mqttQueueCnt;
+    uint32_t mqttDropCnt;
+    uint32_t mqttMergeCnt;
+    String   codeStr = payloadStr;
+
+    if (!successFlg) {
+        sprintf(replyBuff, "{\"%s\": \"fail\"}", cmd->nameStr);
+        return;
+    }
+    codeStr.trim();
+
+    if (codeStr.equalsIgnoreCase(CMD_LATENCY_STR)) {
+        cmdTraceReply(replyBuff, cmd->nameStr);
+        return;
+    }
+    mqttQueueCnt = getMqttPubStats(&mqttDropCnt, &mqttMergeCnt);
+    sprintf(replyBuff,
+            "{\"%s\": \"ok\", \"version\": \"%s\", \"hostName\": \"%s\", \"ip\": \"%s\", \"rssi\": %d, \"status\": \"0x%02X\", "
+            "\"drops\": %u, \"coalesced\": %u, \"mqttQueue\": %u, \"mqttDrops\": %u, \"mqttCoalesced\": %u}",
+            cmd->nameStr,
+            VERSION_STR,
+            staNameStr.c_str(),
+            WiFi.localIP().toString().c_str(),
+            WiFi.RSSI(),
+            getControllerStatus(),
+            getCmdDropCnt(NO_CNTRL),
+            getRdsCoalesceCnt(),
+            mqttQueueCnt,
+            mqttDropCnt,
+            mqttMergeCnt);
+}
+
+// *************************************************************************************************************************
+// resultReply(): JSON reply formatter for commands that only report ok/fail.
+static void resultReply(char *replyBuff, const cmdEntry_t *cmd, bool successFlg, const String& payloadStr)
+{
+    sprintf(replyBuff, "{\"%s\": \"%s\"}", cmd->nameStr, successFlg ? "ok" : "fail");
+}
+
+// *************************************************************************************************************************
+
+static constexpr cmdEntry_t cmdTable[] = {
+    // Name              Log Description             Handler                Reply        Class             MQTT Reply       Batch Check         Arg Max Size      Pin         Controllers
+    { CMD_AUDMODE_STR,    "Audio Mode",               audioModeCmd,          resultReply, CMD_CLASS_RADIO,  NULL,            audioModeCheck,     CMD_AUD_MAX_SZ,   0,          CMD_REMOTE_CNTRLS    },
+    { CMD_BATCH_STR,      "Batch Command",            batchCmd,              batchReply,  CMD_CLASS_RADIO,  MQTT_BATCH_STR,  NULL,               CMD_BATCH_MAX_SZ, 0,          CMD_REMOTE_CNTRLS    },
+    { CMD_FREQ_STR,       "Radio Frequency",          frequencyCmd,          resultReply, CMD_CLASS_RADIO,  NULL,            frequencyCheck,     CMD_FREQ_MAX_SZ,  0,          CMD_REMOTE_CNTRLS    },
+    { CMD_GPIO19_STR,     "GPIO19",                   gpio19Cmd,             gpioReply,   CMD_CLASS_GPIO,   MQTT_GPIO_STR,   NULL,               CMD_GPIO_MAX_SZ,  GPIO19_PIN, CMD_REMOTE_CNTRLS    },
+    { CMD_GPIO23_STR,     "GPIO23",                   gpio23Cmd,             gpioReply,   CMD_CLASS_GPIO,   MQTT_GPIO_STR,   NULL,               CMD_GPIO_MAX_SZ,  GPIO23_PIN, CMD_REMOTE_CNTRLS    },
+    { CMD_GPIO33_STR,     "GPIO33",                   gpio33Cmd,             gpioReply,   CMD_CLASS_GPIO,   MQTT_GPIO_STR,   NULL,               CMD_GPIO_MAX_SZ,  GPIO33_PIN, CMD_REMOTE_CNTRLS    },
+    { CMD_INFO_STR,       "System Information",       infoCmd,               infoReply,   CMD_CLASS_SYSTEM, MQTT_INFORM_STR, NULL,               CMD_INFO_MAX_SZ,  0,          CMD_REMOTE_CNTRLS    },
+    { SERIAL_LOG_STR,     "Serial Log Level",         logCmd,                resultReply, CMD_CLASS_SYSTEM, NULL,            NULL,               CMD_LOG_MAX_SZ,   0,          (1 << SERIAL_CNTRL)  },
+    { CMD_MUTE_STR,       "Audio Mute",               muteCmd,               resultReply, CMD_CLASS_RADIO,  NULL,            muteCheck,          CMD_MUTE_MAX_SZ,  0,          CMD_REMOTE_CNTRLS    },
+    { CMD_PICODE_STR,     "RDS PI Code",              piCodeCmd,             resultReply, CMD_CLASS_RDS,    NULL,            piCodeCheck,        CMD_PI_MAX_SZ,    0,          CMD_REMOTE_CNTRLS    },
+    { CMD_PSN_STR,        "RDS Program Service Name", programServiceNameCmd, resultReply, CMD_CLASS_RDS,    NULL,            textCheck,          RDS_PSN_MAX_SZ,   0,          CMD_REMOTE_CNTRLS    },
+    { CMD_PTYCODE_STR,    "RDS PTY Code",             ptyCodeCmd,            resultReply, CMD_CLASS_RDS,    NULL,            ptyCodeCheck,       CMD_PTY_MAX_SZ,   0,          CMD_REMOTE_CNTRLS    },
+    { CMD_REBOOT_STR,     "System Reboot",            rebootCmd,             resultReply, CMD_CLASS_SYSTEM, NULL,            NULL,               CMD_SYS_MAX_SZ,   0,          CMD_REMOTE_CNTRLS    },
+    { CMD_RF_CARRIER_STR, "RF Carrier Control",       rfCarrierCmd,          resultReply, CMD_CLASS_RADIO,  NULL,            rfCarrierCheck,     CMD_RF_MAX_SZ,    0,          CMD_REMOTE_CNTRLS    },
+    { CMD_RADIOTEXT_STR,  "RadioText Message",        radioTextCmd,          resultReply, CMD_CLASS_RDS,    NULL,            textCheck,          RDS_TEXT_MAX_SZ,  0,          CMD_REMOTE_CNTRLS    },
+    { CMD_PERIOD_STR,     "RadioText Time Period",    rdsTimePeriodCmd,      resultReply, CMD_CLASS_RDS,    NULL,            rdsTimePeriodCheck, CMD_TIME_MAX_SZ,  0,          CMD_REMOTE_CNTRLS    },
+    { CMD_START_STR,      "RDS Start",                startCmd,              resultReply, CMD_CLASS_RDS,    NULL,            NULL,               CMD_RDS_MAX_SZ,   0,          CMD_REMOTE_CNTRLS    },
+    { CMD_STOP_STR,       "RDS Stop",                 stopCmd,               resultReply, CMD_CLASS_RDS,    NULL,            NULL,               CMD_RDS_MAX_SZ,   0,          CMD_REMOTE_CNTRLS    },
+};
+
+static constexpr uint8_t CMD_TABLE_CNT = sizeof(cmdTable) / sizeof(cmdTable[0]);
+
+// cmdNameLess(), cmdTableSorted(): Compile time check of the cmdTable[] sort order.
+static constexpr bool cmdNameLess(const char *a, const char *b)
+{
+    return (*a == *b) ? (*a != '\0') && cmdNameLess(a + 1, b + 1) : (*a < *b);
+}
+
+static constexpr bool cmdTableSorted(uint8_t i)
+{
+    return (i + 1 >= CMD_TABLE_CNT) || (cmdNameLess(cmdTable[i].nameStr, cmdTable[i + 1].nameStr) && cmdTableSorted(i + 1));
+}
+
+static_assert(cmdTableSorted(0), "cmdTable[] must be sorted by command name, without duplicates.");
+
+// *************************************************************************************************************************
+// COMMAND RATE LIMITS: Token buckets, one per controller plus one per controller and command class. A bucket holds up
+// to burst tokens and refills at rate tokens per minute. Each command takes a token from both of its buckets, or is
+// dropped if either is empty. A class that is not counted in the controller's bucket (GPIO) only uses its own bucket,
+// so streamed GPIO commands neither hit nor use up the controller's limit. Token counts are in 1/1000 tokens.
+// Guarded by radioLock(), see dispatchCommand().
+typedef struct {
+    uint8_t  burst;                              // Bucket size, in commands.
+    uint16_t rate;                               // Refill rate, in commands per minute. Zero = no limit.
+    bool     cntrlFlg;                           // Class commands also use the controller's bucket.
+} cmdRate_t;
+
+typedef struct {
+    bool          fillFlg;                       // Bucket has been filled (first use).
+    uint32_t      tokens;                        // Tokens x 1000.
+    unsigned long lastMillis;                    // Last refill time.
+} cmdBucket_t;
+
+static const cmdRate_t cntrlRate = { CMD_CNTRL_BURST, CMD_CNTRL_RATE, true };
+
+static const cmdRate_t classRates[CMD_CLASS_CNT] = {
+    { CMD_RDS_BURST,    CMD_RDS_RATE,    true  }, // CMD_CLASS_RDS
+    { CMD_RADIO_BURST,  CMD_RADIO_RATE,  true  }, // CMD_CLASS_RADIO
+    { CMD_SYSTEM_BURST, CMD_SYSTEM_RATE, true  }, // CMD_CLASS_SYSTEM
+    { CMD_GPIO_BURST,   CMD_GPIO_RATE,   false }, // CMD_CLASS_GPIO
+};
+
+static cmdBucket_t cntrlBuckets[CMD_CNTRL_ID_MAX];
+static cmdBucket_t classBuckets[CMD_CNTRL_ID_MAX][CMD_CLASS_CNT];
+static uint32_t    cmdDropCnts[CMD_CNTRL_ID_MAX];
+
+// refillBucket(): Add the tokens earned since the last refill. Returns true if the bucket has a whole token.
+static bool refillBucket(cmdBucket_t *bucket, const cmdRate_t *rate, unsigned long currentMillis)
+{
+    uint64_t tokens;
+
+    if (rate->rate == 0) {
+        return true; // No limit.
+    }
+
+    if (!bucket->fillFlg) {
+        bucket->fillFlg = true;
+        tokens          = rate->burst * 1000UL;
+    }
+    else {
+        tokens = bucket->tokens + (uint64_t)(currentMillis - bucket->lastMillis) * rate->rate / 60;
+    }
+    bucket->tokens     = (tokens > rate->burst * 1000UL) ? rate->burst * 1000UL : tokens;
+    bucket->lastMillis = currentMillis;
+
+    return bucket->tokens >= 1000;
+}
+
+// takeCmdToken(): Take a token for the command from the controller's buckets. Returns false if the command must be
+// dropped (rate limit reached).
+static bool takeCmdToken(const cmdEntry_t *cmd, uint8_t controller)
+{
+    unsigned long currentMillis = getClockMillis();
+    cmdBucket_t  *cntrlBucket   = &cntrlBuckets[controller];
+    cmdBucket_t  *classBucket   = &classBuckets[controller][cmd->cmdClass];
+    bool useCntrlFlg = classRates[cmd->cmdClass].cntrlFlg;
+    bool cntrlFlg;
+    bool classFlg;
+
+    cntrlFlg = !useCntrlFlg || refillBucket(cntrlBucket, &cntrlRate, currentMillis);
+    classFlg = refillBucket(classBucket, &classRates[cmd->cmdClass], currentMillis);
+
+    if (!cntrlFlg || !classFlg) {
+        cmdDropCnts[controller]++;
+        return false;
+    }
+
+    if (useCntrlFlg && cntrlRate.rate) {
+        cntrlBucket->tokens -= 1000;
+    }
+
+    if (classRates[cmd->cmdClass].rate) {
+        classBucket->tokens -= 1000;
+    }
+    return true;
+}
+
+// *************************************************************************************************************************
+// getCmdDropCnt(): Return the number of commands dropped by the rate limits. NO_CNTRL returns the total.
+uint32_t getCmdDropCnt(uint8_t controller)
+{
+    uint32_t dropCnt = 0;
+
+    if (controller != NO_CNTRL) {
+        return (controller < CMD_CNTRL_ID_MAX) ? cmdDropCnts[controller] : 0;
+    }
+
+    for (uint8_t i = 0; i < CMD_CNTRL_ID_MAX; i++) {
+        dropCnt += cmdDropCnts[i];
+    }
+    return dropCnt;
+}
+
+// *************************************************************************************************************************
+// dispatchCommand(): Run the command's handler and format its JSON reply into replyBuff (CMD_REPLY_MAX_SZ).
+// Returns true if the command succeeded. The controllers run in different tasks; Holding radioLock() runs one
+// command at a time and keeps updateRadioSettings() from flushing a half applied batch.
+// A command over its rate limit is dropped and gets a "limited" reply. rxMicros is the micros() time the controller
+// received the command, the start of its latency trace.
+bool dispatchCommand(const cmdEntry_t *cmd, String payloadStr, uint8_t controller, char *replyBuff, uint32_t rxMicros)
+{
+    char logBuff[100];
+    bool successFlg;
+
+    radioLock();
+
+    if (!takeCmdToken(cmd, controller)) {
+        radioUnlock();
+        sprintf(logBuff, "-> %s Controller: %s Command Rate Limit Reached, Dropped.", getControllerName(controller).c_str(), cmd->logStr);
+        Log.warningln(logBuff);
+        sprintf(replyBuff, "{\"%s\": \"limited\"}", cmd->nameStr);
+        return false;
+    }
+    startCmdTrace(controller, rxMicros);
+    successFlg = cmd->handler(payloadStr, controller);
+    cmd->replyFn(replyBuff, cmd, successFlg, payloadStr);
+    endCmdTrace();
+    logTelemetryCmd(controller, cmd - cmdTable); // Saved if MQTT is offline.
+    radioUnlock();
+
+    return successFlg;
+}
+
+// *************************************************************************************************************************
+// findCommand(): Look up a command keyword (any case) for the controller. Returns NULL if the command is unknown or
+// the controller may not use it.
+const cmdEntry_t *findCommand(const char *nameStr, uint8_t controller)
+{
+    int16_t lo = 0;
+    int16_t hi = CMD_TABLE_CNT - 1;
+
+    while (lo <= hi) {
+        int16_t mid    = (lo + hi) / 2;
+        int     result = strcasecmp(nameStr, cmdTable[mid].nameStr);
+
+        if (result == 0) {
+            return (cmdTable[mid].cntrlMask & (1 << controller)) ? &cmdTable[mid] : NULL;
+        }
+        else if (result < 0) {
+            hi = mid - 1;
+        }
+        else {
+            lo = mid + 1;
+        }
+    }
+    return NULL;
+}
+
+// *************************************************************************************************************************
+// getCommand(): Return the command registry entry at index, NULL past the last entry. Used to walk the registry.
+const cmdEntry_t *getCommand(uint8_t index)
+{
+    return (index < CMD_TABLE_CNT) ? &cmdTable[index] : NULL;
+}
+
 // *************************************************************************************************************************
 // EOF
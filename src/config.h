@@ -31,6 +31,10 @@
 /* Uncomment ADD_CHIP_ID if you want the ESP32's Unique Chip ID to be appended to the AP (Hotspot) Host Name. */
 //#define ADD_CHIP_ID
 
+/* Uncomment I2C_FAST_MODE to run the QN8027 I2C bus at 400KHz (Fast Mode) instead of 100KHz.
+   Shortens RDS and register transfers. Requires clean SDA/SCL wiring with proper pull-ups. */
+//#define I2C_FAST_MODE
+
 /* COMMAND LINE INTERFACE SECTION (SERIAL PORT RDS CONTROLLER)
    Change CMD_EOL_TERM if your serial console doesn't send a Carriage Return <CR> when [ENTER] is pressed.
    For example, change to  '\n' if your terminal only sends a NEWLINE <LF> when [ENTER] is pressed. */
@@ -44,9 +48,16 @@ const IPAddress MQTT_IP_DEF = { 0u, 0u, 0u, 0u }; // Default IP of MQTT Broker s
 //const IPAddress MQTT_IP_DEF = { 192u, 168u, 1u, 202u }; // Default IP of MQTT Broker server. Can be changed in Web UI.
 const uint32_t MQTT_PORT_DEF = 1883;                // 1883 is Default MQTT Port. Change it here if differnt port is needed.
 
+/* Uncomment TLM_SPILL_ENB to let the MQTT offline telemetry buffer spill to LittleFS (up to 16KB) during long broker
+   outages. Otherwise only the newest 128 records are kept in RAM. */
+#define TLM_SPILL_ENB
+
 /* Uncomment HTTP_ENB define statement to enable the HTTP Controller. Approx 13KB used. */
 #define HTTP_ENB
 
+/* Uncomment UDP_ENB define statement to enable the UDP Controller (low latency show control commands). */
+#define UDP_ENB
+
 /* Uncomment MDNS_ENB define statement to enable mDNS. Approx 1.2KB used.
    Default mDNS name is PixelRadio.local */
 #define MDNS_ENB
@@ -22,10 +22,12 @@ extern bool activeTextHttpFlg;
 extern bool activeTextLocalFlg;
 extern bool activeTextMqttFlg;
 extern bool activeTextSerialFlg;
+extern bool activeTextUdpFlg;
 extern bool apFallBackFlg;
 extern bool ctrlLocalFlg;
 extern bool ctrlHttpFlg;
 extern bool ctrlMqttFlg;
+extern bool ctrlUdpFlg;
 //extern bool ctrlSerialFlg;
 extern bool newVgaGainFlg;
 extern bool newAutoRfFlg;
@@ -49,13 +51,7 @@ extern bool rebootFlg;
 extern bool rfAutoFlg;
 extern bool rfCarrierFlg;
 extern bool stereoEnbFlg;
-extern bool stopHttpFlg;
-extern bool stopMqttFlg;
-extern bool stopSerialFlg;
 extern bool testModeFlg;
-extern bool textHttpFlg;
-extern bool textMqttFlg;
-extern bool textSerialFlg;
 extern bool wifiDhcpFlg;
 extern bool WiFiRebootFlg;
 
@@ -67,6 +63,7 @@ extern uint8_t  rdsHttpPtyCode;
 extern uint8_t  rdsLocalPtyCode;
 extern uint8_t  rdsMqttPtyCode;
 extern uint8_t  rdsSerialPtyCode;
+extern uint8_t  rdsUdpPtyCode;
 
 extern uint16_t mqttPort;
 
@@ -74,6 +71,7 @@ extern uint16_t rdsHttpPiCode;
 extern uint16_t rdsLocalPiCode;
 extern uint16_t rdsMqttPiCode;
 extern uint16_t rdsSerialPiCode;
+extern uint16_t rdsUdpPiCode;
 
 extern uint16_t fmFreqX10;
 
@@ -83,10 +81,12 @@ extern unsigned long rdsHttpMsgTime;
 extern unsigned long rdsLocalMsgTime;
 extern unsigned long rdsMqttMsgTime;
 extern unsigned long rdsSerialMsgTime;
+extern unsigned long rdsUdpMsgTime;
 extern unsigned long rdsMsgTime;
 
 extern float vbatVolts;
 extern float paVolts;
+extern float rdsGroupRate;
 
 // WiFi Vars, including Credentials
 extern IPAddress hotSpotIP;
@@ -119,9 +119,11 @@ extern String mqttUserStr;
 extern String rdsHttpPsnStr;
 extern String rdsMqttPsnStr;
 extern String rdsSerialPsnStr;
+extern String rdsUdpPsnStr;
 extern String rdsHttpTextStr;
 extern String rdsMqttTextStr;
 extern String rdsSerialTextStr;
+extern String rdsUdpTextStr;
 extern String rdsTextMsgStr;
 extern String rdsTextMsg1Str;
 extern String rdsTextMsg2Str;
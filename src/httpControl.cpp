@@ -0,0 +1,236 @@
+/*
+   File: httpControl.cpp
+   Project: PixelRadio, an RBDS/RDS FM Transmitter (QN8027 Digital FM IC)
+   Version: 1.1.2
+   Creation: Oct-18-2022
+   Revised:  Oct-18-2022
+   Revision History: See PixelRadio.cpp
+   Project Leader: T. Black (thomastech)
+   Contributors: thomastech
+
+   (c) copyright T. Black 2021-2022, Licensed under GNU GPL 3.0 and later, under this
+   license absolutely no warranty is given.
+   This Code was formatted with the uncrustify extension.
+
+   Note 1: HTTP Controller request handling, see httpControl.h. Runs in the AsyncTCP task.
+   Note 2: getCommandArg() is shared with the UDP Controller.
+ */
+
+// *********************************************************************************************
+
+#include <ArduinoLog.h>
+#include <WiFi.h>
+#include "config.h"
+#include "PixelRadio.h"
+#include "httpControl.h"
+
+// *********************************************************************************************
+// getCommandArg(): Prepare the HTTP or UDP Controller's Command Argument, in place. Limits the length
+// and trims off leading and trailing spaces. Returns the String Length. If argument missing then returns -1;
+#if defined(HTTP_ENB) || defined(UDP_ENB)
+int16_t getCommandArg(char *argStr, uint16_t maxSize) {
+    char  *startPtr = argStr;
+    size_t argLen   = strlen(argStr);
+
+    if (argLen == 0) {
+        return -1; // Fail, Argument Missing.
+    }
+    else if (argLen > maxSize) {
+        argStr[maxSize] = '\0';
+        argLen          = maxSize;
+    }
+
+    for (size_t i = 0; i < argLen; i++) {
+        if (argStr[i] == 0x7f) { // Replace html encoded control "DEL" with space (Text Clear Cmd).
+            argStr[i] = ' ';
+        }
+    }
+
+    // Arg length is OK, now safe to Trim off leading and trailing spaces.
+    while (argLen > 0 && isspace(argStr[argLen - 1])) {
+        argStr[--argLen] = '\0';
+    }
+
+    while (isspace(*startPtr)) {
+        startPtr++;
+        argLen--;
+    }
+    memmove(argStr, startPtr, argLen + 1);
+
+    return argLen;
+}
+
+#endif // if defined(HTTP_ENB) || defined(UDP_ENB)
+
+#ifdef HTTP_ENB
+
+// *********************************************************************************************
+// httpClientInit(): Prepare a new client connection.
+void httpClientInit(httpClient_t *conn)
+{
+    httpParserInit(&conn->parser);
+    conn->doneFlg     = false;
+    conn->eventFlg    = false;
+    conn->reqCnt      = 0;
+    conn->eventSeq    = 0;
+    conn->rxMicros    = 0;
+    conn->startMillis = millis();
+}
+
+// *********************************************************************************************
+// httpClientPoll(): Check a request client's timeouts, call it on each AsyncTCP poll. An idle keep-alive connection
+//                   is closed after HTTP_KEEP_ALIVE_TIME, an unfinished request after CLIENT_TIMEOUT.
+//                   Returns HTTP_CLIENT_CLOSE if the connection must be closed.
+uint8_t httpClientPoll(httpClient_t *conn)
+{
+    if (conn->doneFlg || conn->eventFlg) {
+        return HTTP_CLIENT_OPEN;
+    }
+    else if ((conn->reqCnt > 0) && (conn->parser.state == HTTP_PARSE_METHOD) && (conn->parser.buffLen == 0)) {
+        if (millis() - conn->startMillis > HTTP_KEEP_ALIVE_TIME) { // Idle keep-alive connection.
+            Log.verboseln("-> HTTP Controller: Idle Client, Disconnected.");
+            conn->doneFlg = true;
+            return HTTP_CLIENT_CLOSE;
+        }
+    }
+    else if (millis() - conn->startMillis > CLIENT_TIMEOUT) {
+        Log.infoln("-> HTTP Controller: Client Timeout, Disconnected.");
+        conn->doneFlg = true;
+        return HTTP_CLIENT_CLOSE;
+    }
+
+    return HTTP_CLIENT_OPEN;
+}
+
+// *********************************************************************************************
+// httpClientReceive(): HTTP Controller receive loop, for each piece of a client's data. Saves the request;
+//                      Processes it once the header and any POST data is in, and sends the reply with writeFn.
+//                      The connection is kept open for more requests (keep-alive) unless the client asks to close
+//                      it or it reaches HTTP_KEEP_ALIVE_MAX. Pipelined requests are answered in order.
+//                      Returns HTTP_CLIENT_CLOSE or HTTP_CLIENT_EVENTS if the caller must act, else HTTP_CLIENT_OPEN.
+uint8_t httpClientReceive(httpClient_t *conn, const char *data, size_t len, httpWriteFn_t writeFn, void *writeArg)
+{
+    bool   keepAliveFlg;
+    size_t usedLen;
+    String replyStr;
+
+    while ((len > 0) && !conn->doneFlg) { // doneFlg = Closing, ignore any extra data.
+        if ((conn->parser.state == HTTP_PARSE_METHOD) && (conn->parser.buffLen == 0)) {
+            conn->startMillis = millis(); // New request, CLIENT_TIMEOUT starts now.
+            conn->rxMicros    = micros();
+        }
+
+        usedLen = httpParse(&conn->parser, data, len);
+        data   += usedLen;
+        len    -= usedLen;
+
+        if (conn->parser.state != HTTP_PARSE_DONE) {
+            return HTTP_CLIENT_OPEN; // Wait for more data.
+        }
+
+        if (conn->parser.contentLen > 0) {
+            Log.verboseln("-> HTTP CMD: Found Post Data");
+        }
+
+        if (strcasecmp(conn->parser.path, HTTP_EVENTS_PATH_STR) == 0) {
+            conn->doneFlg = true;
+            return HTTP_CLIENT_EVENTS;
+        }
+
+        conn->reqCnt++;
+        keepAliveFlg = httpKeepAlive(&conn->parser) && (conn->reqCnt < HTTP_KEEP_ALIVE_MAX);
+        replyStr     = processHttpRequest(&conn->parser, keepAliveFlg, conn->rxMicros);
+
+        if (replyStr.length() > 0) {
+            writeFn(writeArg, replyStr.c_str(), replyStr.length());
+        }
+        else {
+            keepAliveFlg = false; // No reply, the client only sees the close.
+        }
+
+        if (!keepAliveFlg) {
+            conn->doneFlg = true;
+            return HTTP_CLIENT_CLOSE; // Close the HTTP connection, reply is flushed first.
+        }
+
+        httpParserInit(&conn->parser); // Ready for the next request, it may already be in this data.
+        conn->startMillis = millis();  // HTTP_KEEP_ALIVE_TIME starts now.
+    }
+
+    return HTTP_CLIENT_OPEN;
+}
+
+// *********************************************************************************************
+// makeHttpPageStr(): Return the complete HTTP reply (header and html page) for the JSON formatted reply.
+//                    keepAliveFlg = true if the connection stays open for more requests.
+String makeHttpPageStr(const String& jsonStr, bool keepAliveFlg) {
+    char   lenBuff[30];
+    size_t bodyLen = strlen(HTML_DOCTYPE_STR) + jsonStr.length() + 2 + strlen(HTML_CLOSE_STR);
+    String pageStr;
+
+    pageStr.reserve(sizeof(HTML_HEADER_STR) + sizeof(lenBuff) + sizeof(HTML_CONN_KEEP_STR) + bodyLen);
+    sprintf(lenBuff, "Content-Length: %u\r\n", bodyLen);
+    pageStr  = HTML_HEADER_STR;
+    pageStr += lenBuff;
+    pageStr += keepAliveFlg ? HTML_CONN_KEEP_STR : HTML_CONN_CLOSE_STR;
+    pageStr += HTML_DOCTYPE_STR;
+    pageStr += jsonStr;
+    pageStr += "\r\n";
+    pageStr += HTML_CLOSE_STR;
+
+    return pageStr;
+}
+
+// *********************************************************************************************
+// processHttpRequest(): Process the HTTP Controller command in the parsed client request. Returns the
+//                       HTTP reply to send, empty if none. keepAliveFlg is passed to makeHttpPageStr().
+//                       rxMicros is the time the request started to arrive.
+String processHttpRequest(httpParser_t *parser, bool keepAliveFlg, uint32_t rxMicros)
+{
+    char  logBuff[80];
+    char  replyBuff[CMD_REPLY_MAX_SZ];
+    char *argStr;                   // Command Argument, points into the parser's buffer.
+    char *cmdStr;                   // Command keyword, points into the parser's buffer.
+    const cmdEntry_t *cmd = NULL;
+
+    // ************ NO COMMAND, EMPTY PAYLOAD ***************
+    if (strcmp(parser->path, HTTP_EMPTY_PATH_STR) == 0) {
+        Log.verboseln("-> HTTP CMD: Empty Payload, Ignored");
+        return "";
+    }
+
+    // Command is the first query parameter; Or the POST data if the query is empty.
+    if (strcasecmp(parser->path, HTTP_CMD_PATH_STR) == 0) {
+        httpNextParam(*parser->query ? parser->query : parser->body, &cmdStr, &argStr);
+        cmd = findCommand(cmdStr, HTTP_CNTRL);
+    }
+    else if (strcasecmp(parser->path, HTTP_BATCH_PATH_STR) == 0) { // POST data is the JSON object, not URL encoded.
+        argStr = parser->body;
+        cmd    = findCommand(CMD_BATCH_STR, HTTP_CNTRL);
+    }
+
+    // ************ UNKNOWN COMMAND ***************
+    if (cmd == NULL) {
+        Log.errorln("-> HTTP CMD: COMMAND IS UNDEFINED");
+        return makeHttpPageStr("{\"cmd\": \"undefined\"}", keepAliveFlg); // JSON Fmt.
+    }
+
+    sprintf(logBuff, "-> HTTP CMD: %s", cmd->logStr);
+    Log.infoln(logBuff);
+
+    if (getCommandArg(argStr, cmd->maxSize) == -1) {
+        sprintf(logBuff, "-> HTTP CMD: %s, Missing Value (abort).", cmd->logStr);
+        Log.errorln(logBuff);
+        cmd->replyFn(replyBuff, cmd, false, "");
+    }
+    else {
+        dispatchCommand(cmd, argStr, HTTP_CNTRL, replyBuff, rxMicros);
+    }
+
+    return makeHttpPageStr(replyBuff, keepAliveFlg);
+}
+
+#endif // ifdef HTTP_ENB
+
+// *********************************************************************************************
+// EOF
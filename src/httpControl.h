@@ -0,0 +1,64 @@
+/*
+   File: httpControl.h
+   Project: PixelRadio, an RBDS/RDS FM Transmitter (QN8027 Digital FM IC)
+   Version: 1.1.2
+   Creation: Oct-18-2022
+   Revised:  Oct-18-2022
+   Revision History: See PixelRadio.cpp
+   Project Leader: T. Black (thomastech)
+   Contributors: thomastech
+
+   (c) copyright T. Black 2021-2022, Licensed under GNU GPL 3.0 and later, under this
+   license absolutely no warranty is given.
+   This Code was formatted with the uncrustify extension.
+
+   Note 1: HTTP Controller connections: Request receive loop (keep-alive and pipelining), timeouts,
+           and the command replies. webServer.cpp connects these to AsyncTCP.
+   Note 2: No AsyncTCP dependencies, so the request path can be run on a host, see test/test_http_control.
+ */
+
+// *********************************************************************************************
+
+#pragma once
+#include <Arduino.h>
+#include "httpParser.h"
+
+// *********************************************************************************************
+
+// HTTP Controller client, one per connection. Freed when the client disconnects.
+typedef struct {
+    httpParser_t  parser;          // Request parser, holds the request.
+    bool          doneFlg;         // Request answered, waiting for disconnect.
+    bool          eventFlg;        // Client is a status event stream, see updateHttpEvents().
+    uint8_t       reqCnt;          // Requests answered on this connection (keep-alive).
+    uint32_t      eventSeq;        // Last status event sent to the client.
+    uint32_t      rxMicros;        // Request start time, for the Command Latency Trace.
+    unsigned long startMillis;     // Request start or last reply time, for the timeouts. Last event time for event stream clients.
+} httpClient_t;
+
+// httpClientReceive() and httpClientPoll() results.
+const uint8_t HTTP_CLIENT_OPEN   = 0; // Keep the connection open.
+const uint8_t HTTP_CLIENT_CLOSE  = 1; // Close the connection, any replies have been written.
+const uint8_t HTTP_CLIENT_EVENTS = 2; // Start the status event stream.
+
+typedef void (*httpWriteFn_t)(void       *arg,
+                              const char *data,
+                              size_t      len);
+
+// *********************************************************************************************
+
+void    httpClientInit(httpClient_t *conn);
+uint8_t httpClientPoll(httpClient_t *conn);
+uint8_t httpClientReceive(httpClient_t *conn,
+                          const char   *data,
+                          size_t        len,
+                          httpWriteFn_t writeFn,
+                          void         *writeArg);
+String  makeHttpPageStr(const String& jsonStr,
+                        bool          keepAliveFlg);
+String  processHttpRequest(httpParser_t *parser,
+                           bool          keepAliveFlg,
+                           uint32_t      rxMicros);
+
+// *********************************************************************************************
+// EOF
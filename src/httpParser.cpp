@@ -0,0 +1,283 @@
+/*
+   File: httpParser.cpp
+   Project: PixelRadio, an RBDS/RDS FM Transmitter (QN8027 Digital FM IC)
+   Version: 1.1.2
+   Creation: Oct-18-2022
+   Revised:  Oct-18-2022
+   Revision History: See PixelRadio.cpp
+   Project Leader: T. Black (thomastech)
+   Contributors: thomastech
+
+   (c) copyright T. Black 2021-2022, Licensed under GNU GPL 3.0 and later, under this
+   license absolutely no warranty is given.
+   This Code was formatted with the uncrustify extension.
+
+   Note 1: Chars that do not fit in the buffer are dropped (truncFlg is set), the request is still
+           parsed to the end so the connection stays in step.
+   Note 2: POST data ends at Content-Length. CR/LF in the POST data are saved as spaces, so multi-line
+           (pretty printed) JSON batch commands fit in one field.
+ */
+
+// *********************************************************************************************
+
+#include <ctype.h>
+#include <string.h>
+#include "httpParser.h"
+
+// *********************************************************************************************
+
+static const char    contentLenStr[] = "content-length:";
+static const uint8_t CONTENT_LEN_SZ  = sizeof(contentLenStr) - 1;
+static const char    connStr[]       = "connection:";
+static const uint8_t CONN_SZ         = sizeof(connStr) - 1;
+static const uint8_t HDR_NO_MATCH    = 0xFF;
+static const uint8_t FIELD_CNT       = 4; // Method, Path, Query, Body. One terminator each.
+
+// *********************************************************************************************
+// endField(): Terminate the field being saved. Room for the terminators is always kept free.
+static void endField(httpParser_t *parser)
+{
+    parser->buff[parser->buffLen++] = '\0';
+}
+
+// *********************************************************************************************
+// hexValue(): Return the value of a hex digit, zero if not hex.
+static uint8_t hexValue(char c)
+{
+    if ((c >= '0') && (c <= '9')) {
+        return c - '0';
+    }
+
+    if ((c >= 'a') && (c <= 'f')) {
+        return c - 'a' + 10;
+    }
+
+    if ((c >= 'A') && (c <= 'F')) {
+        return c - 'A' + 10;
+    }
+
+    return 0;
+}
+
+// *********************************************************************************************
+// saveChar(): Save a char to the current field, drop it if the buffer is full.
+static void saveChar(httpParser_t *parser, char c)
+{
+    if (parser->buffLen < HTTP_PARSE_BUFF_SZ - FIELD_CNT) {
+        parser->buff[parser->buffLen++] = c;
+    }
+    else {
+        parser->truncFlg = true;
+    }
+}
+
+// *********************************************************************************************
+// httpParse(): Feed received data to the parser. Returns the number of chars used, which is less than
+// len if the request ended early (the rest belongs to the next request). Check parser->state for
+// HTTP_PARSE_DONE.
+size_t httpParse(httpParser_t *parser, const char *data, size_t len)
+{
+    size_t i;
+
+    for (i = 0; (i < len) && (parser->state != HTTP_PARSE_DONE); i++) {
+        char c = data[i];
+
+        switch (parser->state) {
+            case HTTP_PARSE_METHOD:
+
+                if (c == ' ') {
+                    endField(parser);
+                    parser->path  = parser->buff + parser->buffLen;
+                    parser->state = HTTP_PARSE_PATH;
+                }
+                else if ((c != '\r') && (c != '\n')) { // Skip blank lines before the request.
+                    saveChar(parser, c);
+                }
+                break;
+
+            case HTTP_PARSE_PATH:
+
+                if (c == '?') {
+                    endField(parser);
+                    parser->query = parser->buff + parser->buffLen;
+                    parser->state = HTTP_PARSE_QUERY;
+                }
+                else if ((c == ' ') || (c == '\n')) {
+                    endField(parser);
+                    parser->state = (c == ' ') ? HTTP_PARSE_VERSION : HTTP_PARSE_HEADER;
+                }
+                else if (c != '\r') {
+                    saveChar(parser, c);
+                }
+                break;
+
+            case HTTP_PARSE_QUERY:
+
+                if ((c == ' ') || (c == '\n')) {
+                    endField(parser);
+                    parser->state = (c == ' ') ? HTTP_PARSE_VERSION : HTTP_PARSE_HEADER;
+                }
+                else if (c != '\r') {
+                    saveChar(parser, c);
+                }
+                break;
+
+            case HTTP_PARSE_VERSION:
+
+                if (c == '\n') {
+                    parser->state = HTTP_PARSE_HEADER;
+                }
+                else if (isdigit(c)) {
+                    parser->verMinor = c - '0'; // Last digit of "HTTP/1.x".
+                }
+                break;
+
+            case HTTP_PARSE_HEADER:
+
+                if (c == '\n') {
+                    if (parser->lineLen == 0) { // Blank line, end of header.
+                        if (parser->contentLen > 0) {
+                            parser->body  = parser->buff + parser->buffLen;
+                            parser->state = HTTP_PARSE_BODY;
+                        }
+                        else {
+                            parser->state = HTTP_PARSE_DONE;
+                        }
+                    }
+                    parser->lineLen   = 0;
+                    parser->hdrMatch  = 0;
+                    parser->connMatch = 0;
+                }
+                else if (c != '\r') {
+                    if (parser->lineLen < 0xFF) {
+                        parser->lineLen++;
+                    }
+
+                    if (parser->hdrMatch < CONTENT_LEN_SZ) {
+                        parser->hdrMatch = (tolower(c) == contentLenStr[parser->hdrMatch]) ? parser->hdrMatch + 1 : HDR_NO_MATCH;
+                    }
+                    else if ((parser->hdrMatch == CONTENT_LEN_SZ) && isdigit(c)) {
+                        uint32_t value = parser->contentLen * 10UL + (c - '0');
+                        parser->contentLen = (value > 0xFFFF) ? 0xFFFF : value;
+                    }
+
+                    if (parser->connMatch < CONN_SZ) {
+                        parser->connMatch = (tolower(c) == connStr[parser->connMatch]) ? parser->connMatch + 1 : HDR_NO_MATCH;
+                    }
+                    else if ((parser->connMatch == CONN_SZ) && (parser->connValue == '\0') && (c != ' ')) {
+                        parser->connValue = tolower(c); // 'c' = close, 'k' = keep-alive.
+                    }
+                }
+                break;
+
+            case HTTP_PARSE_BODY:
+
+                saveChar(parser, ((c == '\r') || (c == '\n')) ? ' ' : c);
+                parser->bodyCnt++;
+
+                if (parser->bodyCnt >= parser->contentLen) {
+                    endField(parser);
+                    parser->state = HTTP_PARSE_DONE;
+                }
+                break;
+        }
+    }
+
+    return i;
+}
+
+// *********************************************************************************************
+// httpParserInit(): Prepare the parser for a new request.
+void httpParserInit(httpParser_t *parser)
+{
+    parser->buff[HTTP_PARSE_BUFF_SZ - 1] = '\0'; // Shared empty string for missing fields.
+    parser->method     = parser->buff;
+    parser->path       = parser->buff + HTTP_PARSE_BUFF_SZ - 1;
+    parser->query      = parser->path;
+    parser->body       = parser->path;
+    parser->buffLen    = 0;
+    parser->contentLen = 0;
+    parser->bodyCnt    = 0;
+    parser->state      = HTTP_PARSE_METHOD;
+    parser->lineLen    = 0;
+    parser->hdrMatch   = 0;
+    parser->connMatch  = 0;
+    parser->connValue  = '\0';
+    parser->verMinor   = 0;
+    parser->truncFlg   = false;
+}
+
+// *********************************************************************************************
+// httpKeepAlive(): Returns true if the client wants the connection kept open after the reply.
+// HTTP/1.1 keeps it open unless "Connection: close", HTTP/1.0 only with "Connection: keep-alive".
+bool httpKeepAlive(const httpParser_t *parser)
+{
+    if (parser->connValue == 'c') {
+        return false;
+    }
+    else if (parser->connValue == 'k') {
+        return true;
+    }
+    return parser->verMinor >= 1;
+}
+
+// *********************************************************************************************
+// httpNextParam(): Split the first "name=value" parameter off a query string, in place. The name and
+// value are URL decoded. Returns the rest of the query string, NULL if none.
+char* httpNextParam(char *str, char **name, char **value)
+{
+    char *nextPtr = strchr(str, '&');
+    char *eqPtr;
+
+    if (nextPtr != NULL) {
+        *nextPtr++ = '\0';
+    }
+
+    eqPtr = strchr(str, '=');
+    *name = str;
+
+    if (eqPtr != NULL) {
+        *eqPtr = '\0';
+        *value = eqPtr + 1;
+    }
+    else {
+        *value = str + strlen(str); // No value, empty string.
+    }
+
+    urlDecodeInPlace(*name);
+    urlDecodeInPlace(*value);
+
+    return nextPtr;
+}
+
+// *********************************************************************************************
+// urlDecodeInPlace(): Convert URL encoding into ASCII, in place. '+' is a space, a non-hex escape digit
+// counts as zero. An incomplete trailing escape is dropped. Returns the new length.
+size_t urlDecodeInPlace(char *str)
+{
+    char *srcPtr = str;
+    char *dstPtr = str;
+
+    while (*srcPtr) {
+        if (*srcPtr == '%') {
+            if ((srcPtr[1] == '\0') || (srcPtr[2] == '\0')) {
+                break;
+            }
+            *dstPtr++ = (hexValue(srcPtr[1]) << 4) | hexValue(srcPtr[2]);
+            srcPtr   += 3;
+        }
+        else if (*srcPtr == '+') {
+            *dstPtr++ = ' ';
+            srcPtr++;
+        }
+        else {
+            *dstPtr++ = *srcPtr++;
+        }
+    }
+    *dstPtr = '\0';
+
+    return dstPtr - str;
+}
+
+// *********************************************************************************************
+// EOF
@@ -0,0 +1,72 @@
+/*
+   File: httpParser.h
+   Project: PixelRadio, an RBDS/RDS FM Transmitter (QN8027 Digital FM IC)
+   Version: 1.1.2
+   Creation: Oct-18-2022
+   Revised:  Oct-18-2022
+   Revision History: See PixelRadio.cpp
+   Project Leader: T. Black (thomastech)
+   Contributors: thomastech
+
+   (c) copyright T. Black 2021-2022, Licensed under GNU GPL 3.0 and later, under this
+   license absolutely no warranty is given.
+   This Code was formatted with the uncrustify extension.
+
+   Note 1: Incremental HTTP request parser for the HTTP Controller. Data is fed as it arrives, in any
+           size pieces. The method, path, query and POST data are saved in one fixed buffer; Headers
+           are scanned on the fly and only Content-Length and Connection are kept. No heap is used.
+           Pipelined requests are supported, httpParse() stops at the end of each request.
+   Note 2: Plain C++, no Arduino dependencies. It can be compiled on any host, see test/test_http_parser.
+ */
+
+// *********************************************************************************************
+
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+// *********************************************************************************************
+
+const uint16_t HTTP_PARSE_BUFF_SZ = 512; // Method + Path + Query + POST data, each null terminated.
+
+// Parser States.
+const uint8_t HTTP_PARSE_METHOD  = 0;
+const uint8_t HTTP_PARSE_PATH    = 1;
+const uint8_t HTTP_PARSE_QUERY   = 2;
+const uint8_t HTTP_PARSE_VERSION = 3;     // Rest of the request line, not saved.
+const uint8_t HTTP_PARSE_HEADER  = 4;
+const uint8_t HTTP_PARSE_BODY    = 5;
+const uint8_t HTTP_PARSE_DONE    = 6;
+
+typedef struct {
+    char     buff[HTTP_PARSE_BUFF_SZ];
+    char    *method;                      // Points into buff.
+    char    *path;
+    char    *query;                       // Chars after '?', may be empty.
+    char    *body;                        // POST data, may be empty.
+    uint16_t buffLen;
+    uint16_t contentLen;                  // Content-Length header value.
+    uint16_t bodyCnt;                     // POST data chars received (including any dropped).
+    uint8_t  state;
+    uint8_t  lineLen;                     // Header line length, zero at end of header.
+    uint8_t  hdrMatch;                    // Chars matched of "content-length:", 0xFF if no match.
+    uint8_t  connMatch;                   // Chars matched of "connection:", 0xFF if no match.
+    char     connValue;                   // First char of the Connection header value (lower case), 0 if none.
+    uint8_t  verMinor;                    // HTTP minor version (1 = HTTP/1.1), zero if none.
+    bool     truncFlg;                    // Buffer was full, some chars were dropped.
+} httpParser_t;
+
+// *********************************************************************************************
+
+size_t httpParse(httpParser_t *parser,
+                 const char   *data,
+                 size_t        len);
+bool   httpKeepAlive(const httpParser_t *parser);
+void   httpParserInit(httpParser_t *parser);
+char*  httpNextParam(char  *str,
+                     char **name,
+                     char **value);
+size_t urlDecodeInPlace(char *str);
+
+// *********************************************************************************************
+// EOF
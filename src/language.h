@@ -76,6 +76,9 @@
 #define CTRL_MQTT_SEP_STR    "MQTT CONTROL SETTINGS"
 #define CTRL_MQTT_USER_STR   "BROKER USERNAME"
 #define CTRL_SERIAL_STR      "SERIAL CONTROL"
+#define CTRL_UDP_PORT_STR    "UDP PORT NUMBER"
+#define CTRL_UDP_STR         "UDP CONTROL"
+#define CTRL_UDP_SEP_STR     "UDP CONTROL SETTINGS"
 #define CTLR_SERIAL_MSG_STR  "WARNING: DIAGNOSTIC SERIAL LOG IS ON"
 #define CTRL_USB_SERIAL_STR  "USB SERIAL CONTROL SETTINGS"
 
@@ -85,12 +88,14 @@
 
 #define DIAG_BOOT_MSG1_STR   "WARNING: SYSTEM WILL REBOOT<br>** RELEASE NOW TO ABORT **"
 #define DIAG_BOOT_MSG2_STR   "** SYSTEM REBOOTING **<br>WAIT 30 SECONDS BEFORE ACCESSING WEB PAGE."
+#define DIAG_CMD_DROP_STR    "COMMANDS DROPPED"
 #define DIAG_DEBUG_SEP_STR   "CODE DEBUGGING"
 #define DIAG_FREE_MEM_STR    "FREE MEMORY"
 #define DIAG_HEALTH_SEP_STR  "HEALTH"
 #define DIAG_LOG_LVL_STR     "SERIAL LOG LEVEL"
 #define DIAG_LOG_MSG_STR     "WARNING: SERIAL CONTROLLER IS ON"
 #define DIAG_LONG_PRESS_STR  "Long Press (5secs)"
+#define DIAG_RDS_RATE_STR    "RDS GROUP RATE"
 #define DIAG_REBOOT_STR      "REBOOT SYSTEM"
 #define DIAG_SYSTEM_SEP_STR  "SYSTEM"
 #define DIAG_RUN_TIME_STR    "SYSTEM RUN TIME"
@@ -152,7 +157,6 @@
 #define HOME_WIFI_STR       "WIFI RSSI"
 
 #define MQTT_SUBSCR_NM_STR   "BROKER SUBSCRIBE NAME"
-#define MQTT_DISABLED_STR    "CONNECTION FAILED!<br>DISABLED MQTT CONTROLLER"
 #define MQTT_DISCONNECT_STR  "DISCONNECTED"
 #define MQTT_MISSING_STR     "MISSING SETTINGS : MQTT DISABLED"
 #define MQTT_NOT_AVAIL_STR   "MQTT NOT AVAILABLE IN AP MODE"
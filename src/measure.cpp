@@ -128,10 +128,10 @@ void initVdcBuffer(void)
 // processMeasurements(): Periodically perform voltage measurements. Must be called in main loop.
 void processMeasurements(void)
 {
-    unsigned long currentMillis             = millis(); // Snapshot of System Timer.
-    static unsigned long previousMeasMillis = millis(); // Timer for Voltage Measurement.
+    unsigned long currentMillis             = getClockMillis(); // Snapshot of System Timer.
+    static unsigned long previousMeasMillis = getClockMillis(); // Timer for Voltage Measurement.
 
-    currentMillis = millis();
+    currentMillis = getClockMillis();
 
     // System Tick Timers Tasks
     if (currentMillis - previousMeasMillis >= MEAS_TIME) {
@@ -27,6 +27,8 @@
 
 extern QN8027Radio radio;
 
+static unsigned long (*clockSource)(void) = millis; // Time base for the schedulers and UI timers.
+
 // *********************************************************************************************
 
 // addChipID(): Add the ESP32 Chip ID to the provided name. Used to create unique host names.
@@ -45,6 +47,14 @@ const String addChipID(const char *name) {
     return idStr;
 }
 
+// *********************************************************************************************
+// getClockMillis(): Return the elapsed time (mS) from the active clock source. Replaces millis()
+// in the RDS scheduler, test tones, and UI timers so they can be run from a simulated clock.
+unsigned long getClockMillis(void)
+{
+    return clockSource();
+}
+
 // *********************************************************************************************
 uint8_t i2cScanner(void)
 {
@@ -126,6 +136,14 @@ void rebootSystem(void)
     }
 }
 
+// *********************************************************************************************
+// setClockSource(): Select the clock used by getClockMillis(). NULL restores millis().
+//                   Allows a simulation to run the schedulers faster than real time.
+void setClockSource(unsigned long (*source)(void))
+{
+    clockSource = source ? source : millis;
+}
+
 // *********************************************************************************************
 // setGpioBootPins(): Set the GPIO Pin Boot States using Web UI settings.
 void setGpioBootPins(void)
@@ -280,9 +298,9 @@ void updateTestTones(bool resetTimerFlg)
     static uint8_t  minutes     = 0;
     static uint8_t  seconds     = 0;
     static uint8_t  state       = 0;
-    static unsigned long clockMillis = millis();
-    static unsigned long timerMillis = millis();
-    unsigned long currentMillis      = millis();
+    static unsigned long clockMillis = getClockMillis();
+    static unsigned long timerMillis = getClockMillis();
+    unsigned long currentMillis      = getClockMillis();
 
     const uint16_t toneList[] =
     { TONE_NONE, TONE_NONE, TONE_NONE, TONE_A3, TONE_E4, TONE_A3, TONE_C4, TONE_C5, TONE_F4, TONE_F4, TONE_A4, TONE_NONE };
@@ -293,8 +311,8 @@ void updateTestTones(bool resetTimerFlg)
         return;
     }
     else if (!testModeFlg) {
-        clockMillis = millis();
-        timerMillis = millis();
+        clockMillis = getClockMillis();
+        timerMillis = getClockMillis();
         goFlg = false;
         state = 0;
         digitalWrite(MUX_PIN, TONE_OFF); // Switch Audio Mux chip to Line-In.
@@ -311,7 +329,7 @@ void updateTestTones(bool resetTimerFlg)
     if (rstFlg == true) {           // State machine reset was requested.
         rstFlg      = false;
         goFlg       = true;         // Request tone sequence now.
-        clockMillis = millis();
+        clockMillis = getClockMillis();
         timerMillis = clockMillis;
         hours       = 0;
         minutes     = 0;
@@ -321,7 +339,7 @@ void updateTestTones(bool resetTimerFlg)
 
     // Update the test tone clock. HH:MM:SS will be sent as RadioText.
     if ((currentMillis - clockMillis) >= 1000) {
-        clockMillis = millis() - ((currentMillis - clockMillis) - 1000);
+        clockMillis = getClockMillis() - ((currentMillis - clockMillis) - 1000);
         seconds++;
 
         if (seconds >= 60) {
@@ -343,8 +361,8 @@ void updateTestTones(bool resetTimerFlg)
         goFlg = true;
     }
 
-    if (goFlg && (millis() >= timerMillis + TEST_TONE_TIME)) {
-        timerMillis = millis();
+    if (goFlg && (getClockMillis() >= timerMillis + TEST_TONE_TIME)) {
+        timerMillis = getClockMillis();
         toneFlg     = false;
         toneOff(TONE_PIN, TEST_TONE_CHNL);
         delay(5);               // Allow a bit of time for tone channel to shutdown.
@@ -354,8 +372,12 @@ void updateTestTones(bool resetTimerFlg)
                 state++;
                 sprintf(rdsBuff, "%s  [ %02u:%02u:%02u ]", AUDIO_TEST_STR, hours, minutes, seconds);
                 String tmpStr = rdsBuff;
-                radio.sendStationName(AUDIO_PSN_STR);
-                radio.sendRadioText(tmpStr);
+                radioLock(); // RDS Task is sending these groups.
+                if (radio.setRadioText(tmpStr)) {
+                    resetRdsScheduler(); // Show new time immediately.
+                }
+                radio.setStationName(AUDIO_PSN_STR);
+                radioUnlock();
                 updateUiRdsText(tmpStr);
                 updateUiRDSTmr(0);     // Clear Displayed Elapsed Timer.
                 Log.verboseln("New Test Tone Sequence, RadioText Sent.");
@@ -24,6 +24,22 @@
 #include "globals.h"
 #include "language.h"
 
+// *************************************************************************************************************************
+
+static uint8_t  mqttPubCnt      = 0; // Messages in the Publish Queue.
+static uint32_t mqttPubDropCnt  = 0; // Messages dropped, queue full or publish failed.
+static uint32_t mqttPubMergeCnt = 0; // Messages replaced by a newer message for the same topic.
+
+// *************************************************************************************************************************
+// getMqttPubStats(): Return the MQTT Publish Queue depth and its drop and coalesce counts.
+uint8_t getMqttPubStats(uint32_t *dropCnt, uint32_t *mergeCnt)
+{
+    *dropCnt  = mqttPubDropCnt;
+    *mergeCnt = mqttPubMergeCnt;
+
+    return mqttPubCnt;
+}
+
 // *************************************************************************************************************************
 #ifdef MQTT_ENB // This file is excluded if MQTT not defined in config.h
 
@@ -37,56 +53,220 @@ WiFiClient wifiClient;
 PubSubClient mqttClient(wifiClient);
 
 
+// MQTT Publish Queue: Messages wait here until processMQTT() publishes them, so a slow or offline broker never stalls
+// the code that sends them. A status message (coalesceFlg) replaces a queued status message for the same topic (latest
+// value wins); Command replies are always queued, several commands may share a reply topic (e.g. the GPIO pins).
+// When the queue is full the oldest message is dropped. Only used by the loop() task.
+typedef struct {
+    char topicStr[MQTT_NAME_TOPIC_SZ];
+    char payloadStr[MQTT_PUB_PAYLD_SZ];
+    bool retainFlg;                                             // Broker keeps the message for new subscribers.
+    bool coalesceFlg;                                           // A newer status message for the topic replaces it.
+} mqttPub_t;
+
+static_assert(MQTT_PUB_PAYLD_SZ >= CMD_REPLY_MAX_SZ, "MQTT_PUB_PAYLD_SZ must hold a command reply.");
+
+static mqttPub_t mqttPubQueue[MQTT_PUB_QUEUE_CNT];
+static uint8_t   mqttPubHead = 0;                               // Oldest message.
+
+// MQTT State: A compact document with the radio state that integrators would otherwise poll with the info command.
+// The full document (keyframe) is published to "<name>/state" with the retained flag, so new subscribers get it at once.
+// A change is published at once to "<name>/state/delta", which lists every field that differs from the last keyframe.
+// The next keyframe follows when the state has been unchanged for MQTT_STATE_SETTLE_TIME, after a (re)connect, and at
+// least every MQTT_STATE_KEY_TIME. Built from the same values the Web UI's homeTab shows.
+typedef struct {
+    uint16_t freqX10;
+    bool     carrierFlg;
+    bool     muteFlg;
+    uint8_t  controller;                                        // On-air RadioText Controller (SERIAL_CNTRL, etc).
+    char     textStr[RDS_TEXT_MAX_SZ + 1];                      // RadioText, or the status message shown instead.
+} mqttSnap_t;
+
+static const uint8_t MQTT_SNAP_FREQ    = 0x01;                  // mqttSnap_t field bits, see mqttStateJson().
+static const uint8_t MQTT_SNAP_CARRIER = 0x02;
+static const uint8_t MQTT_SNAP_MUTE    = 0x04;
+static const uint8_t MQTT_SNAP_CNTRL   = 0x08;
+static const uint8_t MQTT_SNAP_TEXT    = 0x10;
+static const uint8_t MQTT_SNAP_ALL     = 0x1F;
+
+static const char *mqttCntrlNames[] = { "none", "serial", "mqtt", "http", "local", "udp" }; // By Controller ID.
+
+static_assert(MQTT_PUB_PAYLD_SZ >= 100 + RDS_TEXT_MAX_SZ * 2, "MQTT_PUB_PAYLD_SZ must hold an MQTT State keyframe.");
+
+static mqttSnap_t mqttKeySnap;                                  // State sent in the last keyframe.
+static mqttSnap_t mqttLastSnap;                                 // State at the last check.
+static uint32_t   mqttKeySeq = 0;                               // Keyframe number, deltas refer to it.
+static bool       mqttKeyFlg = true;                            // Send a keyframe on the next check.
+static unsigned long mqttKeyMillis    = 0;                      // Time of the last keyframe.
+static unsigned long mqttChangeMillis = 0;                      // Time of the last change.
+
+// MQTT Topic Routing Table: Built once from the command registry. Each MQTT command is found by the hash of its name
+// (the topic suffix after "<name>/cmd/"), so a message costs one hash and one name compare.
+// The topics that include the MQTT Device Name are built by mqttUpdateTopics() whenever mqttNameStr changes.
+typedef struct {
+    uint32_t          hash;                                     // Hash of the command name, zero if the slot is unused.
+    const cmdEntry_t *cmd;
+    uint8_t           replyIdx;                                 // Index in mqttReplyTopics[], 0xFF if no reply.
+} mqttRoute_t;
+
+typedef struct {
+    const char *suffixStr;                                      // Reply topic suffix (MQTT_INFORM_STR, etc), NULL if unused.
+    char        topicStr[MQTT_NAME_TOPIC_SZ];                   // Full reply topic.
+} mqttReplyTopic_t;
+
+static mqttRoute_t      mqttRoutes[MQTT_ROUTE_SLOTS];
+static mqttReplyTopic_t mqttReplyTopics[MQTT_REPLY_TOPIC_CNT];
+static bool             mqttRoutesFlg = false;                  // Routing Table has been built.
+static char    mqttTopicName[MQTT_NAME_MAX_SZ + 1] = "";        // Device Name used by the topics below.
+static char    mqttCmdPrefix[MQTT_NAME_TOPIC_SZ];               // Command topic prefix, "<name>/cmd/".
+static uint8_t mqttCmdPrefixLen = 0;
+static char    mqttConnectTopic[MQTT_NAME_TOPIC_SZ];
+static char    mqttDeltaTopic[MQTT_NAME_TOPIC_SZ];
+static char    mqttStateTopic[MQTT_NAME_TOPIC_SZ];
+static char    mqttSubTopic[MQTT_NAME_TOPIC_SZ];
+static char    mqttVoltsTopic[MQTT_NAME_TOPIC_SZ];
+
+// MQTT Connection State Machine, see mqttReconnect(). The connection attempts run in the MQTT Connect Task.
+static const uint8_t MQTT_ST_IDLE         = 0; // Not connected, waiting for the next attempt.
+static const uint8_t MQTT_ST_CONNECTING   = 1; // Connect Task is busy, it owns mqttClient.
+static const uint8_t MQTT_ST_CONNECT_OK   = 2; // Connect Task is done, connected.
+static const uint8_t MQTT_ST_CONNECT_FAIL = 3; // Connect Task is done, failed.
+static const uint8_t MQTT_ST_ONLINE       = 4; // Connected, loop() owns mqttClient.
+
+static TaskHandle_t     mqttTaskHandle  = NULL;
+static volatile uint8_t mqttState       = MQTT_ST_IDLE;
+static volatile bool    mqttSubFailFlg  = false;       // Subscribe failed on the last connect.
+static bool             mqttBootFlg     = true;        // No connection yet since boot.
+static uint8_t          mqttRetryCount  = 0;           // Failed connection attempts in a row.
+static uint32_t         mqttRetryDelay  = 0;           // Wait before the next attempt, in mS.
+static unsigned long    mqttRetryMillis = 0;           // Start of the wait.
+static char mqttConnectPayload[40];                    // Connect status, published by the Connect Task.
+static char mqttUserBuff[MQTT_USER_MAX_SZ + 1];        // Broker credentials, copied for the Connect Task.
+static char mqttPwBuff[MQTT_PW_MAX_SZ + 1];
+static char mqttTaskName[MQTT_NAME_MAX_SZ + 1];        // Topics, copied for the Connect Task. processMQTT() may
+static char mqttTaskConnectTopic[MQTT_NAME_TOPIC_SZ];  // rebuild mqttTopicName, etc. while it is connecting.
+static char mqttTaskSubTopic[MQTT_NAME_TOPIC_SZ];
+
 // *************************************************************************************************************************
-// gpioMqttControl(): MQTT handler for GPIO Commands. This is a companion to mqttCallback().
-void gpioMqttControl(String payloadStr, uint8_t pin)
+// mqttHash(): FNV-1a hash of a command name, any case. The name ends at a null or space. Never zero.
+static uint32_t mqttHash(const char *nameStr)
 {
-    bool   successFlg = true;
-    char   charBuff[60];
-    String topicStr;
+    uint32_t hash = 2166136261UL;
 
-    topicStr = mqttNameStr + MQTT_GPIO_STR;
+    for (; *nameStr && (*nameStr != ' '); nameStr++) {
+        hash = (hash ^ (uint8_t)tolower(*nameStr)) * 16777619UL;
+    }
+    return hash ? hash : 1;
+}
 
-    sprintf(charBuff, "-> MQTT Controller: Received GPIO Pin-%d Command", pin);
-    Log.infoln(charBuff);
+// *************************************************************************************************************************
+// mqttBuildRoutes(): Fill the Routing Table with the commands the MQTT Controller may use. Open addressing, linear probe.
+static void mqttBuildRoutes(void)
+{
+    uint8_t     slot;
+    uint8_t     replyIdx;
+    const cmdEntry_t *cmd;
 
-    successFlg = gpioCmd(payloadStr, MQTT_CNTRL, pin);
+    memset(mqttRoutes, 0, sizeof(mqttRoutes));
 
-    if (!successFlg) {
-        sprintf(charBuff, "{\"%s%d\": \"fail\"}", CMD_GPIO_STR, pin);
-    }
-    else if (payloadStr == CMD_GPIO_READ_STR) {
-        sprintf(charBuff, "{\"%s%d\": \"%d\"}", CMD_GPIO_STR, pin, digitalRead(pin));
+    for (uint8_t i = 0; (cmd = getCommand(i)) != NULL; i++) {
+        if (!(cmd->cntrlMask & (1 << MQTT_CNTRL))) {
+            continue;
+        }
+        replyIdx = 0xFF;
+
+        if (cmd->mqttTopicStr != NULL) {
+            for (replyIdx = 0; replyIdx < MQTT_REPLY_TOPIC_CNT; replyIdx++) {
+                if ((mqttReplyTopics[replyIdx].suffixStr == NULL) || !strcmp(mqttReplyTopics[replyIdx].suffixStr, cmd->mqttTopicStr)) {
+                    mqttReplyTopics[replyIdx].suffixStr = cmd->mqttTopicStr;
+                    break;
+                }
+            }
+
+            if (replyIdx >= MQTT_REPLY_TOPIC_CNT) {
+                Log.errorln("-> mqttBuildRoutes: Too Many Reply Topics, Increase MQTT_REPLY_TOPIC_CNT.");
+                replyIdx = 0xFF;
+            }
+        }
+
+        slot = mqttHash(cmd->nameStr) & (MQTT_ROUTE_SLOTS - 1);
+
+        for (uint8_t probe = 0; mqttRoutes[slot].hash != 0; probe++) {
+            if (probe >= MQTT_ROUTE_SLOTS) {
+                Log.errorln("-> mqttBuildRoutes: Routing Table Full, Increase MQTT_ROUTE_SLOTS.");
+                return;
+            }
+            slot = (slot + 1) & (MQTT_ROUTE_SLOTS - 1);
+        }
+        mqttRoutes[slot].hash     = mqttHash(cmd->nameStr);
+        mqttRoutes[slot].cmd      = cmd;
+        mqttRoutes[slot].replyIdx = replyIdx;
     }
-    else {
-        sprintf(charBuff, "{\"%s%d\": \"ok\"}", CMD_GPIO_STR, pin);
+    mqttRoutesFlg = true;
+}
+
+// *************************************************************************************************************************
+// mqttFindRoute(): Look up the command topic suffix in the Routing Table. Returns NULL if it is not an MQTT command.
+static const mqttRoute_t *mqttFindRoute(const char *nameStr)
+{
+    uint32_t hash = mqttHash(nameStr);
+    uint8_t  slot = hash & (MQTT_ROUTE_SLOTS - 1);
+    size_t   len;
+
+    for (uint8_t probe = 0; (probe < MQTT_ROUTE_SLOTS) && (mqttRoutes[slot].hash != 0); probe++) {
+        if (mqttRoutes[slot].hash == hash) {
+            len = strlen(mqttRoutes[slot].cmd->nameStr);
+
+            if ((strncasecmp(nameStr, mqttRoutes[slot].cmd->nameStr, len) == 0) &&
+                ((nameStr[len] == '\0') || (nameStr[len] == ' '))) {
+                return &mqttRoutes[slot];
+            }
+        }
+        slot = (slot + 1) & (MQTT_ROUTE_SLOTS - 1);
     }
-    mqttClient.publish(topicStr.c_str(), charBuff);
+    return NULL;
 }
 
-// ************************************************************************************************
-// makeMqttCmdStr(): Return the MQTT command string. On entry cmdStr has command keyword.
-//                   This is a companion to mqttCallback().
-String makeMqttCmdStr(String cmdStr) {
-    cmdStr = String(MQTT_CMD_STR) + cmdStr;
+// *************************************************************************************************************************
+// mqttUpdateTopics(): Rebuild the topics that include the MQTT Device Name if mqttNameStr has changed. Cheap when
+// unchanged, called on each processMQTT() pass. Builds the Routing Table on first use.
+void mqttUpdateTopics(void)
+{
+    const char *nameStr = mqttNameStr.c_str();
+
+    if (!mqttRoutesFlg) {
+        mqttBuildRoutes();
+    }
+    else if (strcmp(mqttTopicName, nameStr) == 0) {
+        return;
+    }
+    snprintf(mqttTopicName, sizeof(mqttTopicName), "%s", nameStr);
+    mqttCmdPrefixLen = snprintf(mqttCmdPrefix, sizeof(mqttCmdPrefix), "%s%s", mqttTopicName, MQTT_CMD_STR);
+    snprintf(mqttConnectTopic, sizeof(mqttConnectTopic), "%s%s", mqttTopicName, MQTT_CONNECT_STR);
+    snprintf(mqttSubTopic,     sizeof(mqttSubTopic),     "%s%s", mqttTopicName, MQTT_CMD_SUB_STR);
+    snprintf(mqttVoltsTopic,   sizeof(mqttVoltsTopic),   "%s%s", mqttTopicName, MQTT_VOLTS_STR);
+    snprintf(mqttStateTopic,   sizeof(mqttStateTopic),   "%s%s", mqttTopicName, MQTT_STATE_STR);
+    snprintf(mqttDeltaTopic,   sizeof(mqttDeltaTopic),   "%s%s", mqttTopicName, MQTT_DELTA_STR);
+    mqttKeyFlg = true; // New State topic needs its keyframe.
 
-    return cmdStr;
+    for (uint8_t i = 0; i < MQTT_REPLY_TOPIC_CNT && mqttReplyTopics[i].suffixStr != NULL; i++) {
+        snprintf(mqttReplyTopics[i].topicStr, sizeof(mqttReplyTopics[i].topicStr), "%s%s", mqttTopicName, mqttReplyTopics[i].suffixStr);
+    }
 }
 
 // *************************************************************************************************************************
 // mqttCallback(): Support function for MQTT message reception.
-// mqttCallback is limited to 255 byte packets (topic size + payload size). If larger, topic is corrupted and
+// mqttCallback is limited to MQTT_BUFF_SZ byte packets (topic size + payload size). If larger, topic is corrupted and
 // mqttCallback will not be processed. This is a limitation of the PubSubClient library.
+// The topic is matched in place with the Routing Table; Only the command payload is copied to a String.
 static void mqttCallback(const char *topic, byte *payload, unsigned int length)
 {
     char   cBuff[length + 2];                    // Allocate Character buffer.
-    char   logBuff[length + strlen(topic) + 60]; // Allocate a big buffer space.
-    char   mqttBuff[140 + sizeof(VERSION_STR) + STA_NAME_MAX_SZ];
-    String payloadStr;
-    String topicStr;
-
-    payloadStr.reserve(MQTT_PAYLD_MAX_SZ + 1);
-    topicStr.reserve(MQTT_TOPIC_MAX_SZ + 1);
+    char   logBuff[MQTT_TOPIC_MAX_SZ + 60];
+    char   mqttBuff[CMD_REPLY_MAX_SZ];
+    char  *payloadPtr = cBuff;
+    uint32_t rxMicros = micros();                // Command Latency Trace start.
+    const mqttRoute_t *route = NULL;
 
     if (length > MQTT_PAYLD_MAX_SZ) {
         Log.warningln("MQTT Message Length (%u bytes) too long! Truncated to %u bytes.", length, MQTT_PAYLD_MAX_SZ);
@@ -95,169 +275,148 @@ static void mqttCallback(const char *topic, byte *payload, unsigned int length)
 
     // Log.verboseln("MQTT Message Length: %u", length);
 
-    // Copy payload to local char array.
-    for (unsigned int i = 0; i < length; i++) {
-        cBuff[i] = ((char)payload[i]);
+    // Copy payload to local char array, remove leading/trailing spaces. Do NOT change to lowercase!
+    memcpy(cBuff, payload, length);
+
+    while ((length > 0) && isspace(cBuff[length - 1])) {
+        length--;
     }
     cBuff[length] = 0;
 
-    payloadStr = cBuff;
-    payloadStr.trim();      // Remove leading/trailing spaces. Do NOT change to lowercase!
+    while (isspace(*payloadPtr)) {
+        payloadPtr++;
+    }
 
-    topicStr = topic;
-    topicStr.trim();        // Remove leading/trailing spaces.
-    topicStr.toLowerCase(); // Force lowercase, prevent case matching problems.
+    while (*topic == ' ') {                      // Remove leading spaces, trailing spaces are ignored by mqttFindRoute().
+        topic++;
+    }
 
-    if (topicStr.length() > MQTT_TOPIC_MAX_SZ) {
-        topicStr = topicStr.substring(0, MQTT_TOPIC_MAX_SZ);
+    // *************************************************************************************************************************
+    // START OF MQTT COMMAND ACTIONS:
+
+    if (strncasecmp(topic, mqttCmdPrefix, mqttCmdPrefixLen) == 0) {
+        route = mqttFindRoute(topic + mqttCmdPrefixLen);
     }
 
-    // char buff[topicStr.length() + payloadStr.length() + 30];
-    // sprintf(buff, "MQTT Message Arrived, [Topic]: %s", topicStr.c_str());
-    // Log.infoln(buff);
-    // sprintf(buff, "MQTT Message Arrived, Payload: %s", payloadStr.c_str());
-    // Log.infoln(buff);
+    if (route != NULL) {
+        sprintf(logBuff, "MQTT: Received %s Command", route->cmd->logStr);
+        Log.infoln(logBuff);
+        dispatchCommand(route->cmd, payloadPtr, MQTT_CNTRL, mqttBuff, rxMicros);
 
+        if (route->replyIdx != 0xFF) { // Command has a reply.
+            mqttPublish(mqttReplyTopics[route->replyIdx].topicStr, mqttBuff, false, false);
+        }
+    }
+    else {
+        snprintf(logBuff, sizeof(logBuff), "MQTT: Received Unknown Command (%.*s), Ignored.", MQTT_TOPIC_MAX_SZ, topic);
+        Log.errorln(logBuff);
+    }
+}
 
-    // *************************************************************************************************************************
-    // START OF MQTT COMMAND ACTIONS:
+// *************************************************************************************************************************
+// mqttConnectTask(): MQTT Connect Task. Connects to the broker, publishes the connect status and subscribes, then reports
+// the result in mqttState. The broker connection can take many seconds (TCP connect and CONNACK time-outs), so it is
+// done here instead of in loop(). mqttClient is owned by this task while mqttState is MQTT_ST_CONNECTING.
+static void mqttConnectTask(void *param)
+{
+    while (true) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
 
-    if (topicStr == mqttNameStr + makeMqttCmdStr(CMD_AUDMODE_STR)) {
-        Log.infoln("MQTT: Received Audio Mode Command");
-        audioModeCmd(payloadStr, MQTT_CNTRL);
-    }
-    else if (topicStr == mqttNameStr + makeMqttCmdStr(CMD_FREQ_STR)) {
-        Log.infoln("MQTT: Received Radio Frequency Command");
-        frequencyCmd(payloadStr, MQTT_CNTRL);
-    }
-    else if (topicStr == mqttNameStr + makeMqttCmdStr(CMD_GPIO19_STR)) {
-        Log.infoln("MQTT: Received GPIO19 Command");
-        gpioMqttControl(payloadStr, GPIO19_PIN);
-    }
-    else if (topicStr == mqttNameStr + makeMqttCmdStr(CMD_GPIO23_STR)) {
-        Log.infoln("MQTT: Received GPIO23 Command");
-        gpioMqttControl(payloadStr, GPIO23_PIN);
-    }
-    else if (topicStr == mqttNameStr + makeMqttCmdStr(CMD_GPIO33_STR)) {
-        Log.infoln("MQTT: Received GPIO33 Command");
-        gpioMqttControl(payloadStr, GPIO33_PIN);
-    }
-    else if (topicStr == mqttNameStr + makeMqttCmdStr(CMD_INFO_STR)) {
-        Log.infoln("MQTT: Received System Information Command.");
-
-        if (infoCmd(payloadStr, MQTT_CNTRL)) {
-            sprintf(mqttBuff,
-                    "{\"%s\": \"ok\", \"version\": \"%s\", \"hostName\": \"%s\", \"ip\": \"%s\", \"rssi\": %d, \"status\": \"0x%02X\"}",
-                    CMD_INFO_STR,
-                    VERSION_STR,
-                    staNameStr.c_str(),
-                    WiFi.localIP().toString().c_str(),
-                    WiFi.RSSI(),
-                    getControllerStatus());
+        if (mqttClient.connect(mqttTaskName, mqttUserBuff, mqttPwBuff)) {
+            mqttClient.publish(mqttTaskConnectTopic, mqttConnectPayload); // Publish connect status.
+            mqttSubFailFlg = !mqttClient.subscribe(mqttTaskSubTopic);
+            mqttState      = MQTT_ST_CONNECT_OK;
         }
         else {
-            sprintf(mqttBuff, "{\"%s\": \"fail\"}", CMD_INFO_STR);
+            mqttState = MQTT_ST_CONNECT_FAIL;
         }
-        topicStr = mqttNameStr + MQTT_INFORM_STR;
-        mqttClient.publish(topicStr.c_str(), mqttBuff);
-    }
-    else if (topicStr == mqttNameStr + makeMqttCmdStr(CMD_MUTE_STR)) {
-        Log.infoln("MQTT: Received Audio Mute Command");
-        muteCmd(payloadStr, MQTT_CNTRL);
-    }
-    else if (topicStr == mqttNameStr + makeMqttCmdStr(CMD_PICODE_STR)) {
-        Log.infoln("MQTT Received RDS PI Code Command");
-        piCodeCmd(payloadStr, MQTT_CNTRL);
-    }
-    else if (topicStr == mqttNameStr + makeMqttCmdStr(CMD_PTYCODE_STR)) {
-        Log.infoln("MQTT Received RDS PTY Code Command");
-        ptyCodeCmd(payloadStr, MQTT_CNTRL);
-    }
-    else if (topicStr == mqttNameStr + makeMqttCmdStr(CMD_PSN_STR)) {
-        Log.infoln("MQTT: Received RDS Program Station Name Command");
-        programServiceNameCmd(payloadStr, MQTT_CNTRL);
-    }
-    else if (topicStr == mqttNameStr + makeMqttCmdStr(CMD_RADIOTEXT_STR)) {
-        Log.infoln("MQTT: Received RadioText Command");
-        radioTextCmd(payloadStr, MQTT_CNTRL);
     }
-    else if (topicStr == mqttNameStr + makeMqttCmdStr(CMD_RF_CARRIER_STR)) {
-        Log.infoln("MQTT: Received RF Carrier Control Command");
-        radioTextCmd(payloadStr, MQTT_CNTRL);
-    }
-    else if (topicStr == mqttNameStr + makeMqttCmdStr(CMD_REBOOT_STR)) {
-        Log.infoln("MQTT: Received System Reboot Command.");
-        rebootCmd(payloadStr, MQTT_CNTRL);
-    }
-    else if (topicStr == mqttNameStr + makeMqttCmdStr(CMD_START_STR)) {
-        Log.infoln("MQTT: Received RDS Restart Command.");
-        startCmd(payloadStr, MQTT_CNTRL);
+}
+
+// *************************************************************************************************************************
+// mqttScheduleRetry(): Set the time of the next connection attempt. The wait doubles with each failure, up to
+// MQTT_BACKOFF_MAX, and a random half of it is dropped (jitter) so devices that lost the broker together do not all
+// retry at the same moment.
+static void mqttScheduleRetry(void)
+{
+    uint8_t  shift   = (mqttRetryCount < MQTT_BACKOFF_STEPS) ? mqttRetryCount : MQTT_BACKOFF_STEPS;
+    uint32_t delayMs = MQTT_BACKOFF_MIN << shift;
+
+    if (delayMs > MQTT_BACKOFF_MAX) {
+        delayMs = MQTT_BACKOFF_MAX;
     }
-    else if (topicStr == mqttNameStr + makeMqttCmdStr(CMD_STOP_STR)) {
-        Log.infoln("MQTT: Received RDS Stop Command.");
-        stopCmd(payloadStr, MQTT_CNTRL);
+    mqttRetryDelay  = delayMs / 2 + esp_random() % (delayMs / 2 + 1);
+    mqttRetryMillis = millis();
+
+    if (mqttRetryCount < 0xFF) {
+        mqttRetryCount++;
     }
-    else if (topicStr == mqttNameStr + makeMqttCmdStr(CMD_PERIOD_STR)) {
-        Log.infoln("MQTT: Received RDS Display Time Command");
-        rdsTimePeriodCmd(payloadStr, MQTT_CNTRL);
+}
+
+// *************************************************************************************************************************
+// mqttStartConnect(): Hand a connection attempt to the MQTT Connect Task. The settings and topics are copied so the task
+// does not read the Strings that the Web UI may change, or the topics that processMQTT() rebuilds.
+static void mqttStartConnect(void)
+{
+    char logBuff[120];
+
+    mqttUpdateTopics();
+    snprintf(mqttTaskName,         sizeof(mqttTaskName),         "%s", mqttTopicName);
+    snprintf(mqttTaskConnectTopic, sizeof(mqttTaskConnectTopic), "%s", mqttConnectTopic);
+    snprintf(mqttTaskSubTopic,     sizeof(mqttTaskSubTopic),     "%s", mqttSubTopic);
+    snprintf(mqttUserBuff, sizeof(mqttUserBuff), "%s", mqttUserStr.c_str());
+    snprintf(mqttPwBuff,   sizeof(mqttPwBuff),   "%s", mqttPwStr.c_str());
+
+    if (mqttBootFlg) {
+        sprintf(mqttConnectPayload, "{\"boot\": 0}");                             // JSON Formatted payload.
     }
     else {
-        sprintf(logBuff, "MQTT: Received Unknown Command (%s), Ignored.", topicStr.c_str());
-        Log.errorln(logBuff);
-    }
+        sprintf(mqttConnectPayload, "{\"reconnect\": %u}", mqttRetryCount + 1);   // JSON Formatted payload.
+    }
+
+    sprintf(logBuff, "Attempting MQTT Connection #%u ...", mqttRetryCount + 1);
+    Log.infoln(logBuff);
+    sprintf(logBuff, "-> Broker Name: \"%s\"", mqttTaskName);
+    Log.verboseln(logBuff);
+    sprintf(logBuff, "-> Broker User: \"%s\", Password: \"%s\"", mqttUserBuff, mqttPwBuff);
+    Log.verboseln(logBuff);
+    sprintf(logBuff, "-> Broker IP: %s, PORT: %u", IpAddressToString(mqttIP).c_str(), mqttPort);
+    Log.verboseln(logBuff);
+
+    mqttClient.setServer(mqttIP, mqttPort);
+    mqttClient.setCallback(mqttCallback); // Topic Subscription callback handler.
+    mqttClient.setKeepAlive(MQTT_KEEP_ALIVE);
+    mqttClient.setBufferSize(MQTT_BUFF_SZ); // Room for batch commands.
+
+    updateUiMqttMsg(MQTT_RETRY_STR);
+    mqttState = MQTT_ST_CONNECTING;
+    xTaskNotifyGive(mqttTaskHandle);
 }
 
 // *************************************************************************************************************************
-// mqttInit(): Initialize MQTT and subscribe with broker.
+// mqttInit(): Initialize MQTT and start the MQTT Connect Task. The first connection attempt is started at once, it
+//             completes in the background (see mqttReconnect()).
 //             MQTT is disabled when in HotSpot mode.
 //
 void mqttInit(void) {
-    String payloadStr;
-    String topicStr;
+    mqttUpdateTopics();
 
-    char logBuff[120];
+    if ((mqttTaskHandle == NULL) &&
+        (xTaskCreatePinnedToCore(mqttConnectTask, "MQTT", MQTT_TASK_STACK_SZ, NULL, MQTT_TASK_PRIORITY, &mqttTaskHandle, MQTT_TASK_CORE) != pdPASS)) {
+        mqttTaskHandle = NULL;
+        Log.errorln("-> mqttInit: Can't Start MQTT Connect Task.");
+        return;
+    }
 
     if (!ctrlMqttFlg) { // MQTT Controller Disabled.
         mqttOnlineFlg = false;
         return;
     }
 
-    topicStr.reserve(MQTT_NAME_MAX_SZ + 20);
-
     if (WiFi.status() == WL_CONNECTED) {
         Log.traceln("Initializing MQTT");
-        mqttClient.setServer(mqttIP, mqttPort);
-        mqttClient.setCallback(mqttCallback); // Topic Subscription callback handler.
-        mqttClient.setKeepAlive(MQTT_KEEP_ALIVE);
-
-        if (mqttClient.connect(mqttNameStr.c_str(), mqttUserStr.c_str(), mqttPwStr.c_str())) {
-            mqttOnlineFlg = true;
-            topicStr      = mqttNameStr;
-            topicStr     += MQTT_CONNECT_STR;
-            payloadStr    = "{\"boot\": 0}";                          // JSON Formatted payload.
-            mqttClient.publish(topicStr.c_str(), payloadStr.c_str()); // Publish reconnect status.
-
-            sprintf(logBuff, "-> MQTT Started. Sent Topic: %s, Payload: %s", topicStr.c_str(), payloadStr.c_str());
-            Log.infoln(logBuff);
-
-            updateUiMqttMsg(MQTT_ONLINE_STR);
-
-            topicStr  = mqttNameStr;
-            topicStr += MQTT_CMD_SUB_STR;
-
-            if (mqttClient.subscribe(topicStr.c_str())) {
-                sprintf(logBuff, "-> MQTT Successfully Subscribed to \"%s\"", topicStr.c_str());
-                Log.infoln(logBuff);
-            }
-            else {
-                Log.errorln("-> MQTT subscribe failed!");
-                updateUiMqttMsg(MQTT_SUBCR_FAIL_STR);
-            }
-        }
-        else {
-            Log.errorln("-> MQTT NOT Started.");
-            mqttOnlineFlg = false;
-        }
+        mqttRetryCount = 0;
+        mqttStartConnect();
     }
     else {
         updateUiMqttMsg(MQTT_NOT_AVAIL_STR);
@@ -266,100 +425,255 @@ void mqttInit(void) {
 }
 
 // *************************************************************************************************************************
-// mqttReconnect(): If connection to broker has been lost then attempt reconnection.
+// mqttReconnect(): MQTT connection state machine, call it from the main loop. Never blocks; The connection attempts are
+//                  made by the MQTT Connect Task. If the connection to the broker is lost then reconnect, with
+//                  exponential backoff between failed attempts.
 //                  On entry, if resetFlg arg is true then reset timer and failcount.
 void mqttReconnect(bool resetFlg)
 {
     char logBuff[120];
-    static uint8_t  mqttRetryCount = 0;                 // MQTT Connection Retry Counter, allow several attempts.
-    static unsigned long previousWiFiMillis = millis(); // Timer for WiFi services.
-    char   payloadBuff[40];
-    String topicStr;
 
     if (resetFlg == true) {
-        mqttRetryCount     = 0;
-        previousWiFiMillis = millis() - MQTT_RECONNECT_TIME + 2000; // Allow Reconnect in 2 secs.
+        mqttRetryCount  = 0;
+        mqttRetryDelay  = MQTT_BACKOFF_MIN; // Allow Reconnect in 2 secs.
+        mqttRetryMillis = millis();
         Log.traceln("MQTT Reconnect Fail Count has Been Reset.");
         return;
     }
 
-    if (!ctrlMqttFlg) { // MQTT Controller Disabled.
-        mqttOnlineFlg = false;
+    switch (mqttState) {
+        case MQTT_ST_CONNECTING:
+            return; // Connect Task is busy, check back later.
 
-        if (mqttClient.connected()) {
-            mqttClient.disconnect();
-            Log.traceln("MQTT Controller Disabled: Closed Connection.");
-        }
-        return;
-    }
-    else if (millis() - previousWiFiMillis >= MQTT_RECONNECT_TIME) {
-        previousWiFiMillis = millis();
-    }
-    else {
-        return;
-    }
-
-    topicStr.reserve(sizeof(mqttNameStr) + 20);
-
-    if ((WiFi.status() == WL_CONNECTED) && !mqttClient.connected()) {
-        if (!mqttClient.connected() && (mqttRetryCount++ < MQTT_RETRY_CNT)) {
-            updateUiMqttMsg(MQTT_RETRY_STR);
-            sprintf(logBuff, "Attempting MQTT Reconnection #%u ...", mqttRetryCount);
+        case MQTT_ST_CONNECT_OK:
+            sprintf(logBuff, "-> MQTT Connected. Sent Topic: %s, Payload: %s", mqttTaskConnectTopic, mqttConnectPayload);
             Log.infoln(logBuff);
-            mqttClient.setServer(mqttIP, mqttPort);
-            mqttClient.setCallback(mqttCallback); // Topic Subscription callback handler.
-            mqttClient.setKeepAlive(MQTT_KEEP_ALIVE);
-
-            sprintf(logBuff, "-> Broker Name: \"%s\"", mqttNameStr.c_str());
-            Log.verboseln(logBuff);
-            sprintf(logBuff, "-> Broker User: \"%s\", Password: \"%s\"", mqttUserStr.c_str(), mqttPwStr.c_str());
-            Log.verboseln(logBuff);
-            sprintf(logBuff, "-> Broker IP: %s, PORT: %u", IpAddressToString(mqttIP).c_str(), mqttPort);
-            Log.verboseln(logBuff);
-
-            if (mqttClient.connect(mqttNameStr.c_str(), mqttUserStr.c_str(), mqttPwStr.c_str())) { // Connect to MQTT Server
-                mqttOnlineFlg = true;
-                topicStr      = mqttNameStr + MQTT_CONNECT_STR;
-                sprintf(payloadBuff, "{\"reconnect\": %d}", mqttRetryCount);                       // JSON Formatted payload.
-                mqttClient.publish(topicStr.c_str(), payloadBuff);                                 // Publish reconnect status.
-
-                sprintf(logBuff, "-> MQTT Reconnected. Sent Topic:%s, Payload:%s", topicStr.c_str(), payloadBuff);
+            updateUiMqttMsg(MQTT_ONLINE_STR);
+
+            if (mqttSubFailFlg) {
+                Log.errorln("-> MQTT subscribe failed!");
+                updateUiMqttMsg(MQTT_SUBCR_FAIL_STR);
+            }
+            else {
+                sprintf(logBuff, "-> MQTT Successfully Subscribed to \"%s\"", mqttTaskSubTopic);
                 Log.infoln(logBuff);
+            }
+            mqttOnlineFlg  = true;
+            mqttKeyFlg     = true; // Refresh the retained MQTT State.
+            mqttBootFlg    = false;
+            mqttRetryCount = 0; // Successful connect, OK to reset counter.
+            mqttState      = MQTT_ST_ONLINE;
+            startTelemetryReplay();
+            break;
+
+        case MQTT_ST_CONNECT_FAIL:
+            mqttScheduleRetry();
+            sprintf(logBuff, "-> MQTT Connection Failure #%u, Code= %s. Next Attempt in %u Secs.",
+                    mqttRetryCount, returnClientCode(mqttClient.state()).c_str(), mqttRetryDelay / MSECS_PER_SEC);
+            Log.warningln(logBuff);
+            updateUiMqttMsg(MQTT_RETRY_FAIL_STR + String(mqttRetryCount));
+            mqttOnlineFlg = false;
+            mqttState     = MQTT_ST_IDLE;
+            break;
 
-                updateUiMqttMsg(MQTT_ONLINE_STR);
+        case MQTT_ST_ONLINE:
 
-                topicStr = mqttNameStr + MQTT_CMD_SUB_STR;
+            if (!ctrlMqttFlg) { // MQTT Controller Disabled.
+                mqttClient.disconnect();
+                Log.traceln("MQTT Controller Disabled: Closed Connection.");
+                mqttOnlineFlg = false;
+                mqttState     = MQTT_ST_IDLE;
+            }
+            else if (!mqttClient.connected()) {
+                sprintf(logBuff, "-> MQTT Connection Lost, Code= %s.", returnClientCode(mqttClient.state()).c_str());
+                Log.warningln(logBuff);
+                updateUiMqttMsg(MQTT_DISCONNECT_STR);
+                mqttOnlineFlg  = false;
+                mqttRetryCount = 0;
+                mqttScheduleRetry();
+                mqttState = MQTT_ST_IDLE;
+            }
+            break;
+
+        default: // MQTT_ST_IDLE
 
-                if (mqttClient.subscribe(topicStr.c_str())) {
-                    sprintf(logBuff, "-> MQTT Successfully Subscribed to %s.", topicStr.c_str());
-                    Log.infoln(logBuff);
+            if (!ctrlMqttFlg) { // MQTT Controller Disabled.
+                mqttOnlineFlg = false;
+            }
+            else if ((mqttTaskHandle != NULL) && (millis() - mqttRetryMillis >= mqttRetryDelay)) {
+                if (WiFi.status() == WL_CONNECTED) {
+                    mqttStartConnect();
                 }
                 else {
-                    Log.errorln("-> MQTT subscribe failed!");
-                    updateUiMqttMsg(MQTT_SUBCR_FAIL_STR);
+                    updateUiMqttMsg(MQTT_NOT_AVAIL_STR);
+                    Log.errorln("-> WiFi Router Not Connected; MQTT Disabled.");
+                    mqttScheduleRetry();
                 }
-                mqttRetryCount = 0; // Successful reconnect, OK to reset counter.
             }
-            else if (mqttRetryCount < MQTT_RETRY_CNT) {
-                sprintf(logBuff, "-> MQTT Connection Failure #%u, Code= %s.", mqttRetryCount, returnClientCode(mqttClient.state()).c_str());
-                Log.warningln(logBuff);
-                updateUiMqttMsg(MQTT_RETRY_FAIL_STR + String(mqttRetryCount));
+            break;
+    }
+}
+
+// *************************************************************************************************************************
+// mqttPublish(): Queue a message for the broker. Never blocks. coalesceFlg = true for status messages (volts, state):
+// A queued status message for the same topic is replaced. Returns false if a message had to be dropped (queue full, the
+// oldest message is dropped).
+bool mqttPublish(const char *topicStr, const char *payloadStr, bool retainFlg, bool coalesceFlg)
+{
+    bool       successFlg = true;
+    mqttPub_t *msg        = NULL;
+
+    for (uint8_t i = 0; coalesceFlg && (i < mqttPubCnt); i++) {
+        mqttPub_t *queued = &mqttPubQueue[(mqttPubHead + i) % MQTT_PUB_QUEUE_CNT];
+
+        if (queued->coalesceFlg && (strcmp(queued->topicStr, topicStr) == 0)) {
+            msg = queued;
+            mqttPubMergeCnt++;
+            break;
+        }
+    }
+
+    if (msg == NULL) {
+        if (mqttPubCnt >= MQTT_PUB_QUEUE_CNT) { // Full, drop the oldest.
+            mqttPubHead = (mqttPubHead + 1) % MQTT_PUB_QUEUE_CNT;
+            mqttPubCnt--;
+            mqttPubDropCnt++;
+            successFlg = false;
+        }
+        msg = &mqttPubQueue[(mqttPubHead + mqttPubCnt++) % MQTT_PUB_QUEUE_CNT];
+        snprintf(msg->topicStr, sizeof(msg->topicStr), "%s", topicStr);
+    }
+    snprintf(msg->payloadStr, sizeof(msg->payloadStr), "%s", payloadStr);
+    msg->retainFlg   = retainFlg;
+    msg->coalesceFlg = coalesceFlg;
+
+    return successFlg;
+}
+
+// *************************************************************************************************************************
+// mqttPublishQueue(): Publish up to MQTT_PUB_DRAIN_CNT queued messages. The messages wait while the broker is offline.
+static void mqttPublishQueue(void)
+{
+    mqttPub_t *msg;
+
+    for (uint8_t i = 0; (i < MQTT_PUB_DRAIN_CNT) && (mqttPubCnt > 0) && (mqttState == MQTT_ST_ONLINE); i++) {
+        msg = &mqttPubQueue[mqttPubHead];
+
+        if (!mqttClient.publish(msg->topicStr, msg->payloadStr, msg->retainFlg)) {
+            if (!mqttClient.connected()) {
+                return; // Keep it for the reconnect.
             }
-            else {
-                Log.errorln("-> MQTT Controller Has Been Disabled, Too Many Reconnect Attempts.");
-                updateUiMqttMsg(MQTT_DISABLED_STR);
+            mqttPubDropCnt++; // Broker connection is fine, message can't be sent (too big?).
+        }
+        mqttPubHead = (mqttPubHead + 1) % MQTT_PUB_QUEUE_CNT;
+        mqttPubCnt--;
+    }
+}
+
+// *************************************************************************************************************************
+// mqttSnapDiff(): Return the MQTT State fields (MQTT_SNAP_FREQ, etc) that differ between two snapshots.
+static uint8_t mqttSnapDiff(const mqttSnap_t *snap, const mqttSnap_t *oldSnap)
+{
+    uint8_t diffMask = 0;
+
+    diffMask |= (snap->freqX10 != oldSnap->freqX10) ? MQTT_SNAP_FREQ : 0;
+    diffMask |= (snap->carrierFlg != oldSnap->carrierFlg) ? MQTT_SNAP_CARRIER : 0;
+    diffMask |= (snap->muteFlg != oldSnap->muteFlg) ? MQTT_SNAP_MUTE : 0;
+    diffMask |= (snap->controller != oldSnap->controller) ? MQTT_SNAP_CNTRL : 0;
+    diffMask |= strcmp(snap->textStr, oldSnap->textStr) ? MQTT_SNAP_TEXT : 0;
+
+    return diffMask;
+}
+
+// *************************************************************************************************************************
+// mqttStateJson(): Write the MQTT State fields in fieldMask (MQTT_SNAP_FREQ, etc) as a JSON object. headStr is the first
+// member ("\"key\": 12"). The buffer must hold MQTT_PUB_PAYLD_SZ bytes.
+static void mqttStateJson(char *buff, const mqttSnap_t *snap, uint8_t fieldMask, const char *headStr)
+{
+    char *buffPtr = buff + sprintf(buff, "{%s", headStr);
+
+    if (fieldMask & MQTT_SNAP_FREQ) {
+        buffPtr += sprintf(buffPtr, ", \"freq\": %u", snap->freqX10);
+    }
+
+    if (fieldMask & MQTT_SNAP_CARRIER) {
+        buffPtr += sprintf(buffPtr, ", \"carrier\": \"%s\"", snap->carrierFlg ? "on" : "off");
+    }
+
+    if (fieldMask & MQTT_SNAP_MUTE) {
+        buffPtr += sprintf(buffPtr, ", \"mute\": \"%s\"", snap->muteFlg ? "on" : "off");
+    }
+
+    if (fieldMask & MQTT_SNAP_CNTRL) {
+        buffPtr += sprintf(buffPtr, ", \"cntrl\": \"%s\"", snap->controller < sizeof(mqttCntrlNames) / sizeof(mqttCntrlNames[0]) ?
+                           mqttCntrlNames[snap->controller] : mqttCntrlNames[NO_CNTRL]);
+    }
+
+    if (fieldMask & MQTT_SNAP_TEXT) {
+        buffPtr += sprintf(buffPtr, ", \"rtm\": \"");
+
+        for (const char *textPtr = snap->textStr; *textPtr; textPtr++) { // JSON escape the RadioText.
+            if ((*textPtr == '"') || (*textPtr == '\\')) {
+                *buffPtr++ = '\\';
             }
+            *buffPtr++ = ((uint8_t)*textPtr < ' ') ? ' ' : *textPtr;
         }
+        *buffPtr++ = '"';
     }
-    else if (WiFi.status() != WL_CONNECTED) {
-        updateUiMqttMsg(MQTT_NOT_AVAIL_STR);
-        Log.errorln("-> WiFi Router Not Connected; MQTT Disabled.");
+    strcpy(buffPtr, "}");
+}
+
+// *************************************************************************************************************************
+// mqttSendState(): Publish the MQTT State when it changes, see mqttSnap_t. Checked every MQTT_STATE_POLL_TIME.
+// Example keyframe: {"key": 12, "freq": 1011, "carrier": "on", "mute": "off", "cntrl": "local", "rtm": "Now Playing"}
+// Example delta:    {"base": 12, "rtm": "Jingle Bells"}
+static void mqttSendState(void)
+{
+    bool       deltaFlg;
+    char       headBuff[24];
+    char       payloadBuff[MQTT_PUB_PAYLD_SZ];
+    uint8_t    changeMask;
+    mqttSnap_t snap;
+    static unsigned long previousMillis = 0;
+
+    if (millis() - previousMillis < MQTT_STATE_POLL_TIME) {
+        return;
+    }
+    previousMillis = millis();
+
+    snap.freqX10    = fmFreqX10;
+    snap.carrierFlg = rfCarrierFlg;
+    snap.muteFlg    = muteFlg;
+    snap.controller = getUiActiveController();
+    snprintf(snap.textStr, sizeof(snap.textStr), "%s", getUiRdsText().c_str());
+
+    deltaFlg = mqttSnapDiff(&snap, &mqttLastSnap) != 0;
+
+    if (deltaFlg) {
+        mqttLastSnap     = snap;
+        mqttChangeMillis = millis();
+    }
+    changeMask = mqttSnapDiff(&snap, &mqttKeySnap);
+
+    if (mqttKeyFlg || (millis() - mqttKeyMillis >= MQTT_STATE_KEY_TIME) ||
+        (changeMask && (millis() - mqttChangeMillis >= MQTT_STATE_SETTLE_TIME))) {
+        mqttKeySnap   = snap;
+        mqttKeyFlg    = false;
+        mqttKeyMillis = millis();
+        sprintf(headBuff, "\"key\": %u", ++mqttKeySeq);
+        mqttStateJson(payloadBuff, &snap, MQTT_SNAP_ALL, headBuff);
+        mqttPublish(mqttStateTopic, payloadBuff, true, true);
+    }
+    else if (deltaFlg) { // An empty delta means the state is back to the keyframe.
+        sprintf(headBuff, "\"base\": %u", mqttKeySeq);
+        mqttStateJson(payloadBuff, &snap, changeMask, headBuff);
+        mqttPublish(mqttDeltaTopic, payloadBuff, false, true);
     }
 }
 
 // *************************************************************************************************************************
 // mqttSendMessages(): Broadcast system messages to MQTT broker.
-// The messages are sent periodically (MQTT_MSG_TIME) or immediately whenever they change.
+// The messages are sent periodically (MQTT_MSG_TIME) or immediately whenever they change. Also sends the MQTT State.
 void mqttSendMessages(void)
 {
     static bool refresh = true;
@@ -368,13 +682,12 @@ void mqttSendMessages(void)
     static unsigned long previousMqttMillis = millis(); // Timer for MQTT services.
     static float    oldVbatVolts       = -1.0f;
     static float    oldPaVolts         = -1.0f;
-    String topicStr;
 
     if (!ctrlMqttFlg) { // MQTT Controller Disabled.
         return;
     }
 
-    if (!mqttClient.connected()) { // MQTT not connected, nothing to do. Exit.
+    if (mqttState != MQTT_ST_ONLINE) { // MQTT not connected, nothing to do. Exit.
         return;
     }
 
@@ -388,16 +701,17 @@ void mqttSendMessages(void)
         ((paVolts > oldPaVolts + VOLTS_HYSTERESIS) || (paVolts < oldPaVolts - VOLTS_HYSTERESIS))) {
         oldVbatVolts = vbatVolts;
         oldPaVolts   = paVolts;
-        topicStr     = mqttNameStr + MQTT_VOLTS_STR;
         sprintf(payloadBuff, "{\"vbat\": %0.1f,\"pa\": %0.1f}", vbatVolts, paVolts); // JSON Formatted Payload.
-        mqttClient.publish(topicStr.c_str(), payloadBuff);                           // Publish Power Supply Voltage.
+        mqttPublish(mqttVoltsTopic, payloadBuff, false, true);                       // Publish Power Supply Voltage.
 
-        sprintf(logBuff, "MQTT Publish, [Topic]: %s", topicStr.c_str());
+        sprintf(logBuff, "MQTT Publish, [Topic]: %s", mqttVoltsTopic);
         Log.infoln(logBuff);
         sprintf(logBuff, "-> Payload: %s", payloadBuff);
         Log.infoln(logBuff);
     }
     refresh = false;
+
+    mqttSendState();
 }
 
 // *************************************************************************************************************************
@@ -406,7 +720,7 @@ void mqttSendMessages(void)
 void mqttService(void) {
     # ifdef MQTT_ENB
 
-    if (mqttClient.connected()) {
+    if (mqttState == MQTT_ST_ONLINE) {
         mqttClient.loop(); // Service MQTT background tasks.
     }
     # endif // ifdef MQTT_ENB
@@ -417,8 +731,10 @@ void mqttService(void) {
 //
 void processMQTT(void) {
     # ifdef MQTT_ENB
-    mqttService(); // Service MQTT background tasks.
+    mqttUpdateTopics(); // Follow MQTT Device Name changes.
+    mqttService();      // Service MQTT background tasks.
     mqttSendMessages();
+    mqttPublishQueue();
     # endif // ifdef MQTT_ENB
 }
 
@@ -25,6 +25,8 @@
 
 extern QN8027Radio radio;
 
+static SemaphoreHandle_t radioMutex = NULL; // Serializes QN8027 access between loop() and the RDS Task.
+
 // *********************************************************************************************
 // calibrateAntenna(): Calibrate the QN8027 Antenna Interface. On exit, true if Calibration OK.
 // This is an undocumented feature that was found during PixelRadio project development.
@@ -166,6 +168,10 @@ uint8_t initRadioChip(void) {
 
     Log.infoln("Initializing QN8027 FM Radio Chip ...");
 
+    if (radioMutex == NULL) {
+        radioMutex = xSemaphoreCreateRecursiveMutex();
+    }
+
     if (checkRadioIsPresent()) {
         Log.verboseln("-> QN8027 is Present");
     }
@@ -257,9 +263,11 @@ uint8_t initRadioChip(void) {
     // Log.infoln(logBuff);
 
     setPreEmphasis();
-    setVgaGain(); // Tx Input Buffer Gain.
+    radio.beginUpdate(); // All three settings share VGA_REG, write it once.
+    setVgaGain();        // Tx Input Buffer Gain.
     setDigitalGain();
     setAudioImpedance();
+    radio.flush();
     waitForIdle(10);
 
     // sprintf(logBuff,"Radio Audio Configuration Status: %02X", radio.getStatus());
@@ -346,13 +354,34 @@ uint8_t initRadioChip(void) {
 uint16_t measureAudioLevel(void) {
     uint16_t mV = 0;
 
+    radioLock();
     mV = radio.getStatus() >> 4;
     mV = mV * 45; // Audio Peak is 45mV per count.
     radio.clearAudioPeak();
+    radioUnlock();
 
     return mV;
 }
 
+// *********************************************************************************************
+// radioLock(): Take exclusive use of the QN8027 (I2C bus and QN8027Radio object). Recursive, every
+// radioLock() must be paired with radioUnlock(). No effect before initRadioChip().
+void radioLock(void)
+{
+    if (radioMutex != NULL) {
+        xSemaphoreTakeRecursive(radioMutex, portMAX_DELAY);
+    }
+}
+
+// *********************************************************************************************
+// radioUnlock(): Release the QN8027, see radioLock().
+void radioUnlock(void)
+{
+    if (radioMutex != NULL) {
+        xSemaphoreGiveRecursive(radioMutex);
+    }
+}
+
 // *********************************************************************************************
 // setVgaGain(): Set the Tx Input Buffer Gain (Analog Gain) on the QN8027 chip.
 void setVgaGain(void)
@@ -387,9 +416,7 @@ void setVgaGain(void)
         gainVal    = 0x03;
     }
 
-    delay(5);
     radio.setTxInputBufferGain(gainVal);
-    delay(5);
 }
 
 // *********************************************************************************************
@@ -409,9 +436,7 @@ void setAudioMute(void)
         mute = OFF;
     }
 
-    delay(5);
     radio.mute(mute);
-    delay(5);
 }
 
 // *********************************************************************************************
@@ -442,9 +467,7 @@ void setAudioImpedance(void)
         impedVal    = 20;
     }
 
-    delay(5);
     radio.setAudioInpImp(impedVal);
-    delay(5);
 }
 
 // *********************************************************************************************
@@ -472,23 +495,25 @@ void setDigitalGain(void)
         gainVal        = 0;
     }
 
-    delay(5);
     radio.setTxDigitalGain(gainVal);
-    delay(5);
 }
 
 // *********************************************************************************************
-// setFrequency(): Set the Radio Frequency on the QN8027.
-void setFrequency(void)
+// writeFrequency(): Write the Radio Frequency to the QN8027 registers. Takes effect after an RF Carrier toggle.
+static void writeFrequency(void)
 {
-    float   freq;
-    uint8_t rfOn;
-
     // char logBuff[60];
     // sprintf(logBuff, "-> Radio Frequency Set to: %d.", fmFreqX10);
     // Log.verboseln(logBuff);
 
-    freq = (float(fmFreqX10)) / 10.0f;
+    radio.setFrequency((float(fmFreqX10)) / 10.0f);
+}
+
+// *********************************************************************************************
+// setFrequency(): Set the Radio Frequency on the QN8027.
+void setFrequency(void)
+{
+    uint8_t rfOn;
 
     if (rfCarrierFlg) {
         rfOn = ON;
@@ -500,7 +525,7 @@ void setFrequency(void)
     waitForIdle(5);
     radio.Switch(OFF); // Turn Off Carrier.
     waitForIdle(5);
-    radio.setFrequency(freq);
+    writeFrequency();
     waitForIdle(25);
     radio.Switch(rfOn); // Restore Carrier to user's state.
     waitForIdle(25);
@@ -523,18 +548,15 @@ void setMonoAudio(void)
         mono = ON;
     }
 
-    delay(5);
     radio.MonoAudio(mono);
-    delay(5);
 }
 
 // *********************************************************************************************
-// ssetPreEmphasis(): Set the QN8027 chip's pre-Emphasis.
+// writePreEmphasis(): Write the QN8027 chip's pre-Emphasis register. Takes effect after an RF Carrier toggle.
 // ON = 50uS (Eur/UK/Australia), OFF = 75uS (North America/Japan).
-void setPreEmphasis(void)
+static void writePreEmphasis(void)
 {
     uint8_t emphVal;
-    uint8_t rfOn;
 
     // char logBuff[60];
     // sprintf(logBuff, "-> Pre-Emphasis Set to: %s.", preEmphasisStr.c_str());
@@ -552,6 +574,15 @@ void setPreEmphasis(void)
         emphVal        = OFF;
     }
 
+    radio.setPreEmphTime50(emphVal);
+}
+
+// *********************************************************************************************
+// setPreEmphasis(): Set the QN8027 chip's pre-Emphasis.
+void setPreEmphasis(void)
+{
+    uint8_t rfOn;
+
     if (rfCarrierFlg) {
         rfOn = ON;
     }
@@ -562,32 +593,36 @@ void setPreEmphasis(void)
     delay(1);
     radio.Switch(OFF); // Turn Off Carrier.
     delay(1);
-    radio.setPreEmphTime50(emphVal);
+    writePreEmphasis();
     waitForIdle(10);
     radio.Switch(rfOn); // Restore Carrier to user's state.
     waitForIdle(25);
 }
 
 // *********************************************************************************************
-// setRfAutoOff():
+// writeRfAutoOff(): Write the QN8027 chip's RF Auto Off register. Takes effect after an RF Carrier toggle.
 // IMPORTANT: Sending RDS Messages and/or using updateUiAudioLevel() Will prevent 60S Turn Off.
 // rfAutoOff = true: Turn-off RF Carrier if Audio is missing for > 60 seconds.
 // rfAutoOff = false: Never turn off.
-void setRfAutoOff(void)
+static void writeRfAutoOff(void)
 {
-    uint8_t autoOff;
-    uint8_t rfOn;
-
     // char logBuff[60];
     // sprintf(logBuff, "-> RF Auto Off Set to: %s", rfAutoFlg ? "60S Timeout." : "Always On.");
     // Log.verboseln(logBuff);
 
     if (rfAutoFlg) {
-        autoOff = ON;
+        radio.radioNoAudioAutoOFF(ON);
     }
     else {
-        autoOff = OFF;
+        radio.radioNoAudioAutoOFF(OFF);
     }
+}
+
+// *********************************************************************************************
+// setRfAutoOff(): Set the QN8027 chip's RF Auto Off.
+void setRfAutoOff(void)
+{
+    uint8_t rfOn;
 
     if (rfCarrierFlg) {
         rfOn = ON;
@@ -598,7 +633,7 @@ void setRfAutoOff(void)
 
     radio.Switch(OFF); // Turn Off Carrier.
     delay(5);
-    radio.radioNoAudioAutoOFF(autoOff);
+    writeRfAutoOff();
     delay(5);
     radio.Switch(rfOn); // Restore Carrier to user's state.
 
@@ -630,9 +665,9 @@ void setRfCarrier(void)
 }
 
 // *********************************************************************************************
-// setRfPower(): Set the QN8027 chip's RF Power Output. Max 121dBuVp.
+// writeRfPower(): Write the QN8027 chip's RF Power Output register. Max 121dBuVp.
 // Note: Power is not changed until RF Carrier is toggled Off then On.
-void setRfPower(void)
+static void writeRfPower(void)
 {
     uint8_t pwrVal = RF_HIGH_POWER;
 
@@ -655,8 +690,15 @@ void setRfPower(void)
         pwrVal     = RF_HIGH_POWER;
     }
 
-    waitForIdle(10);
     radio.setTxPower(pwrVal);
+}
+
+// *********************************************************************************************
+// setRfPower(): Set the QN8027 chip's RF Power Output, then toggle the RF Carrier to apply it.
+void setRfPower(void)
+{
+    waitForIdle(10);
+    writeRfPower();
     waitForIdle(10);
 
     if (rfCarrierFlg) {
@@ -686,55 +728,83 @@ void updateOnAirSign(void)
 // limitations. So instead the callbacks set a flag that tells this routine to perform the action.
 void updateRadioSettings(void)
 {
-    if (newVgaGainFlg) {
-        newVgaGainFlg = false;
-        setVgaGain(); // Update analog (VGA) gain setting on QN8027 FM Radio Chip.
-    }
+    bool audioFlg;
+    bool rfFlg;
 
-    if (newAutoRfFlg) {
-        newAutoRfFlg = false;
-        setRfAutoOff();
-    }
+    radioLock(); // The RDS Task also uses the QN8027.
 
-    if (newDigGainFlg) {
-        newDigGainFlg = false;
-        setDigitalGain(); // Update setting on QN8027 FM Radio Chip.
-    }
+    // All changed settings are collected in the register shadow and written in a single flush.
+    // Frequency, Pre-Emphasis, RF Auto Off and RF Power only take effect after an RF Carrier Off-On
+    // toggle. If any of them changed, the carrier is turned off once before the flush and restored
+    // once after it.
+    audioFlg = newVgaGainFlg || newDigGainFlg || newInpImpFlg || newAudioModeFlg || newMuteFlg;
+    rfFlg    = newAutoRfFlg || newFreqFlg || newPreEmphFlg || newRfPowerFlg;
 
-    if (newFreqFlg) {
-        newFreqFlg = false;
-        setFrequency();
+    if (rfFlg) {
+        waitForIdle(5);
+        radio.Switch(OFF);    // Turn Off Carrier.
+        waitForIdle(5);
+        newCarrierFlg = true; // Restore Carrier to user's state, below.
     }
 
-    if (newInpImpFlg) {
-        newInpImpFlg = false;
-        setAudioImpedance(); // Update Impednace setting on QN8027 FM Radio Chip.
-    }
+    if (audioFlg || rfFlg) {
+        radio.beginUpdate();
 
-    if (newAudioModeFlg) {
-        newAudioModeFlg = false;
-        setMonoAudio();
-    }
+        if (newVgaGainFlg) {
+            newVgaGainFlg = false;
+            setVgaGain(); // Update analog (VGA) gain setting on QN8027 FM Radio Chip.
+        }
 
-    if (newMuteFlg) {
-        newMuteFlg = false;
-        setAudioMute(); // Update QN8027 Mute Register.
-    }
+        if (newDigGainFlg) {
+            newDigGainFlg = false;
+            setDigitalGain(); // Update setting on QN8027 FM Radio Chip.
+        }
 
-    if (newPreEmphFlg) {
-        newPreEmphFlg = false;
-        setPreEmphasis(); // Update QN8027 Radio Chip's setting.
-    }
+        if (newInpImpFlg) {
+            newInpImpFlg = false;
+            setAudioImpedance(); // Update Impednace setting on QN8027 FM Radio Chip.
+        }
 
-    if (newRfPowerFlg) {
-        newRfPowerFlg = false;
-        setRfPower();    // Update RF Power Setting on QN8027 FM Radio Chip.
+        if (newAudioModeFlg) {
+            newAudioModeFlg = false;
+            setMonoAudio();
+        }
+
+        if (newMuteFlg) {
+            newMuteFlg = false;
+            setAudioMute(); // Update QN8027 Mute Register.
+        }
+
+        if (newAutoRfFlg) {
+            newAutoRfFlg = false;
+            writeRfAutoOff();
+        }
+
+        if (newFreqFlg) {
+            newFreqFlg = false;
+            writeFrequency();
+        }
+
+        if (newPreEmphFlg) {
+            newPreEmphFlg = false;
+            writePreEmphasis(); // Update QN8027 Radio Chip's setting.
+        }
+
+        if (newRfPowerFlg) {
+            newRfPowerFlg = false;
+            writeRfPower();     // Update RF Power Setting on QN8027 FM Radio Chip.
+        }
+
+        radio.flush();
+        waitForIdle(rfFlg ? 25 : 5);
     }
 
     if (newCarrierFlg) { // Update RF Carrier last for best results.
         newCarrierFlg = false;
         setRfCarrier();
     }
+
+    radioUnlock();
 }
 
 // *********************************************************************************************
@@ -28,15 +28,171 @@
 extern QN8027Radio radio;
 
 // ************************************************************************************************
-// checkactiveTextAvail(): Determine if Serial, HTTP, or MQTT controller is currently sending
-// RadioText.
-bool checkActiveTextAvail(void) {
-    bool availFlg = false;
+// RDS Task: processRDS() runs in its own task so RDS timing is not disturbed by the loop() and
+// WiFi work. The remote Controllers hand over their RDS values as rdsJob_t copies through
+// rdsJobQueue, the Local Controller as an rdsLocalJob_t copy through rdsLocalQueue. Everything
+// below is owned by the RDS Task, except the Web UI postings (see processRdsUi()).
+static QueueHandle_t rdsJobQueue   = NULL;
+static QueueHandle_t rdsLocalQueue = NULL;
+static rdsLocalJob_t localJob;             // Local Controller settings, from the latest Local job.
+static unsigned long rdsMillis     = 0;    // Start time of the on-air RadioText (Countdown Timer).
+
+// RDS Task to Web UI: The RDS Task does not call ESPUI. It posts what changed and loop() shows it,
+// see processRdsUi(). Guarded by rdsUiMux.
+static const uint8_t RDS_UI_TEXT   = 0x01; // Show rdsUiTextStr on homeTab.
+static const uint8_t RDS_UI_STATUS = 0x02; // Show the RDS status message instead, see displayRdsText().
+static const uint8_t RDS_UI_CNTRL  = 0x04; // Show rdsUiCntrl on homeTab.
+static const uint8_t RDS_UI_TMR    = 0x08; // Show the countdown from rdsUiTmrMillis on homeTab.
+static const uint8_t RDS_UI_RATE   = 0x10; // Show rdsGroupRate on diagTab.
+
+static portMUX_TYPE     rdsUiMux       = portMUX_INITIALIZER_UNLOCKED;
+static volatile uint8_t rdsUiMask      = 0;
+static uint8_t          rdsUiCntrl     = NO_CNTRL;
+static unsigned long    rdsUiTmrMillis = 0;
+static char             rdsUiTextStr[RDS_TEXT_MAX_SZ + 1] = "";
 
-    if (activeTextSerialFlg || activeTextHttpFlg || activeTextMqttFlg) {
-        availFlg = true;
+// ************************************************************************************************
+// RDS Controller Table: One entry per remote Controller, in priority order (entry 0 is highest).
+// Each bit of the Controller masks refers to the table entry with the same index, so the winning
+// Controller is simply the lowest set bit. The Local Controller has the lowest priority and is
+// not in the table, it runs when no remote Controller has RadioText to send.
+// To add a remote Controller, add its entry here and send its commands with postRdsJob().
+typedef struct {
+    uint8_t        id;             // Controller ID (SERIAL_CNTRL, etc).
+    const char    *nameStr;        // Controller Name, for log messages.
+    bool           (*enbFn)(void); // Returns true if Controller is enabled.
+    bool          *activeFlg;      // Controller Is Sending RadioText flag (true while on-air).
+    String        *psnStr;         // Controller's RDS values, as set by its commands.
+    String        *textStr;
+    uint16_t      *piCode;
+    uint8_t       *ptyCode;
+    unsigned long *msgTime;
+    rdsJob_t       job;            // RDS values from the latest job, what goes on-air.
+    unsigned long  remainMillis;   // RadioText display time left, kept while preempted.
+} rdsCntrl_t;
+
+static bool ctrlMqttEnb(void) {
+    return ctrlMqttFlg;
+}
+
+static bool ctrlHttpEnb(void) {
+    return ctrlHttpFlg;
+}
+
+static bool ctrlUdpEnb(void) {
+    return ctrlUdpFlg;
+}
+
+static rdsCntrl_t rdsCntrls[] = {
+    { SERIAL_CNTRL, "Serial", ctrlSerialFlg, &activeTextSerialFlg, &rdsSerialPsnStr, &rdsSerialTextStr, &rdsSerialPiCode, &rdsSerialPtyCode, &rdsSerialMsgTime },
+    { UDP_CNTRL,    "UDP",    ctrlUdpEnb,    &activeTextUdpFlg,    &rdsUdpPsnStr,    &rdsUdpTextStr,    &rdsUdpPiCode,    &rdsUdpPtyCode,    &rdsUdpMsgTime    },
+    { MQTT_CNTRL,   "MQTT",   ctrlMqttEnb,   &activeTextMqttFlg,   &rdsMqttPsnStr,   &rdsMqttTextStr,   &rdsMqttPiCode,   &rdsMqttPtyCode,   &rdsMqttMsgTime   },
+    { HTTP_CNTRL,   "HTTP",   ctrlHttpEnb,   &activeTextHttpFlg,   &rdsHttpPsnStr,   &rdsHttpTextStr,   &rdsHttpPiCode,   &rdsHttpPtyCode,   &rdsHttpMsgTime   },
+};
+static const uint8_t RDS_CNTRL_CNT  = sizeof(rdsCntrls) / sizeof(rdsCntrls[0]);
+static const uint8_t RDS_CNTRL_NONE = 0xff;
+
+static uint8_t pendMask   = 0;              // Controllers with a new job waiting to start.
+static uint8_t stopMask   = 0;              // Controllers with a Stop request.
+static uint8_t activeMask = 0;              // Controllers with RadioText time left (on-air or preempted).
+static uint8_t onAirIdx   = RDS_CNTRL_NONE; // Table index of the on-air Controller.
+static uint32_t coalesceCnt = 0;            // Jobs replaced by a newer job before going on-air.
+
+// ************************************************************************************************
+// getRdsCoalesceCnt(): Return the number of Controller RDS jobs replaced by a newer job before they
+// went on-air.
+uint32_t getRdsCoalesceCnt(void)
+{
+    return coalesceCnt;
+}
+
+// ************************************************************************************************
+// getRdsCntrlIndex(): Return the Controller Table index of a Controller ID, RDS_CNTRL_NONE if the
+// Controller is not in the table.
+static uint8_t getRdsCntrlIndex(uint8_t controller)
+{
+    for (uint8_t i = 0; i < RDS_CNTRL_CNT; i++) {
+        if (rdsCntrls[i].id == controller) {
+            return i;
+        }
     }
-    return availFlg;
+    return RDS_CNTRL_NONE;
+}
+
+// ************************************************************************************************
+// getRdsEnbMask(): Return the mask of enabled remote Controllers.
+static uint8_t getRdsEnbMask(void)
+{
+    uint8_t enbMask = 0;
+
+    for (uint8_t i = 0; i < RDS_CNTRL_CNT; i++) {
+        if (rdsCntrls[i].enbFn()) {
+            enbMask |= (1 << i);
+        }
+    }
+    return enbMask;
+}
+
+// ************************************************************************************************
+// localRdsAvail(): The RDS Task's checkLocalRdsAvail(), uses the Local job.
+static bool localRdsAvail(void)
+{
+    return localJob.enbFlg && localJob.textEnbMask;
+}
+
+// ************************************************************************************************
+// postUiActiveController(): RDS Task's displayActiveController().
+static void postUiActiveController(uint8_t controller)
+{
+    portENTER_CRITICAL(&rdsUiMux);
+    rdsUiCntrl = controller;
+    rdsUiMask |= RDS_UI_CNTRL;
+    portEXIT_CRITICAL(&rdsUiMux);
+}
+
+// ************************************************************************************************
+// postUiRdsGroupRate(): RDS Task's updateUiRdsGroupRate().
+static void postUiRdsGroupRate(void)
+{
+    portENTER_CRITICAL(&rdsUiMux);
+    rdsUiMask |= RDS_UI_RATE;
+    portEXIT_CRITICAL(&rdsUiMux);
+}
+
+// ************************************************************************************************
+// postUiRdsStatus(): RDS Task's displayRdsText(). Replaces a posted RadioText.
+static void postUiRdsStatus(void)
+{
+    portENTER_CRITICAL(&rdsUiMux);
+    rdsUiMask = (rdsUiMask & ~RDS_UI_TEXT) | RDS_UI_STATUS;
+    portEXIT_CRITICAL(&rdsUiMux);
+}
+
+// ************************************************************************************************
+// postUiRdsText(): RDS Task's updateUiRdsText(). Replaces a posted status message.
+static void postUiRdsText(const char *textStr)
+{
+    portENTER_CRITICAL(&rdsUiMux);
+    strncpy(rdsUiTextStr, textStr, RDS_TEXT_MAX_SZ); // Last byte is never written, always NUL.
+    rdsUiMask = (rdsUiMask & ~RDS_UI_STATUS) | RDS_UI_TEXT;
+    portEXIT_CRITICAL(&rdsUiMux);
+}
+
+// ************************************************************************************************
+// postUiRdsTmr(): RDS Task's updateUiRDSTmr().
+static void postUiRdsTmr(unsigned long tmrMillis)
+{
+    portENTER_CRITICAL(&rdsUiMux);
+    rdsUiTmrMillis = tmrMillis;
+    rdsUiMask     |= RDS_UI_TMR;
+    portEXIT_CRITICAL(&rdsUiMux);
+}
+
+// ************************************************************************************************
+// checkactiveTextAvail(): Determine if a remote controller (Serial, HTTP, MQTT) is currently
+// sending RadioText.
+bool checkActiveTextAvail(void) {
+    return onAirIdx != RDS_CNTRL_NONE;
 }
 
 // ************************************************************************************************
@@ -45,23 +201,12 @@ bool checkActiveTextAvail(void) {
 // blocked and is available to use.
 // true = Controller is ready, false = higher priority controller is active.
 bool checkControllerIsAvailable(uint8_t controller) {
-    bool availFlg = true;
+    uint8_t idx = getRdsCntrlIndex(controller);
 
-    if (controller == SERIAL_CNTRL) {                   // Priority #1, can never be blocked. Always available.
-        return true;
-    }
-    else if (controller == MQTT_CNTRL) {                // Priority #2. Only Serial Controller can block it.
-        if (activeTextSerialFlg) {                      // Higher Priority Controller Active;
-            availFlg = false;                           // This controller is unavailable.
-        }
-    }
-    else if (controller == HTTP_CNTRL) {                // Priority #2. Serial and MQTT Controllers can block it.
-        if (activeTextSerialFlg || activeTextMqttFlg) { // Higher Priority Controllers Active;
-            availFlg = false;                           // This controller is unavailable.
-        }
+    if (idx == RDS_CNTRL_NONE) { // Local Controller, blocked by any remote controller.
+        return activeMask == 0;
     }
-
-    return availFlg;
+    return (activeMask & ((1 << idx) - 1)) == 0;
 }
 
 // ************************************************************************************************
@@ -87,63 +232,293 @@ bool checkLocalRdsAvail(void) {
 }
 
 // ************************************************************************************************
-// checkRemoteRdsAvail): Determine if any Serial, HTTP, or MQTT controller Mode is Enabled.
+// checkRemoteRdsAvail): Determine if any remote (Serial, HTTP, MQTT) controller Mode is Enabled.
 bool checkRemoteRdsAvail(void) {
-    bool availFlg = false;
+    return getRdsEnbMask() != 0;
+}
 
-    if (ctrlSerialFlg() || ctrlMqttFlg || ctrlHttpFlg) {
-        availFlg = true;
+// ************************************************************************************************
+// checkRemoteTextAvail(): Determine if a remote (Serial, HTTP, MQTT) controller has RadioText
+// available to send. Ignores Local RDS.
+bool checkRemoteTextAvail(void) {
+    return (pendMask | activeMask) != 0;
+}
+
+// ************************************************************************************************
+// checkControllerRdsAvail(): Determine if any (Local, HTTP, MQTT, Serial) RDS Controller is Enabled.
+bool checkControllerRdsAvail(void) {
+    return ctrlLocalFlg || checkRemoteRdsAvail();
+}
+
+// ************************************************************************************************
+// RDS Group Scheduler: Keeps the QN8027 RDS buffer busy with a fixed cyclic group sequence.
+// Each cycle sends RDS_SCHED_PSN_CNT 0A (PSN) groups followed by RDS_SCHED_RT_CNT 2A (RadioText)
+// groups. The PSN and RadioText are loaded by radio.setStationName() and radio.setRadioText().
+// RadioText segments are picked by radio.getNextRtGroup(), changed segments go first.
+static uint8_t schedSeqPos = 0; // Position in the 0A/2A sequence.
+static uint8_t schedPsnSeg = 0; // Next PSN segment (0A group) to send.
+
+// Command Latency Trace of the on-air RadioText. The RadioText groups are counted by their
+// radio.rdsSentCnt value (write number) so the stamps are made when the QN8027 gets to them.
+static uint32_t traceId       = 0; // Trace to stamp, zero if none.
+static uint32_t traceFirstCnt = 0; // Write number of the first RadioText group, zero if not queued yet.
+static uint32_t traceLastCnt  = 0; // Write number of the group that completes the RadioText, zero if not queued yet.
+
+// ************************************************************************************************
+// processRdsScheduler(): Top up the RDS group FIFO and service the QN8027 RDS pump. Also reports
+// the achieved group rate. Non-blocking, call it on every main loop pass.
+void processRdsScheduler(void)
+{
+    char logBuff[80];
+    uint8_t psnCnt;
+    uint8_t rtCnt;
+    const uint8_t *grp;
+    static uint32_t rateCnt = 0;
+    static unsigned long rateMillis = 0;
+
+    if (rfCarrierFlg) {
+        psnCnt = radio.getPsnGroupCnt();
+        rtCnt  = radio.getRtGroupCnt();
+
+        while ((psnCnt || rtCnt) && radio.getRDSQueueCnt() < RDS_SCHED_QUEUE_CNT) {
+            if (((schedSeqPos < RDS_SCHED_PSN_CNT) && psnCnt) || !rtCnt) {
+                if (schedPsnSeg >= psnCnt) {
+                    schedPsnSeg = 0;
+                }
+                grp = radio.getPsnGroup(schedPsnSeg++);
+            }
+            else {
+                grp = radio.getNextRtGroup();
+
+                if (traceId != 0) {
+                    uint32_t writeCnt = radio.rdsSentCnt + radio.getRDSQueueCnt() + 1;
+
+                    traceFirstCnt = traceFirstCnt ? traceFirstCnt : writeCnt;
+                    traceLastCnt  = (!traceLastCnt && radio.isRtCycleDone()) ? writeCnt : traceLastCnt;
+                }
+            }
+
+            if (++schedSeqPos >= RDS_SCHED_PSN_CNT + RDS_SCHED_RT_CNT) {
+                schedSeqPos = 0;
+            }
+            radio.queueRDS(grp);
+        }
+    }
+
+    radio.serviceRDS(); // Non-blocking, sends the next queued group when the QN8027 is ready.
+
+    if (traceId != 0) {
+        if (traceFirstCnt && (int32_t)(radio.rdsSentCnt - traceFirstCnt) >= 0) {
+            stampCmdTrace(traceId, CMD_TRACE_FIRST);
+        }
+
+        if (traceLastCnt && (int32_t)(radio.rdsAckCnt - traceLastCnt) >= 0) {
+            stampCmdTrace(traceId, CMD_TRACE_LAST);
+            traceId = 0; // Whole RadioText is on-air, trace done.
+        }
+    }
+
+    if (getClockMillis() - rateMillis >= RDS_RATE_UPD_TIME) {
+        rdsGroupRate = float(radio.rdsSentCnt - rateCnt) * 1000.0f / float(getClockMillis() - rateMillis);
+        rateCnt      = radio.rdsSentCnt;
+        rateMillis   = getClockMillis();
+        postUiRdsGroupRate();
+
+        if (rfCarrierFlg) {
+            sprintf(logBuff, "RDS Group Rate: %1.2f groups/sec (%u%% of %1.1f).",
+                    rdsGroupRate, uint8_t(rdsGroupRate * 100.0f / RDS_GROUP_RATE_MAX), RDS_GROUP_RATE_MAX);
+            Log.verboseln(logBuff);
+        }
     }
-    return availFlg;
 }
 
 // ************************************************************************************************
-// checkRemoteTextAvail(): Determine if Serial, HTTP, or MQTT controller has RadioText available to
-// send. Ignores Local RDS.
-bool checkRemoteTextAvail(void) {
-    bool availFlg = false;
+// receiveRdsJobs(): Move queued Controller Jobs into the Controller Table. A newer job replaces an
+// older one from the same Controller that has not been sent yet (latest wins). The Local job is
+// used when the Local Controller's next RadioText is picked.
+static void receiveRdsJobs(void)
+{
+    uint8_t  idx;
+    rdsJob_t job;
 
-    if (textSerialFlg || textHttpFlg || textMqttFlg) {
-        availFlg = true;
+    if (rdsLocalQueue != NULL) {
+        xQueueReceive(rdsLocalQueue, &localJob, 0);
+    }
+
+    while (rdsJobQueue != NULL && xQueueReceive(rdsJobQueue, &job, 0) == pdTRUE) {
+        idx = getRdsCntrlIndex(job.controller);
+
+        if (idx == RDS_CNTRL_NONE) {
+            continue;
+        }
+        else if (job.action == RDS_JOB_STOP) {
+            stopMask |= (1 << idx);
+            pendMask &= ~(1 << idx);
+        }
+        else {
+            if (pendMask & (1 << idx)) {
+                coalesceCnt++;
+            }
+            rdsCntrls[idx].job = job;
+            pendMask          |= (1 << idx);
+            stopMask          &= ~(1 << idx);
+        }
     }
-    return availFlg;
 }
 
 // ************************************************************************************************
-// checkControllerRdsAvail(): Determine if any (Local, HTTP, MQTT, Serial) RDS Controller is Enabled.
-bool checkControllerRdsAvail(void) {
-    bool availFlg = false;
+// preemptRdsController(): Take the on-air Controller off-air. It keeps its remaining display time
+// and resumes when it wins arbitration again.
+static void preemptRdsController(unsigned long currentMillis)
+{
+    unsigned long elapsedMillis = currentMillis - rdsMillis;
+    rdsCntrl_t   *cntrl         = &rdsCntrls[onAirIdx];
 
-    if (ctrlSerialFlg() || ctrlMqttFlg || ctrlHttpFlg || ctrlLocalFlg) {
-        availFlg = true;
+    cntrl->remainMillis = (elapsedMillis < rdsMsgTime) ? rdsMsgTime - elapsedMillis : 0;
+    *cntrl->activeFlg   = false;
+
+    if (cntrl->remainMillis < RDS_MSG_UPD_TIME) { // Not worth resuming.
+        activeMask &= ~(1 << onAirIdx);
     }
-    return availFlg;
+    onAirIdx = RDS_CNTRL_NONE;
+}
+
+// ************************************************************************************************
+// startRdsController(): Put a Controller's RadioText on-air for its remaining display time.
+// resumeFlg = true if the Controller was preempted and is now resuming.
+static void startRdsController(uint8_t idx, bool resumeFlg, unsigned long currentMillis)
+{
+    char logBuff[60 + RDS_TEXT_MAX_SZ];
+    rdsCntrl_t *cntrl = &rdsCntrls[idx];
+
+    if (onAirIdx != RDS_CNTRL_NONE) {
+        sprintf(logBuff, "%s Controller's RadioText Preempted by %s Controller.", rdsCntrls[onAirIdx].nameStr, cntrl->nameStr);
+        Log.infoln(logBuff);
+        preemptRdsController(currentMillis);
+    }
+
+    onAirIdx           = idx;
+    *cntrl->activeFlg  = true;
+    activeTextLocalFlg = false; // Clear lower priority Controller.
+    rdsMsgTime         = cntrl->remainMillis;
+    rdsMillis          = currentMillis;
+
+    sprintf(logBuff, "%s Controller RDS Will Use: PI=0x%04X, PTY=%u.", cntrl->nameStr, cntrl->job.piCode, cntrl->job.ptyCode);
+    Log.infoln(logBuff);
+    radio.setPiCode(cntrl->job.piCode);   // Set Controller's Pi Code.
+    radio.setPtyCode(cntrl->job.ptyCode); // Set Controller's PTY Code.
+    resetRdsScheduler();                  // New message replaces any queued RDS groups.
+
+    if (!resumeFlg && (cntrl->job.traceId != 0)) {
+        stampCmdTrace(cntrl->job.traceId, CMD_TRACE_WIN);
+        traceId = cntrl->job.traceId;     // Stamp its first and last RadioText groups.
+    }
+
+    sprintf(logBuff, "%s Controller %s RDS Program Service Name (%s)", cntrl->nameStr, resumeFlg ? "Resuming" : "Sending", cntrl->job.psnStr);
+    Log.infoln(logBuff);
+    radio.setStationName(cntrl->job.psnStr);
+    sprintf(logBuff, "%s Controller %s RDS RadioText (%s).", cntrl->nameStr, resumeFlg ? "Resuming" : "Sending", cntrl->job.textStr);
+    Log.infoln(logBuff);
+    radio.setRadioText(cntrl->job.textStr);
+    postUiRdsText(cntrl->job.textStr);
+    postUiActiveController(cntrl->id);
 }
 
 // ************************************************************************************************
-// processRDS(): Local RDS RadioText Display Handler for homeTab. Must be installed in main loop
+// stopRdsControllers(): Handle the Controller Stop requests.
+static void stopRdsControllers(unsigned long currentMillis)
+{
+    char    logBuff[60];
+    uint8_t stopActive = stopMask & activeMask;
+
+    stopMask = 0;
+
+    for (uint8_t i = 0; i < RDS_CNTRL_CNT; i++) {
+        if (stopActive & (1 << i)) {
+            activeMask &= ~(1 << i);
+
+            if (i == onAirIdx) {
+                *rdsCntrls[i].activeFlg = false;
+                onAirIdx                = RDS_CNTRL_NONE;
+                rdsMillis               = currentMillis - rdsMsgTime; // Force Countdown Timeout.
+            }
+            sprintf(logBuff, "%s Controller's RadioText has Been Stopped.", rdsCntrls[i].nameStr);
+            Log.infoln(logBuff);
+        }
+    }
+}
+
+// ************************************************************************************************
+// arbitrateRdsControllers(): Start the new jobs of enabled Controllers and put the highest priority
+// Controller with RadioText on-air. A lower priority Controller is preempted, not cancelled.
+// The on-air Controller's new job waits until its RadioText has been on-air for one full RDS cycle
+// (RDS_RT_HOLD_TIME); Faster updates are coalesced by receiveRdsJobs().
+// Returns true if the on-air RadioText changed.
+static bool arbitrateRdsControllers(unsigned long currentMillis)
+{
+    uint8_t enbMask = getRdsEnbMask();
+    uint8_t newMask = pendMask & enbMask; // Disabled Controllers keep their jobs pending.
+    uint8_t winMask;
+    uint8_t winIdx;
+
+    if (stopMask) {
+        stopRdsControllers(currentMillis);
+    }
+
+    if ((onAirIdx != RDS_CNTRL_NONE) && (currentMillis - rdsMillis < RDS_RT_HOLD_TIME)) {
+        newMask &= ~(1 << onAirIdx); // Hold, receivers have not seen the whole RadioText yet.
+    }
+
+    pendMask &= ~newMask;
+
+    if ((onAirIdx != RDS_CNTRL_NONE) && (newMask & (1 << onAirIdx))) {
+        preemptRdsController(currentMillis); // Before its new job's display time is set, below.
+    }
+
+    for (uint8_t i = 0; newMask >> i; i++) {
+        if (newMask & (1 << i)) {
+            rdsCntrls[i].remainMillis = rdsCntrls[i].job.msgTime;
+        }
+    }
+    activeMask |= newMask;
+
+    winMask = activeMask & enbMask;
+    winIdx  = winMask ? __builtin_ctz(winMask) : RDS_CNTRL_NONE; // Lowest bit is highest priority.
+
+    if ((winIdx != RDS_CNTRL_NONE) && ((winIdx != onAirIdx) || (newMask & (1 << winIdx)))) {
+        startRdsController(winIdx, !(newMask & (1 << winIdx)), currentMillis);
+        return true;
+    }
+    else if ((winIdx == RDS_CNTRL_NONE) && (onAirIdx != RDS_CNTRL_NONE)) { // On-air Controller was disabled.
+        preemptRdsController(currentMillis);
+        rdsMillis = currentMillis - rdsMsgTime;                            // Force Countdown Timeout.
+    }
+    return false;
+}
+
+// ************************************************************************************************
+// processRDS(): Local RDS RadioText Display Handler for homeTab. Runs in the RDS Task, see rdsTask().
 //               There are three available Local RadioText Messages. Display time = rdsMsgTime.
 //               A round robbin scheduler is used and user can select which messages to show.
+//               Remote Controllers are arbitrated by arbitrateRdsControllers().
+//               Uses the Local job for the Local Controller's settings, see postRdsLocalJob().
 void processRDS(void) {
     char logBuff[75 + RDS_TEXT_MAX_SZ];
     static uint8_t loop       = 0;
     unsigned long currentMillis    = 0;
-    static unsigned long rdsMillis = 0;     // Timer for RDS Web GUI updates.
     static unsigned long cntMillis = 0;     // Timer for ICStation FM Tx services.
-    static String   rdsRefreshPsnStr;
-    static String   rdsRefreshTextStr; // RadioText Refresh, Message to repeat.
+    rdsCntrl_t *cntrl;
 
-    rdsRefreshPsnStr.reserve(10);
-    rdsRefreshTextStr.reserve(70);
+    processRdsScheduler(); // Keep the RDS Group buffer busy, non-blocking.
+    receiveRdsJobs();      // Collect new Controller commands.
 
-    currentMillis = millis();
+    currentMillis = getClockMillis();
 
     if (cntMillis == 0) {
-        updateUiRDSTmr(0);         // Clear Display
+        postUiRdsTmr(0);           // Clear Display
         cntMillis = currentMillis; // Initialize First entry;
     }
-    else if (testModeFlg) {
-        updateTestTones(false);
+    else if (testModeFlg) {                                   // Test Tones are run by loop(), see updateTestTones().
         cntMillis = currentMillis;
         rdsMillis = currentMillis - rdsMsgTime + 500;         // Schedule next "normal" RadioText in 0.5Sec.
         return;
@@ -152,261 +527,246 @@ void processRDS(void) {
         cntMillis = currentMillis;
 
         if (!rfCarrierFlg) {
-            updateUiRDSTmr(0);                            // Clear Displayed Elapsed Timer.
-            displayRdsText();
+            resetRdsScheduler();                          // Carrier is off, discard pending RDS groups.
+            radio.restartRtCycle();                       // Receivers lost the RadioText, resend all of it.
+            postUiRdsTmr(0);                              // Clear Displayed Elapsed Timer.
+            postUiRdsStatus();
             rdsMillis = currentMillis - rdsMsgTime + 500; // Schedule next RadioText in 0.5Sec.
             return;
         }
-        else if (!checkLocalControllerAvail() && !checkControllerRdsAvail()) {
-            updateUiRDSTmr(0);                            // Clear Displayed Elapsed Timer.
-            displayRdsText();
+        else if (!localJob.enbFlg && !checkRemoteRdsAvail()) {
+            postUiRdsTmr(0);                              // Clear Displayed Elapsed Timer.
+            postUiRdsStatus();
             rdsMillis = currentMillis - rdsMsgTime + 500; // Schedule next RadioText in 0.5Sec.
             return;
         }
-        else if (activeTextSerialFlg && stopSerialFlg) {
-            stopSerialFlg       = false;
-            activeTextSerialFlg = false;
-            rdsMillis           = millis() - rdsMsgTime; // Force Countdown Timeout.
-            Log.infoln("Serial Controller's RadioText has Been Stopped.");
-        }
-        else if (activeTextMqttFlg && stopMqttFlg) {
-            stopMqttFlg       = false;
-            activeTextMqttFlg = false;
-            rdsMillis         = millis() - rdsMsgTime; // Force Countdown Timeout.
-            Log.infoln("MQTT Controller's RadioText has Been Stopped.");
-        }
-        else if (activeTextHttpFlg && stopHttpFlg) {
-            stopHttpFlg       = false;
-            activeTextHttpFlg = false;
-            rdsMillis         = millis() - rdsMsgTime; // Force Countdown Timeout.
-            Log.infoln("MQTT Controller's RadioText has Been Stopped.");
-        }
-        else if (ctrlSerialFlg() && textSerialFlg) {   // Priority #1, New Serial RadioText.
-            textSerialFlg = false;
-            stopSerialFlg = false;
-
-            activeTextSerialFlg = true;
-            activeTextMqttFlg   = false;          // Clear lower priority Controller.
-            activeTextHttpFlg   = false;          // Clear lower priority Controller.
-            activeTextLocalFlg  = false;          // Clear lower priority Controller.
-
-            rdsRefreshPsnStr  =  rdsSerialPsnStr; // Program Service Name.
-            rdsRefreshTextStr = rdsSerialTextStr; // RadioText Message.
-            rdsMsgTime        = rdsSerialMsgTime;
-            rdsMillis         = currentMillis;
-
-            sprintf(logBuff, "Serial Controller RDS Will Use: PI=0x%04X, PTY=%u.", rdsSerialPiCode, rdsSerialPtyCode);
-            Log.infoln(logBuff);
-            radio.setPiCode(rdsSerialPiCode);   // Set Serial Controller's Pi Code.
-            radio.setPtyCode(rdsSerialPtyCode); // Set Serial Controller's PTY Code.
-
-            sprintf(logBuff, "Serial Controller Sending RDS Program Service Name (%s)", rdsRefreshPsnStr.c_str());
-            Log.infoln(logBuff);
-            radio.sendStationName(rdsRefreshPsnStr);
-            sprintf(logBuff, "Serial Controller Sending RDS RadioText (%s).", rdsRefreshTextStr.c_str());
-            Log.infoln(logBuff);
-            radio.sendRadioText(rdsRefreshTextStr);
-            updateUiRdsText(rdsRefreshTextStr);
-            displayActiveController(SERIAL_CNTRL);
-        }
-        else if (ctrlMqttFlg && textMqttFlg && !activeTextSerialFlg) { // Priority #2, New MQTT RadioText
-            textMqttFlg = false;
-            stopMqttFlg = false;
-
-            activeTextMqttFlg  = true;
-            activeTextHttpFlg  = false;         // Clear lower priority Controller.
-            activeTextLocalFlg = false;         // Clear lower priority Controller.
-
-            rdsRefreshPsnStr  = rdsMqttPsnStr;  // Program Service Name.
-            rdsRefreshTextStr = rdsMqttTextStr; // RadioText Message.
-            rdsMsgTime        = rdsMqttMsgTime;
-            rdsMillis         = currentMillis;
-
-            sprintf(logBuff, "MQTT Controller RDS Will Use: PI=0x%04X, PTY=%u.", rdsMqttPiCode, rdsMqttPtyCode);
-            Log.infoln(logBuff);
-            radio.setPiCode(rdsMqttPiCode);   // Set MQTT Controller's Pi Code.
-            radio.setPtyCode(rdsMqttPtyCode); // Set MQTT Controller's PTY Code.
-
-            sprintf(logBuff, "MQTT Controller Sending RDS Program Service Name (%s)", rdsRefreshPsnStr.c_str());
-            Log.infoln(logBuff);
-            radio.sendStationName(rdsRefreshPsnStr);
-            sprintf(logBuff, "MQTT Controller Sending RDS RadioText (%s).", rdsRefreshTextStr.c_str());
-            Log.infoln(logBuff);
-            radio.sendRadioText(rdsRefreshTextStr);
-            updateUiRdsText(rdsRefreshTextStr);
-            displayActiveController(MQTT_CNTRL);
-        }
-        else if (ctrlHttpFlg && textHttpFlg && !activeTextSerialFlg && !activeTextMqttFlg) { // Priority #3, New HTTP RadioText
-            textHttpFlg        = false;
-            stopHttpFlg        = false;
-            activeTextHttpFlg  = true;
-            activeTextLocalFlg = false;         // Clear lower priority Controller.
-
-            rdsRefreshPsnStr  = rdsHttpPsnStr;  // Program Service Name.
-            rdsRefreshTextStr = rdsHttpTextStr; // RadioText Message.
-            rdsMsgTime        = rdsHttpMsgTime;
-            rdsMillis         = currentMillis;
-
-            sprintf(logBuff, "HTTP Controller RDS Will Use: PI=0x%04X, PTY=%u.", rdsHttpPiCode, rdsHttpPtyCode);
-            Log.infoln(logBuff);
-            radio.setPiCode(rdsHttpPiCode);   // Set HTTP Controller's Pi Code.
-            radio.setPtyCode(rdsHttpPtyCode); // Set HTTP Controller's PTY Code.
-
-            sprintf(logBuff, "HTTP Controller Sending RDS Program Service Name (%s)", rdsRefreshPsnStr.c_str());
-            Log.infoln(logBuff);
-            radio.sendStationName(rdsRefreshPsnStr);
-            sprintf(logBuff, "HTTP Controller Sending RDS RadioText (%s).", rdsRefreshTextStr.c_str());
-            Log.infoln(logBuff);
-            radio.sendRadioText(rdsRefreshTextStr);
-            updateUiRdsText(rdsRefreshTextStr);
-            displayActiveController(HTTP_CNTRL);
+        else if (arbitrateRdsControllers(currentMillis)) { // New remote RadioText is on-air.
+            postUiRdsTmr(rdsMillis);
         }
-        else if (!checkLocalRdsAvail()  && checkControllerRdsAvail() && !checkActiveTextAvail()) {
-            updateUiRDSTmr(0);                             // Clear Displayed Elapsed Timer.
-            displayRdsText();
+        else if (!localRdsAvail() && !checkActiveTextAvail()) {
+            postUiRdsTmr(0);                               // Clear Displayed Elapsed Timer.
+            postUiRdsStatus();
             rdsMillis = currentMillis - rdsMsgTime + 500;  // Schedule next RadioText in 0.5Sec.
             return;
         }
         else if (currentMillis - rdsMillis < rdsMsgTime) { // RadioText Message Display Time has not ended yet.
-            updateUiRDSTmr(rdsMillis);                     // Update Countdown time on GUI homeTab.
-
-            if (rfCarrierFlg) {                            // When On-Air Send Program Service Name (PSN) every second.
-                sprintf(logBuff, "Refreshing RDS Program Service Name: %s.", rdsRefreshPsnStr.c_str());
-                Log.traceln(logBuff);
-                radio.sendStationName(rdsRefreshPsnStr);
-
-                if (((currentMillis - rdsMillis) / 1000) % RDS_REFRESH_TM == 0) { // Time to refresh RadioText.
-                    if (rdsRefreshTextStr.length() && (currentMillis - rdsMillis >= RDS_MSG_UPD_TIME)) {
-                        sprintf(logBuff, "Refreshing RDS RadioText Message: %s", rdsRefreshTextStr.c_str());
-                        Log.traceln(logBuff);
-                        radio.sendRadioText(rdsRefreshTextStr);
-                    }
-                }
-            }
-        }
+            postUiRdsTmr(rdsMillis);                       // Update Countdown time on GUI homeTab.
+        }                                                  // PSN & RadioText are repeated by processRdsScheduler().
     }
 
     if (!rfCarrierFlg) {                               // Radio Turned Off, nothing else to do. Exit.
         return;
     }
     else if (rdsMillis == 0) {                         // First Function Call, Init RDS Message Countdown Timer Time.
-        rdsMillis = millis() + rdsMsgTime;
+        rdsMillis = getClockMillis() + rdsMsgTime;
     }
     else if (currentMillis - rdsMillis < rdsMsgTime) { // Countdown still active. We're done for now, exit.
         return;
     }
 
     /* Countdown Now Zero. RDS RadioText Message Time has ended. */
-    updateUiRDSTmr(rdsMillis); // Show "Expired" on GUI homeTab's RadioText Timer.
+    postUiRdsTmr(rdsMillis); // Show "Expired" on GUI homeTab's RadioText Timer.
 
     /* Let's Check to see who supplied the RadioText and terminate it. */
-    if (activeTextSerialFlg) { // USB Serial RDS Controller is #1 Priority.
-        activeTextSerialFlg = false;
-        Log.infoln("Serial Controller's RDS Time has Ended.");
-    }
-    else if (activeTextMqttFlg) { // MQTT RDS Controller is #2 Priority.
-        activeTextMqttFlg = false;
-        Log.infoln("MQTT Controller's RDS Time has Ended.");
+    if (onAirIdx != RDS_CNTRL_NONE) { // Remote Controller's time is up.
+        cntrl              = &rdsCntrls[onAirIdx];
+        *cntrl->activeFlg  = false;
+        activeMask        &= ~(1 << onAirIdx);
+        onAirIdx           = RDS_CNTRL_NONE;
+        sprintf(logBuff, "%s Controller's RDS Time has Ended.", cntrl->nameStr);
+        Log.infoln(logBuff);
     }
-    else if (activeTextHttpFlg) { // HTTP RDS Controller is #3 Priority.
-        activeTextHttpFlg = false;
-        Log.infoln("HTTP Controller's RDS Time has Ended.");
+
+    if (activeMask & getRdsEnbMask()) { // A preempted remote Controller resumes.
+        arbitrateRdsControllers(currentMillis);
     }
-    else if (checkLocalRdsAvail()) { // Local RDS is Lowest Priority.
+    else if (localRdsAvail()) {         // Local RDS is Lowest Priority.
         activeTextLocalFlg = true;
-        rdsMsgTime         = rdsLocalMsgTime;
-        rdsRefreshPsnStr   = rdsLocalPsnStr;
-
-        sprintf(logBuff, "Local Controller RDS Will Use: PI=0x%04X, PTY=%u.", rdsLocalPiCode, rdsLocalPtyCode);
-        Log.infoln(logBuff);
-        radio.setPiCode(rdsLocalPiCode);   // Set Local Controller's PI Code.
-        radio.setPtyCode(rdsLocalPtyCode); // Set Local Controller's PTY Code.
+        rdsMsgTime         = localJob.msgTime;
 
-        sprintf(logBuff, "Local Controller Sending RDS Station Name (%s).", rdsLocalPsnStr.c_str());
+        sprintf(logBuff, "Local Controller RDS Will Use: PI=0x%04X, PTY=%u.", localJob.piCode, localJob.ptyCode);
         Log.infoln(logBuff);
-        radio.sendStationName(rdsLocalPsnStr);
+        radio.setPiCode(localJob.piCode);   // Set Local Controller's PI Code.
+        radio.setPtyCode(localJob.ptyCode); // Set Local Controller's PTY Code.
+        resetRdsScheduler();                // New message replaces any queued RDS groups.
 
-        sprintf(logBuff, "Local Controller Sending RDS RadioText Message");
+        sprintf(logBuff, "Local Controller Sending RDS Station Name (%s).", localJob.psnStr);
         Log.infoln(logBuff);
+        radio.setStationName(localJob.psnStr);
 
-        // Find Next Available Local RadioText Message.
-        if ((loop == 0) && !rdsText1EnbFlg) { // RDS Message Disabled, next.
-            Log.traceln("-> RDS Text Msg1 is Disabled, Skip to Next");
-            loop = 1;
-        }
-
-        if ((loop == 1) && !rdsText2EnbFlg) { // RDS Message Disabled, next.
-            Log.traceln("-> RDS Text Msg2 is Disabled, Skip to Next");
-            loop = 2;
-        }
-
-        if ((loop == 2) && !rdsText3EnbFlg) { // This can't happen!. Reset Loop.
-            Log.traceln("-> RDS Text Msg3 is Disabled, Skip to Beginning");
-            loop = 0;
+        // Find Next Available Local RadioText Message. At least one is enabled, see localRdsAvail().
+        while (!(localJob.textEnbMask & (1 << loop))) {
+            sprintf(logBuff, "-> RDS Text Msg%u is Disabled, Skip to Next", loop + 1);
+            Log.traceln(logBuff);
+            loop = (loop + 1) % RDS_LOCAL_MSG_CNT;
         }
 
-        updateUiRdsText(" "); // Clear RDS RadioText In Web UI; Use single-space char!
-
         // Send the chosen RadioText.
-        if (loop == 0) {
-            if (rdsText1EnbFlg) {
-                rdsTextMsgStr     = rdsTextMsg1Str;
-                rdsRefreshTextStr = rdsTextMsgStr;
-                radio.sendRadioText(rdsTextMsgStr);
-                updateUiRdsText(rdsTextMsgStr);
-                displayActiveController(LOCAL_CNTRL);
-                rdsMillis = millis();
-            }
-        }
-        else if (loop == 1) {
-            if (rdsText2EnbFlg) {
-                rdsTextMsgStr     = rdsTextMsg2Str;
-                rdsRefreshTextStr = rdsTextMsgStr;
-                radio.sendRadioText(rdsTextMsgStr);
-                updateUiRdsText(rdsTextMsgStr);
-                displayActiveController(LOCAL_CNTRL);
-                rdsMillis = millis();
-            }
-        }
-        else if (loop == 2) {
-            if (rdsText3EnbFlg) {
-                rdsTextMsgStr     = rdsTextMsg3Str;
-                rdsRefreshTextStr = rdsTextMsgStr;
-                radio.sendRadioText(rdsTextMsgStr);
-                updateUiRdsText(rdsTextMsgStr);
-                displayActiveController(LOCAL_CNTRL);
-                rdsMillis = millis();
-            }
-        }
-        else {
-            Log.traceln("-> Will Resync Local RDS RadioText on Next Round.");
-        }
+        radio.setRadioText(localJob.textStr[loop]);
+        postUiRdsText(localJob.textStr[loop]);
+        postUiActiveController(LOCAL_CNTRL);
+        rdsMillis = getClockMillis();
 
-        sprintf(logBuff, "-> RDS RadioText Sent \"%s\".", rdsTextMsgStr.c_str());
+        sprintf(logBuff, "Local Controller Sent RDS RadioText Msg%u \"%s\".", loop + 1, localJob.textStr[loop]);
         Log.infoln(logBuff);
 
-        if (++loop > 2) {
-            loop = 0;
-        }
+        loop = (loop + 1) % RDS_LOCAL_MSG_CNT;
     }
     else { // No available RadioText message.
-        activeTextSerialFlg = false;
-        activeTextMqttFlg   = false;
-        activeTextHttpFlg   = false;
-        activeTextLocalFlg  = false;
+        activeTextLocalFlg = false;
 
+        radio.clearRDSProgram();                          // Nothing for the RDS Group Scheduler to send.
         loop              = 0;                            // Reset Local RadioText to first message.
-        rdsRefreshTextStr = "";                           // Erase RadioText Refresh message.
-        rdsMillis         = millis() - rdsMsgTime + 1000; // Schedule next RadioText in 1Sec.
+        rdsMillis         = getClockMillis() - rdsMsgTime + 1000; // Schedule next RadioText in 1Sec.
         Log.warningln("-> No RDS RadioText Available, Nothing Sent.");
-        displayActiveController(NO_CNTRL);
+        postUiActiveController(NO_CNTRL);
+    }
+
+    postUiRdsTmr(rdsMillis); // Refresh Countdown time on GUI homeTab.
+}
+
+// ************************************************************************************************
+// postRdsJob(): Queue a copy of the Controller's current RDS values (PSN, RadioText, PI, PTY, Time)
+// for the RDS Task. Called by the Controller command handlers. Returns false if the queue is full.
+bool postRdsJob(uint8_t controller, uint8_t action)
+{
+    uint8_t     idx = getRdsCntrlIndex(controller);
+    rdsCntrl_t *cntrl;
+    rdsJob_t    job;
+
+    if (idx == RDS_CNTRL_NONE) {
+        Log.errorln("-> postRdsJob: Undefined Controller!");
+        return false;
+    }
+    cntrl = &rdsCntrls[idx];
+
+    memset(&job, 0, sizeof(job));
+    job.controller = controller;
+    job.action     = action;
+    job.piCode     = *cntrl->piCode;
+    job.ptyCode    = *cntrl->ptyCode;
+    job.msgTime    = *cntrl->msgTime;
+    job.traceId    = getCmdTraceId();
+    cntrl->psnStr->toCharArray(job.psnStr, sizeof(job.psnStr));
+    cntrl->textStr->toCharArray(job.textStr, sizeof(job.textStr));
+
+    if ((rdsJobQueue == NULL) || (xQueueSend(rdsJobQueue, &job, 0) != pdTRUE)) {
+        Log.errorln("-> postRdsJob: RDS Job Queue is Full, Command Ignored.");
+        return false;
+    }
+    return true;
+}
+
+// ************************************************************************************************
+// postRdsLocalJob(): Hand the Local Controller's settings (homeTab / rdsTab values) to the RDS Task
+// if they changed. Call it from loop(), the RDS Task never reads the Local Controller's Strings.
+void postRdsLocalJob(void)
+{
+    static rdsLocalJob_t postedJob;
+    static bool postedFlg = false;
+    rdsLocalJob_t job;
+
+    if (rdsLocalQueue == NULL) {
+        return;
     }
 
-    updateUiRDSTmr(rdsMillis); // Refresh Countdown time on GUI homeTab.
+    memset(&job, 0, sizeof(job)); // Clean padding, jobs are compared with memcmp().
+    job.enbFlg      = ctrlLocalFlg;
+    job.textEnbMask = (rdsText1EnbFlg ? 0x01 : 0) | (rdsText2EnbFlg ? 0x02 : 0) | (rdsText3EnbFlg ? 0x04 : 0);
+    job.piCode      = rdsLocalPiCode;
+    job.ptyCode     = rdsLocalPtyCode;
+    job.msgTime     = rdsLocalMsgTime;
+    rdsLocalPsnStr.toCharArray(job.psnStr, sizeof(job.psnStr));
+    rdsTextMsg1Str.toCharArray(job.textStr[0], sizeof(job.textStr[0]));
+    rdsTextMsg2Str.toCharArray(job.textStr[1], sizeof(job.textStr[1]));
+    rdsTextMsg3Str.toCharArray(job.textStr[2], sizeof(job.textStr[2]));
+
+    if (postedFlg && (memcmp(&job, &postedJob, sizeof(job)) == 0)) {
+        return;
+    }
+    xQueueOverwrite(rdsLocalQueue, &job); // Latest wins, the RDS Task only needs the current settings.
+    postedJob = job;
+    postedFlg = true;
 }
 
 // ************************************************************************************************
-// resetControllerRdsValues(): Reset the Local, Serial, MQTT, and HTTP Controllers' RDS Initial
+// processRdsUi(): Show the RDS Task's postings (RadioText, Controller, Countdown Timer, Group Rate)
+// on the Web UI. Call it from loop().
+void processRdsUi(void)
+{
+    char          textStr[RDS_TEXT_MAX_SZ + 1];
+    uint8_t       controller;
+    uint8_t       updMask;
+    unsigned long tmrMillis;
+
+    if (rdsUiMask == 0) {
+        return;
+    }
+
+    portENTER_CRITICAL(&rdsUiMux);
+    updMask    = rdsUiMask;
+    controller = rdsUiCntrl;
+    tmrMillis  = rdsUiTmrMillis;
+    memcpy(textStr, rdsUiTextStr, sizeof(textStr));
+    rdsUiMask  = 0;
+    portEXIT_CRITICAL(&rdsUiMux);
+
+    if (updMask & RDS_UI_TEXT) {
+        rdsTextMsgStr = textStr; // On-air RadioText, also used by displayRdsText().
+        updateUiRdsText(rdsTextMsgStr);
+    }
+    else if (updMask & RDS_UI_STATUS) {
+        displayRdsText();
+    }
+
+    if (updMask & RDS_UI_CNTRL) {
+        displayActiveController(controller);
+    }
+
+    if (updMask & RDS_UI_TMR) {
+        updateUiRDSTmr(tmrMillis);
+    }
+
+    if (updMask & RDS_UI_RATE) {
+        updateUiRdsGroupRate();
+    }
+}
+
+// ************************************************************************************************
+// rdsTask(): RDS Task main loop. Holds the QN8027 lock while it works, see radioLock().
+static void rdsTask(void *param)
+{
+    for (;;) {
+        radioLock();
+        processRDS();
+        radioUnlock();
+        vTaskDelay(pdMS_TO_TICKS(RDS_TASK_TIME));
+    }
+}
+
+// ************************************************************************************************
+// initRdsTask(): Create the RDS Job Queue and start the RDS Task. Call once, after initRadioChip().
+void initRdsTask(void)
+{
+    rdsJobQueue   = xQueueCreate(RDS_JOB_QUEUE_CNT, sizeof(rdsJob_t));
+    rdsLocalQueue = xQueueCreate(1, sizeof(rdsLocalJob_t));
+
+    if ((rdsJobQueue == NULL) || (rdsLocalQueue == NULL)) {
+        Log.errorln("-> initRdsTask: Can't Create RDS Job Queue.");
+        return;
+    }
+    postRdsLocalJob(); // First Local job, ready before the RDS Task starts.
+
+    if (xTaskCreatePinnedToCore(rdsTask, "RDS", RDS_TASK_STACK_SZ, NULL, RDS_TASK_PRIORITY, NULL, RDS_TASK_CORE) != pdPASS) {
+        Log.errorln("-> initRdsTask: Can't Start RDS Task.");
+    }
+    else {
+        Log.infoln("RDS Task Started.");
+    }
+}
+
+// ************************************************************************************************
+// resetControllerRdsValues(): Reset the Local and remote Controllers' RDS Initial
 // Runtime Values. These values can be changed by Serial/MQTT/HTTP controller commands.
 // Call this function during boot, after restoreConfiguration().
 void resetControllerRdsValues(void)
@@ -415,26 +775,28 @@ void resetControllerRdsValues(void)
     radio.setPiCode(rdsLocalPiCode);    // Default RDS PI Code.
     radio.setPtyCode(rdsLocalPtyCode);  // Default RDS PTY Code.
 
-    // USB Serial RDS Controller. All values can be changed during runtime by Serial Commands.
-    rdsSerialPsnStr  = rdsLocalPsnStr;  // Default Program Service Name (Mimic Local Controller).
-    rdsSerialTextStr = "";              // Clear Controller's RadioText Message.
-    rdsSerialPiCode  = rdsLocalPiCode;  // Default PI Code (Mimic Local Controller).
-    rdsSerialPtyCode = rdsLocalPtyCode; // Default PTY Code (Mimic Local Controller).
-    rdsSerialMsgTime = rdsLocalMsgTime; // Default RDS Message Time (Mimic Local Controller),
-
-    // MQTT RDS Controller. All values can be changed during runtime by MQTT Commands.
-    rdsMqttPsnStr  = rdsLocalPsnStr;    // Default Program Service Name (Mimic Local Controller).
-    rdsMqttTextStr = "";                // Clear Controller's RadioText Message.
-    rdsMqttPiCode  = rdsLocalPiCode;    // Default PI Code (Mimic Local Controller).
-    rdsMqttPtyCode = rdsLocalPtyCode;   // Default PTY Code (Mimic Local Controller).
-    rdsMqttMsgTime = rdsLocalMsgTime;   // Default RDS Message Time (Mimic Local Controller),
-
-    // HTTP RDS Controller. All values can be changed during runtime by HTTP Commands.
-    rdsHttpPsnStr  = rdsLocalPsnStr;    // Default Program Service Name (Mimic Local Controller).
-    rdsHttpTextStr = "";                // Clear Controller's RadioText Message.
-    rdsHttpPiCode  = rdsLocalPiCode;    // Default PI Code (Mimic Local Controller).
-    rdsHttpPtyCode = rdsLocalPtyCode;   // Default PTY Code (Mimic Local Controller).
-    rdsHttpMsgTime = rdsLocalMsgTime;   // Default RDS Message Time (Mimic Local Controller),
+    // Remote RDS Controllers. All values can be changed during runtime by Controller Commands.
+    for (uint8_t i = 0; i < RDS_CNTRL_CNT; i++) {
+        *rdsCntrls[i].psnStr  = rdsLocalPsnStr;  // Default Program Service Name (Mimic Local Controller).
+        *rdsCntrls[i].textStr = "";              // Clear Controller's RadioText Message.
+        *rdsCntrls[i].piCode  = rdsLocalPiCode;  // Default PI Code (Mimic Local Controller).
+        *rdsCntrls[i].ptyCode = rdsLocalPtyCode; // Default PTY Code (Mimic Local Controller).
+        *rdsCntrls[i].msgTime = rdsLocalMsgTime; // Default RDS Message Time (Mimic Local Controller),
+    }
+}
+
+// ************************************************************************************************
+// resetRdsScheduler(): Discard queued RDS groups and restart the group sequence at the first PSN
+// segment. Call this when a new message is loaded so it goes on-air immediately. The RadioText
+// segment order is kept by the radio so that only changed segments are hurried out.
+void resetRdsScheduler(void)
+{
+    radio.clearRDSQueue();
+    schedSeqPos   = 0;
+    schedPsnSeg   = 0;
+    traceId       = 0; // Queued groups are gone, so is the trace's place in the sequence.
+    traceFirstCnt = 0;
+    traceLastCnt  = 0;
 }
 
 // ************************************************************************************************
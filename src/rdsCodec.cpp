@@ -0,0 +1,174 @@
+/*
+   File: rdsCodec.cpp
+   Project: PixelRadio, an RBDS/RDS FM Transmitter (QN8027 Digital FM IC)
+   Version: 1.1.2
+   Creation: Oct-18-2022
+   Revised:  Oct-18-2022
+   Revision History: See PixelRadio.cpp
+   Project Leader: T. Black (thomastech)
+   Contributors: thomastech
+
+   (c) copyright T. Black 2021-2022, Licensed under GNU GPL 3.0 and later, under this
+   license absolutely no warranty is given.
+   This Code was formatted with the uncrustify extension.
+
+   Note 1: The encoder computes checkwords with the generator polynomial. The decoder uses the
+           parity check matrix instead, so each one verifies the other.
+ */
+
+// *********************************************************************************************
+
+#include <string.h>
+#include "rdsCodec.h"
+
+// *********************************************************************************************
+
+// Parity Check Matrix rows, one per block bit (MSB first). Syndrome = XOR of rows of the set bits.
+static const uint16_t parityMatrix[RDS_BLOCK_BITS] = {
+    0x200, 0x100, 0x080, 0x040, 0x020, 0x010, 0x008, 0x004, 0x002, 0x001,
+    0x2DC, 0x16E, 0x0B7, 0x287, 0x39F, 0x313, 0x355, 0x376, 0x1BB, 0x201,
+    0x3DC, 0x1EE, 0x0F7, 0x2A7, 0x38F, 0x31B
+};
+
+static uint16_t crcTable[256]; // Byte-wise checkword table, built on first use.
+static bool     crcTableFlg = false;
+
+// *********************************************************************************************
+// crcShift(): Shift bitCnt data bits (MSB first) through the 10-bit checkword register.
+static uint16_t crcShift(uint16_t reg, uint16_t data, uint8_t bitCnt)
+{
+    for (int8_t i = bitCnt - 1; i >= 0; i--) {
+        bool fbFlg = ((reg >> 9) ^ (data >> i)) & 0x01;
+        reg = (reg << 1) & 0x3FF;
+
+        if (fbFlg) {
+            reg ^= RDS_CRC_POLY;
+        }
+    }
+    return reg;
+}
+
+// *********************************************************************************************
+// rdsCheckwordRef(): Bit-wise 10-bit checkword of a 16-bit information word (no offset).
+// Reference implementation for rdsCheckword().
+uint16_t rdsCheckwordRef(uint16_t info)
+{
+    return crcShift(0, info, 16);
+}
+
+// *********************************************************************************************
+// rdsCheckword(): Table driven 10-bit checkword of a 16-bit information word (no offset).
+uint16_t rdsCheckword(uint16_t info)
+{
+    uint16_t reg;
+
+    if (!crcTableFlg) {
+        for (uint16_t i = 0; i < 256; i++) {
+            crcTable[i] = crcShift(0, i, 8);
+        }
+        crcTableFlg = true;
+    }
+
+    reg = crcTable[info >> 8];
+    reg = ((reg << 8) & 0x3FF) ^ crcTable[((reg >> 2) ^ info) & 0xFF];
+    return reg;
+}
+
+// *********************************************************************************************
+// rdsEncodeBlock(): Return the 26-bit block (right justified) for the information word and
+// Offset Word.
+uint32_t rdsEncodeBlock(uint16_t info, uint16_t offset)
+{
+    return ((uint32_t)info << 10) | (rdsCheckword(info) ^ offset);
+}
+
+// *********************************************************************************************
+// rdsSyndrome(): Return the receiver syndrome of a 26-bit block (right justified).
+uint16_t rdsSyndrome(uint32_t block)
+{
+    uint16_t syndrome = 0;
+
+    for (uint8_t i = 0; i < RDS_BLOCK_BITS; i++) {
+        if (block & (1UL << (RDS_BLOCK_BITS - 1 - i))) {
+            syndrome ^= parityMatrix[i];
+        }
+    }
+    return syndrome;
+}
+
+// *********************************************************************************************
+// rdsEncodeGroup(): Encode an 8 byte Group (same layout as QN8027Radio::sendRDS()) into the
+// 104 bit on-air bitstream, packed MSB first into RDS_BITSTREAM_BYTES.
+void rdsEncodeGroup(const uint8_t *grp, uint8_t *bits)
+{
+    uint16_t info;
+    uint16_t offset;
+    uint32_t block;
+    uint8_t  bitPos = 0;
+
+    memset(bits, 0, RDS_BITSTREAM_BYTES);
+
+    for (uint8_t blk = 0; blk < RDS_GROUP_BLOCKS; blk++) {
+        info = (grp[blk * 2] << 8) | grp[blk * 2 + 1];
+
+        if (blk == 0) {
+            offset = RDS_OFFSET_A;
+        }
+        else if (blk == 1) {
+            offset = RDS_OFFSET_B;
+        }
+        else if (blk == 2) {
+            offset = (grp[2] & 0x08) ? RDS_OFFSET_CP : RDS_OFFSET_C; // B0 bit, version B uses C'.
+        }
+        else {
+            offset = RDS_OFFSET_D;
+        }
+        block = rdsEncodeBlock(info, offset);
+
+        for (int8_t i = RDS_BLOCK_BITS - 1; i >= 0; i--, bitPos++) {
+            if (block & (1UL << i)) {
+                bits[bitPos >> 3] |= 0x80 >> (bitPos & 0x07);
+            }
+        }
+    }
+}
+
+// *********************************************************************************************
+// rdsDecodeGroup(): Decode a 104 bit bitstream into an 8 byte Group. Returns a bit mask of the
+// blocks that failed the syndrome check (bit 0 = block A), zero if the Group is error free.
+// Errors are detected, not corrected.
+uint8_t rdsDecodeGroup(const uint8_t *bits, uint8_t *grp)
+{
+    uint8_t  errMask = 0;
+    uint8_t  bitPos  = 0;
+    uint16_t syndrome;
+    uint32_t block;
+
+    for (uint8_t blk = 0; blk < RDS_GROUP_BLOCKS; blk++) {
+        block = 0;
+
+        for (uint8_t i = 0; i < RDS_BLOCK_BITS; i++, bitPos++) {
+            block = (block << 1) | ((bits[bitPos >> 3] >> (7 - (bitPos & 0x07))) & 0x01);
+        }
+        grp[blk * 2]     = (block >> 18) & 0xFF;
+        grp[blk * 2 + 1] = (block >> 10) & 0xFF;
+        syndrome         = rdsSyndrome(block);
+
+        if (blk == 0) {
+            errMask |= (syndrome != RDS_SYNDROME_A) ? 0x01 : 0;
+        }
+        else if (blk == 1) {
+            errMask |= (syndrome != RDS_SYNDROME_B) ? 0x02 : 0;
+        }
+        else if (blk == 2) {
+            errMask |= (syndrome != ((grp[2] & 0x08) ? RDS_SYNDROME_CP : RDS_SYNDROME_C)) ? 0x04 : 0;
+        }
+        else {
+            errMask |= (syndrome != RDS_SYNDROME_D) ? 0x08 : 0;
+        }
+    }
+    return errMask;
+}
+
+// *********************************************************************************************
+// EOF
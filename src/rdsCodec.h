@@ -0,0 +1,59 @@
+/*
+   File: rdsCodec.h
+   Project: PixelRadio, an RBDS/RDS FM Transmitter (QN8027 Digital FM IC)
+   Version: 1.1.2
+   Creation: Oct-18-2022
+   Revised:  Oct-18-2022
+   Revision History: See PixelRadio.cpp
+   Project Leader: T. Black (thomastech)
+   Contributors: thomastech
+
+   (c) copyright T. Black 2021-2022, Licensed under GNU GPL 3.0 and later, under this
+   license absolutely no warranty is given.
+   This Code was formatted with the uncrustify extension.
+
+   Note 1: Software model of the RDS baseband coding the QN8027 performs internally (IEC 62106).
+           Each 16-bit information word gets a 10-bit checkword plus offset word (A, B, C/C', D).
+           A group is 4 blocks x 26 bits = 104 bits.
+   Note 2: Plain C++, no Arduino dependencies. It can be compiled on any host.
+           Tests and benchmark: test/test_rds_codec ([env:native]).
+ */
+
+// *********************************************************************************************
+
+#pragma once
+#include <stdint.h>
+
+// *********************************************************************************************
+
+const uint8_t  RDS_BLOCK_BITS      = 26;   // 16 Information bits + 10 Checkword bits.
+const uint8_t  RDS_GROUP_BLOCKS    = 4;    // Blocks per Group.
+const uint8_t  RDS_GROUP_BYTES     = 8;    // Group size as sent to QN8027 RDSD0-RDSD7.
+const uint8_t  RDS_BITSTREAM_BYTES = 13;   // 104 bit Group, packed MSB first.
+const uint16_t RDS_CRC_POLY        = 0x1B9; // g(x) = x^10 + x^8 + x^7 + x^5 + x^4 + x^3 + 1 (x^10 implied).
+
+// Offset Words, added (XOR) to the checkword of each block.
+const uint16_t RDS_OFFSET_A  = 0x0FC;
+const uint16_t RDS_OFFSET_B  = 0x198;
+const uint16_t RDS_OFFSET_C  = 0x168;
+const uint16_t RDS_OFFSET_CP = 0x350;      // C', block 3 of version B Groups.
+const uint16_t RDS_OFFSET_D  = 0x1B4;
+
+// Receiver syndromes of an error free block, one per Offset Word.
+const uint16_t RDS_SYNDROME_A  = 0x3D8;
+const uint16_t RDS_SYNDROME_B  = 0x3D4;
+const uint16_t RDS_SYNDROME_C  = 0x25C;
+const uint16_t RDS_SYNDROME_CP = 0x3CC;
+const uint16_t RDS_SYNDROME_D  = 0x258;
+
+// *********************************************************************************************
+
+uint16_t rdsCheckword(uint16_t info);
+uint16_t rdsCheckwordRef(uint16_t info);
+uint8_t  rdsDecodeGroup(const uint8_t *bits, uint8_t *grp);
+uint32_t rdsEncodeBlock(uint16_t info, uint16_t offset);
+void     rdsEncodeGroup(const uint8_t *grp, uint8_t *bits);
+uint16_t rdsSyndrome(uint32_t block);
+
+// *********************************************************************************************
+// EOF
@@ -19,6 +19,16 @@
     RBD_SerialManager.h files in the library with patched version stored in the
     /extras folder.
 
+    Binary Mode:
+    ============
+    Host software that sends commands at a high rate can switch to the Binary Mode by sending
+    the escape sequence <ESC>bin<CR>. Commands are then sent as COBS framed packets with a
+    CRC-16 and a sequence number, see serialFrame.h. Each command frame is answered with a
+    reply frame (the ack) that has the same Seq and the command's JSON reply. A repeated Seq is
+    a retry; the saved reply is sent again and the command is not run twice. The Serial Log is
+    silent while in Binary Mode. An EXIT frame, or SERIAL_BIN_IDLE_TIME without a good frame,
+    returns to the text CLI. A reference host client is in /extras/serialBinaryClient.py.
+
  */
 
 // ************************************************************************************************
@@ -28,6 +38,7 @@
 #include "language.h"
 #include "PixelRadio.h"
 #include "globals.h"
+#include "serialFrame.h"
 
 // ************************************************************************************************
 
@@ -36,6 +47,19 @@ RBD::SerialManager serial_manager;
 String cmdStr;   // Serial Port Commands from user (CLI).
 String paramStr; // Parameter string.
 
+// Binary Mode.
+static bool          binModeFlg  = false;
+static bool          binOverFlg  = false;          // Frame too long, discard it up to the next delimiter.
+static bool          binSeqFlg   = false;          // binLastSeq is valid.
+static uint8_t       binLastSeq  = 0;              // Seq of the last command frame that was run.
+static uint8_t       binReplyBuff[SFRAME_ENC_MAX]; // Reply frame of the last command, sent again for a retry.
+static uint8_t       binRxBuff[SFRAME_ENC_MAX];    // Frame being received, without the delimiter.
+static uint16_t      binReplyLen = 0;
+static uint16_t      binRxLen    = 0;
+static uint32_t      binErrCnt   = 0;              // Bad frames received.
+static uint32_t      binRxMicros = 0;              // First byte time of the frame, for the Command Latency Trace.
+static unsigned long binMillis   = 0;              // Last good frame time.
+
 // ================================================================================================
 // ctrlSerialFlg(): Return true if Serial Controller is Enabled, else false;
 bool ctrlSerialFlg(void) {
@@ -60,27 +84,136 @@ void initSerialControl(void)
 }
 
 // ================================================================================================
-// gpioSerialControl(): Serial handler for GPIO Commands.
-void gpioSerialControl(String paramStr, uint8_t pin)
+// serialBinaryStart(): Switch the Serial Controller to the Binary Mode. The Serial Log is silenced so
+// its text does not mix with the frames.
+static void serialBinaryStart(void)
+{
+    Log.infoln("Serial Controller Binary Mode Started, Serial Log is Silent.");
+    Serial.flush();
+    Log.begin(LOG_LEVEL_SILENT, &Serial);
+    Log.setShowLevel(false); // Do not show loglevel, we will do this in the prefix
+
+    binModeFlg = true;
+    binOverFlg = false;
+    binSeqFlg  = false;
+    binRxLen   = 0;
+    binErrCnt  = 0;
+    binMillis  = getClockMillis();
+}
+
+// ================================================================================================
+// serialBinaryStop(): Return the Serial Controller to the text CLI and restore the Serial Log.
+static void serialBinaryStop(void)
 {
-    bool successFlg = true;
-    char charBuff[60];
+    char logBuff[80];
+
+    binModeFlg = false;
+    Serial.flush();
+    Log.begin(getLogLevel(), &Serial);
+    Log.setShowLevel(false); // Do not show loglevel, we will do this in the prefix
+
+    sprintf(logBuff, "Serial Controller Binary Mode Ended (%u bad frames).", binErrCnt);
+    Log.infoln(logBuff);
+}
+
+// ================================================================================================
+// serialBinaryFrame(): Process one received frame (COBS encoded, without its delimiter) and send the
+// reply frame.
+static void serialBinaryFrame(uint8_t *frame, uint16_t len)
+{
+    char     cmdBuff[SFRAME_PAYLOAD_MAX + 1];
+    char     replyBuff[CMD_REPLY_MAX_SZ];
+    char    *argPtr;
+    int16_t  payloadLen;
+    uint8_t  replyFrame[SFRAME_ENC_MAX];
+    uint8_t  seq;
+    uint8_t  type;
+    const uint8_t    *payload;
+    const cmdEntry_t *cmd;
+
+    payloadLen = serialFrameParse(frame, len, &type, &seq, &payload);
+
+    if ((payloadLen < 0) || ((type != SFRAME_CMD) && (type != SFRAME_PING) && (type != SFRAME_EXIT))) {
+        binErrCnt++;
+        Serial.write(replyFrame, serialFrameBuild(SFRAME_NAK, 0, NULL, 0, replyFrame));
+        return;
+    }
+    binMillis = getClockMillis();
 
-    // sprintf(charBuff, "Serial Controller: Received GPIO Pin-%d Command", pin);
-    // Log.infoln(charBuff);
+    if (type != SFRAME_CMD) { // Ping or Exit, empty reply.
+        Serial.write(replyFrame, serialFrameBuild(type | SFRAME_REPLY, seq, NULL, 0, replyFrame));
 
-    successFlg = gpioCmd(paramStr, SERIAL_CNTRL, pin);
+        if (type == SFRAME_EXIT) {
+            serialBinaryStop();
+        }
+        return;
+    }
 
-    if (!successFlg) {
-        sprintf(charBuff, "{\"%s%d\": \"fail\"}", CMD_GPIO_STR, pin);
+    if (binSeqFlg && (seq == binLastSeq)) { // Host did not get the reply, send it again.
+        Serial.write(binReplyBuff, binReplyLen);
+        return;
     }
-    else if (paramStr == CMD_GPIO_READ_STR) {
-        sprintf(charBuff, "{\"%s%d\": \"%d\"}", CMD_GPIO_STR, pin, digitalRead(pin));
+
+    memcpy(cmdBuff, payload, payloadLen);
+    cmdBuff[payloadLen] = '\0';
+    argPtr              = strchr(cmdBuff, '=');
+
+    if (argPtr != NULL) {
+        *argPtr++ = '\0';
     }
     else {
-        sprintf(charBuff, "{\"%s%d\": \"ok\"}", CMD_GPIO_STR, pin);
+        argPtr = cmdBuff + payloadLen; // No argument, empty string.
+    }
+
+    if ((cmd = findCommand(cmdBuff, SERIAL_CNTRL)) != NULL) {
+        paramStr = argPtr;
+        paramStr.trim();
+        dispatchCommand(cmd, paramStr, SERIAL_CNTRL, replyBuff, binRxMicros);
+    }
+    else {
+        sprintf(replyBuff, "{\"cmd\": \"undefined\"}"); // JSON Fmt.
+    }
+
+    binReplyLen = serialFrameBuild(SFRAME_CMD | SFRAME_REPLY, seq, (const uint8_t *)replyBuff, strlen(replyBuff), binReplyBuff);
+    binLastSeq  = seq;
+    binSeqFlg   = true;
+    Serial.write(binReplyBuff, binReplyLen);
+}
+
+// ================================================================================================
+// serialBinaryService(): Binary Mode receiver. Reads all waiting bytes and processes each frame as its
+// zero delimiter arrives.
+static void serialBinaryService(void)
+{
+    uint8_t c;
+
+    while (binModeFlg && Serial.available()) {
+        c = Serial.read();
+
+        if (c == 0) { // Frame delimiter.
+            if (binOverFlg) {
+                binErrCnt++;
+            }
+            else if (binRxLen > 0) {
+                serialBinaryFrame(binRxBuff, binRxLen);
+            }
+            binRxLen   = 0;
+            binOverFlg = false;
+        }
+        else if (binRxLen < sizeof(binRxBuff)) {
+            if (binRxLen == 0) {
+                binRxMicros = micros();
+            }
+            binRxBuff[binRxLen++] = c;
+        }
+        else {
+            binOverFlg = true;
+        }
+    }
+
+    if (binModeFlg && (getClockMillis() - binMillis > SERIAL_BIN_IDLE_TIME)) {
+        serialBinaryStop();
     }
-    serial_manager.println(charBuff);
 }
 
 // ================================================================================================
@@ -88,13 +221,24 @@ void gpioSerialControl(String paramStr, uint8_t pin)
 // This is the Command Line Interface (CLI).
 void serialCommands(void)
 {
-    char printBuff[140 + sizeof(VERSION_STR) + STA_NAME_MAX_SZ];
+    char printBuff[CMD_REPLY_MAX_SZ];
+    const cmdEntry_t *cmd;
 
     if (!ctrlSerialFlg()) { // Serial Controller disabled, nothing to do. Exit.
+        if (binModeFlg) {
+            serialBinaryStop();
+        }
+        return;
+    }
+
+    if (binModeFlg) {
+        serialBinaryService();
         return;
     }
 
     if (serial_manager.onReceive()) { // Process any serial commands from user (CLI).
+        uint32_t rxMicros = micros();     // Command Latency Trace start.
+
         cmdStr = serial_manager.getCmd();
         cmdStr.trim();
         cmdStr.toLowerCase();
@@ -115,6 +259,8 @@ void serialCommands(void)
             serial_manager.println("**  SERIAL CONTROLLER COMMAND SUMMARY  **");
             serial_manager.println("=========================================");
             serial_manager.println(     " AUDIO MODE      : aud=mono : stereo");
+            serial_manager.println(     " BATCH COMMAND   : batch={\"freq\": 1011, \"mute\": \"off\"}");
+            serial_manager.println(     " BINARY MODE     : <ESC>bin (host software)");
 
             sprintf(printBuff, " FREQUENCY X10   : freq=%d <-> %d", FM_FREQ_MIN_X10, FM_FREQ_MAX_X10);
             serial_manager.println(                                          printBuff);
@@ -123,7 +269,7 @@ void serialCommands(void)
             serial_manager.println(" GPIO-23 CONTROL : gpio23=read : outhigh : outlow");
             serial_manager.println(" GPIO-33 CONTROL : gpio33=read : outhigh : outlow");
 
-            serial_manager.println(                   " INFORMATION     : info=system");
+            serial_manager.println(         " INFORMATION     : info=system : latency");
             serial_manager.println(                 " MUTE AUDIO      : mute=on : off");
 
             sprintf(printBuff, " PROG ID CODE    : pic=0x%04X <-> 0x%04X", RDS_PI_CODE_MIN, RDS_PI_CODE_MAX);
@@ -145,146 +291,12 @@ void serialCommands(void)
             serial_manager.println("=========================================");
             serial_manager.println(                                         "");
         }
-        else if (cmdStr == CMD_AUDMODE_STR) {
-            if (audioModeCmd(paramStr, SERIAL_CNTRL)) {
-                sprintf(printBuff, "{\"%s\": \"ok\"}", CMD_AUDMODE_STR);
-            }
-            else {
-                sprintf(printBuff, "{\"%s\": \"fail\"}", CMD_AUDMODE_STR);
-            }
-            serial_manager.println(printBuff);
-        }
-        else if (cmdStr == CMD_FREQ_STR) {
-            if (frequencyCmd(paramStr, SERIAL_CNTRL)) {
-                sprintf(printBuff, "{\"%s\": \"ok\"}", CMD_FREQ_STR);
-            }
-            else {
-                sprintf(printBuff, "{\"%s\": \"fail\"}", CMD_FREQ_STR);
-            }
-            serial_manager.println(printBuff);
-        }
-        else if (cmdStr == CMD_GPIO19_STR) {
-            gpioSerialControl(paramStr, GPIO19_PIN);
+        else if (cmdStr == SERIAL_BIN_ESC_STR) {
+            serialBinaryStart();
+            serial_manager.println("{\"binary\": \"ok\"}"); // JSON Fmt. Last text reply, frames follow.
         }
-        else if (cmdStr == CMD_GPIO23_STR) {
-            gpioSerialControl(paramStr, GPIO23_PIN);
-        }
-        else if (cmdStr == CMD_GPIO33_STR) {
-            gpioSerialControl(paramStr, GPIO33_PIN);
-        }
-        else if (cmdStr == CMD_INFO_STR) {
-            if (infoCmd(paramStr, SERIAL_CNTRL)) {
-                sprintf(printBuff,
-                        "{\"%s\": \"ok\", \"version\": \"%s\", \"hostName\": \"%s\", \"ip\": \"%s\", \"rssi\": %d, \"status\": \"0x%02X\"}",
-                        CMD_INFO_STR,
-                        VERSION_STR,
-                        staNameStr.c_str(),
-                        WiFi.localIP().toString().c_str(),
-                        WiFi.RSSI(),
-                        getControllerStatus());
-            }
-            else {
-                sprintf(printBuff, "{\"%s\": \"fail\"}", CMD_INFO_STR);
-            }
-            serial_manager.println(printBuff);
-        }
-        else if (cmdStr == SERIAL_LOG_STR) {
-            if (logCmd(paramStr, SERIAL_CNTRL)) {
-                sprintf(printBuff, "{\"%s\": \"ok\"}", SERIAL_LOG_STR);
-            }
-            else {
-                sprintf(printBuff, "{\"%s\": \"fail\"}", SERIAL_LOG_STR);
-            }
-            serial_manager.println(printBuff);
-        }
-        else if (cmdStr == CMD_MUTE_STR) {
-            if (muteCmd(paramStr, SERIAL_CNTRL)) {
-                sprintf(printBuff, "{\"%s\": \"ok\"}", CMD_MUTE_STR);
-            }
-            else {
-                sprintf(printBuff, "{\"%s\": \"fail\"}", CMD_MUTE_STR);
-            }
-            serial_manager.println(printBuff);
-        }
-        else if (cmdStr == CMD_PICODE_STR) {
-            if (piCodeCmd(paramStr, SERIAL_CNTRL)) {
-                sprintf(printBuff, "{\"%s\": \"ok\"}", CMD_PICODE_STR);
-            }
-            else {
-                sprintf(printBuff, "{\"%s\": \"fail\"}", CMD_PICODE_STR);
-            }
-            serial_manager.println(printBuff);
-        }
-        else if (cmdStr == CMD_PTYCODE_STR) {
-            if (ptyCodeCmd(paramStr, SERIAL_CNTRL)) {
-                sprintf(printBuff, "{\"%s\": \"ok\"}", CMD_PTYCODE_STR);
-            }
-            else {
-                sprintf(printBuff, "{\"%s\": \"fail\"}", CMD_PTYCODE_STR);
-            }
-            serial_manager.println(printBuff);
-        }
-        else if (cmdStr == CMD_PSN_STR) {
-            if (programServiceNameCmd(paramStr, SERIAL_CNTRL)) {
-                sprintf(printBuff, "{\"%s\": \"ok\"}", CMD_PSN_STR);
-            }
-            else {
-                sprintf(printBuff, "{\"%s\": \"fail\"}", CMD_PSN_STR);
-            }
-            serial_manager.println(printBuff);
-        }
-        else if (cmdStr == CMD_RADIOTEXT_STR) {
-            if (radioTextCmd(paramStr, SERIAL_CNTRL)) {
-                sprintf(printBuff, "{\"%s\": \"ok\"}", CMD_RADIOTEXT_STR);
-            }
-            else {
-                sprintf(printBuff, "{\"%s\": \"fail\"}", CMD_RADIOTEXT_STR);
-            }
-            serial_manager.println(printBuff);
-        }
-        else if (cmdStr == CMD_RF_CARRIER_STR) {
-            if (rfCarrierCmd(paramStr, SERIAL_CNTRL)) {
-                sprintf(printBuff, "{\"%s\": \"ok\"}", CMD_RF_CARRIER_STR);
-            }
-            else {
-                sprintf(printBuff, "{\"%s\": \"fail\"}", CMD_RF_CARRIER_STR);
-            }
-            serial_manager.println(printBuff);
-        }
-        else if (cmdStr == CMD_START_STR) {
-            if (startCmd(paramStr, SERIAL_CNTRL)) {
-                sprintf(printBuff, "{\"%s\": \"ok\"}", CMD_START_STR);
-            }
-            else {
-                sprintf(printBuff, "{\"%s\": \"fail\"}", CMD_START_STR);
-            }
-            serial_manager.println(printBuff);
-        }
-        else if (cmdStr == CMD_STOP_STR) {
-            if (stopCmd(paramStr, SERIAL_CNTRL)) {
-                sprintf(printBuff, "{\"%s\": \"ok\"}", CMD_STOP_STR);
-            }
-            else {
-                sprintf(printBuff, "{\"%s\": \"fail\"}", CMD_STOP_STR);
-            }
-            serial_manager.println(printBuff);
-        }
-        else if (cmdStr == CMD_PERIOD_STR) {
-            if (rdsTimePeriodCmd(paramStr, SERIAL_CNTRL)) {
-                sprintf(printBuff, "{\"%s\": \"ok\"}", CMD_PERIOD_STR);
-            }
-            else {
-                sprintf(printBuff, "{\"%s\": \"fail\"}", CMD_PERIOD_STR);
-            }
-            serial_manager.println(printBuff);
-        }
-        else if (cmdStr == CMD_REBOOT_STR) {
-            if (rebootCmd(paramStr, SERIAL_CNTRL)) {
-                sprintf(printBuff, "{\"%s\": \"ok\"}", CMD_REBOOT_STR);
-            }
-            else {
-                sprintf(printBuff, "{\"%s\": \"fail\"}", CMD_REBOOT_STR);
-            }
+        else if ((cmd = findCommand(cmdStr.c_str(), SERIAL_CNTRL)) != NULL) {
+            dispatchCommand(cmd, paramStr, SERIAL_CNTRL, printBuff, rxMicros);
             serial_manager.println(printBuff);
         }
         else {
@@ -0,0 +1,144 @@
+/*
+   File: serialFrame.cpp
+   Project: PixelRadio, an RBDS/RDS FM Transmitter (QN8027 Digital FM IC)
+   Version: 1.1.2
+   Creation: Oct-18-2022
+   Revised:  Oct-18-2022
+   Revision History: See PixelRadio.cpp
+   Project Leader: T. Black (thomastech)
+   Contributors: thomastech
+
+   (c) copyright T. Black 2021-2022, Licensed under GNU GPL 3.0 and later, under this
+   license absolutely no warranty is given.
+   This Code was formatted with the uncrustify extension.
+
+   Note 1: COBS (Consistent Overhead Byte Stuffing) replaces each zero byte with the distance to the
+           next one, so a zero byte can only be a frame delimiter. A receiver that starts mid-frame
+           (or sees Serial Log text) resyncs at the next zero byte, the CRC rejects the partial frame.
+ */
+
+// *********************************************************************************************
+
+#include <string.h>
+#include "serialFrame.h"
+
+// *********************************************************************************************
+// cobsDecode(): Decode a COBS block (no zero delimiter). dst may be src, decoding in place is safe.
+// Returns the decoded length, zero if the block is invalid.
+size_t cobsDecode(const uint8_t *src, size_t len, uint8_t *dst)
+{
+    size_t  dstLen = 0;
+    size_t  i      = 0;
+    uint8_t code;
+
+    while (i < len) {
+        code = src[i++];
+
+        if ((code == 0) || (i + code - 1 > len)) {
+            return 0;
+        }
+
+        for (uint8_t j = 1; j < code; j++) {
+            dst[dstLen++] = src[i++];
+        }
+
+        if ((code != 0xFF) && (i < len)) {
+            dst[dstLen++] = 0;
+        }
+    }
+    return dstLen;
+}
+
+// *********************************************************************************************
+// cobsEncode(): COBS encode len bytes into dst (len + len / 254 + 1 bytes max). The zero delimiter is
+// not added. Returns the encoded length.
+size_t cobsEncode(const uint8_t *src, size_t len, uint8_t *dst)
+{
+    size_t  codePos = 0;
+    size_t  dstLen  = 1;
+    uint8_t code    = 1;
+
+    for (size_t i = 0; i < len; i++) {
+        if (src[i] == 0) {
+            dst[codePos] = code;
+            codePos      = dstLen++;
+            code         = 1;
+            continue;
+        }
+        dst[dstLen++] = src[i];
+
+        if (++code == 0xFF) {
+            dst[codePos] = code;
+            codePos      = dstLen++;
+            code         = 1;
+        }
+    }
+    dst[codePos] = code;
+
+    return dstLen;
+}
+
+// *********************************************************************************************
+// crc16Ccitt(): CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF, no reflection). "123456789" = 0x29B1.
+uint16_t crc16Ccitt(const uint8_t *data, size_t len)
+{
+    uint16_t crc = SFRAME_CRC_INIT;
+
+    for (size_t i = 0; i < len; i++) {
+        crc ^= (uint16_t)data[i] << 8;
+
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x8000) ? (crc << 1) ^ SFRAME_CRC_POLY : crc << 1;
+        }
+    }
+    return crc;
+}
+
+// *********************************************************************************************
+// serialFrameBuild(): Build a frame, COBS encoded and zero terminated, into frame (SFRAME_ENC_MAX).
+// A payload longer than SFRAME_PAYLOAD_MAX is truncated. Returns the frame length.
+size_t serialFrameBuild(uint8_t type, uint8_t seq, const uint8_t *payload, size_t len, uint8_t *frame)
+{
+    uint8_t  raw[SFRAME_RAW_MAX];
+    uint16_t crc;
+    size_t   frameLen;
+
+    if (len > SFRAME_PAYLOAD_MAX) {
+        len = SFRAME_PAYLOAD_MAX;
+    }
+    raw[0] = type;
+    raw[1] = seq;
+
+    if (len > 0) {
+        memcpy(raw + 2, payload, len);
+    }
+    crc          = crc16Ccitt(raw, len + 2);
+    raw[len + 2] = crc >> 8;
+    raw[len + 3] = crc & 0xFF;
+
+    frameLen          = cobsEncode(raw, len + 4, frame);
+    frame[frameLen++] = 0;
+
+    return frameLen;
+}
+
+// *********************************************************************************************
+// serialFrameParse(): Decode a received frame in place (without its zero delimiter) and check its
+// CRC. payload points into frame. Returns the payload length, -1 if the frame is bad.
+int16_t serialFrameParse(uint8_t *frame, size_t len, uint8_t *type, uint8_t *seq, const uint8_t **payload)
+{
+    size_t rawLen = cobsDecode(frame, len, frame);
+
+    if ((rawLen < 4) || (rawLen > SFRAME_RAW_MAX) ||
+        (crc16Ccitt(frame, rawLen - 2) != ((frame[rawLen - 2] << 8) | frame[rawLen - 1]))) {
+        return -1;
+    }
+    *type    = frame[0];
+    *seq     = frame[1];
+    *payload = frame + 2;
+
+    return rawLen - 4;
+}
+
+// *********************************************************************************************
+// EOF
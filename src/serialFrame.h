@@ -0,0 +1,51 @@
+/*
+   File: serialFrame.h
+   Project: PixelRadio, an RBDS/RDS FM Transmitter (QN8027 Digital FM IC)
+   Version: 1.1.2
+   Creation: Oct-18-2022
+   Revised:  Oct-18-2022
+   Revision History: See PixelRadio.cpp
+   Project Leader: T. Black (thomastech)
+   Contributors: thomastech
+
+   (c) copyright T. Black 2021-2022, Licensed under GNU GPL 3.0 and later, under this
+   license absolutely no warranty is given.
+   This Code was formatted with the uncrustify extension.
+
+   Note 1: Binary Serial Controller frames. A frame is Type (1 byte), Seq (1 byte), Payload (0 to
+           SFRAME_PAYLOAD_MAX bytes) and a CRC-16 (CCITT-FALSE, high byte first) of the other bytes.
+           The frame is COBS encoded, so it has no zero bytes, and ends with a zero byte.
+   Note 2: Plain C++, no Arduino dependencies. It can be compiled on any host, see test/test_serial_frame.
+ */
+
+// *********************************************************************************************
+
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+// *********************************************************************************************
+
+const uint16_t SFRAME_PAYLOAD_MAX = 340;                               // Payload max size ("batch=" + JSON object).
+const uint16_t SFRAME_RAW_MAX     = SFRAME_PAYLOAD_MAX + 4;            // Type + Seq + Payload + CRC.
+const uint16_t SFRAME_ENC_MAX     = SFRAME_RAW_MAX + SFRAME_RAW_MAX / 254 + 2; // COBS overhead + zero delimiter.
+const uint16_t SFRAME_CRC_INIT    = 0xFFFF;
+const uint16_t SFRAME_CRC_POLY    = 0x1021;                            // x^16 + x^12 + x^5 + 1.
+
+// Frame Types. A reply has the request's type with the high bit set, and the request's Seq.
+const uint8_t SFRAME_CMD   = 0x01;                                     // Payload is a command, "<cmd>=<arg>".
+const uint8_t SFRAME_PING  = 0x02;                                     // No payload, check the link.
+const uint8_t SFRAME_EXIT  = 0x03;                                     // Return to the text CLI.
+const uint8_t SFRAME_REPLY = 0x80;                                     // Reply flag. Payload is the JSON reply.
+const uint8_t SFRAME_NAK   = 0xFF;                                     // Bad frame received (CRC or format), Seq is zero.
+
+// *********************************************************************************************
+
+size_t   cobsDecode(const uint8_t *src, size_t len, uint8_t *dst);
+size_t   cobsEncode(const uint8_t *src, size_t len, uint8_t *dst);
+uint16_t crc16Ccitt(const uint8_t *data, size_t len);
+size_t   serialFrameBuild(uint8_t type, uint8_t seq, const uint8_t *payload, size_t len, uint8_t *frame);
+int16_t  serialFrameParse(uint8_t *frame, size_t len, uint8_t *type, uint8_t *seq, const uint8_t **payload);
+
+// *********************************************************************************************
+// EOF
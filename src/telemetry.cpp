@@ -0,0 +1,348 @@
+/*
+   File: telemetry.cpp
+   Project: PixelRadio, an RBDS/RDS FM Transmitter (QN8027 Digital FM IC)
+   Version: 1.1.2
+   Creation: Oct-18-2022
+   Revised:  Oct-18-2022
+   Revision History: See PixelRadio.cpp
+   Project Leader: T. Black (thomastech)
+   Contributors: thomastech
+
+   (c) copyright T. Black 2021-2022, Licensed under GNU GPL 3.0 and later, under this
+   license absolutely no warranty is given.
+   This Code was formatted with the uncrustify extension.
+
+   Note 1: Offline Telemetry. While the MQTT Controller is enabled but not connected (WiFi or broker is down), the
+           power supply voltages, the audio peak level and the controller commands are saved as time stamped records.
+           After mqttReconnect() connects they are published to "<name>/telemetry", oldest first.
+   Note 2: The records are kept in a RAM ring (TLM_RING_CNT). If TLM_SPILL_ENB is defined in config.h, the oldest records
+           are moved to a LittleFS file (TLM_FILE_NAME) when the ring fills up. When the file is full (TLM_FILE_MAX_SZ)
+           the records that would be spilled are dropped, so the start and the end of a long outage are both kept.
+           The file is deleted at boot, the record times are only valid until a reboot.
+   Note 3: The replay sends one message (TLM_REPLAY_CNT records) per TLM_REPLAY_TIME, and only when the MQTT Publish
+           Queue is empty, so live messages always go first.
+   Note 4: logTelemetryCmd() is called by dispatchCommand(), which runs in the controller tasks. The ring is guarded by
+           tlmMux. Everything else runs in the loop() task.
+ */
+
+// *************************************************************************************************************************
+
+#include <Arduino.h>
+#include <ArduinoLog.h>
+#include <LittleFS.h>
+#include <WiFi.h>
+#include "config.h"
+#include "PixelRadio.h"
+#include "globals.h"
+
+// *************************************************************************************************************************
+#ifdef MQTT_ENB
+
+// Telemetry Record Types.
+static const uint8_t TLM_TYPE_MEAS    = 1; // Measurements: vbat and pa (Volts x10), audio peak (mV).
+static const uint8_t TLM_TYPE_CMD     = 2; // Controller command: arg is the Controller ID, values[0] the command index.
+static const uint8_t TLM_TYPE_OFFLINE = 3; // MQTT went offline: values[0] is 1 if WiFi was still connected.
+
+typedef struct {
+    uint32_t millis;                       // Record time, millis().
+    uint8_t  type;                         // TLM_TYPE_MEAS, etc.
+    uint8_t  arg;
+    uint16_t values[3];
+} tlmRec_t;
+
+static_assert(sizeof(tlmRec_t) == 12, "tlmRec_t must not have padding, it is saved in the spill file.");
+static_assert(MQTT_PUB_PAYLD_SZ >= 40 + TLM_REPLAY_CNT * 40, "MQTT_PUB_PAYLD_SZ must hold a telemetry replay message.");
+
+static portMUX_TYPE  tlmMux = portMUX_INITIALIZER_UNLOCKED;
+static tlmRec_t      tlmRing[TLM_RING_CNT];          // Guarded by tlmMux.
+static uint8_t       tlmHead     = 0;                // Oldest record, guarded by tlmMux.
+static uint8_t       tlmCnt      = 0;                // Guarded by tlmMux.
+static uint32_t      tlmDropCnt  = 0;                // Records lost (ring or spill file full), guarded by tlmMux.
+static volatile bool tlmRecordFlg = false;           // MQTT Controller is enabled and offline, save records.
+static bool          tlmReplayFlg = false;           // Replay the saved records.
+static uint16_t      tlmAudioPeak = 0;               // Highest audio peak since the last measurement record, in mV.
+static uint32_t      tlmFileSize  = 0;               // Spill file size, in bytes.
+static uint32_t      tlmFilePos   = 0;               // Spill file replay position, in bytes.
+
+// *************************************************************************************************************************
+// addTelemetry(): Add a record to the RAM ring. The oldest record is dropped if the ring is full.
+static void addTelemetry(uint8_t type, uint8_t arg, uint16_t value0, uint16_t value1, uint16_t value2)
+{
+    tlmRec_t *rec;
+
+    portENTER_CRITICAL(&tlmMux);
+
+    if (tlmCnt >= TLM_RING_CNT) {
+        tlmHead = (tlmHead + 1) % TLM_RING_CNT;
+        tlmCnt--;
+        tlmDropCnt++;
+    }
+    rec            = &tlmRing[(tlmHead + tlmCnt++) % TLM_RING_CNT];
+    rec->millis    = millis();
+    rec->type      = type;
+    rec->arg       = arg;
+    rec->values[0] = value0;
+    rec->values[1] = value1;
+    rec->values[2] = value2;
+
+    portEXIT_CRITICAL(&tlmMux);
+}
+
+// *************************************************************************************************************************
+// takeTelemetry(): Remove up to maxCnt of the oldest records from the RAM ring. Returns the number of records.
+static uint8_t takeTelemetry(tlmRec_t *recs, uint8_t maxCnt)
+{
+    uint8_t cnt = 0;
+
+    portENTER_CRITICAL(&tlmMux);
+
+    for (; (cnt < maxCnt) && (tlmCnt > 0); cnt++) {
+        recs[cnt] = tlmRing[tlmHead];
+        tlmHead   = (tlmHead + 1) % TLM_RING_CNT;
+        tlmCnt--;
+    }
+    portEXIT_CRITICAL(&tlmMux);
+
+    return cnt;
+}
+
+// *************************************************************************************************************************
+// getTelemetryCnt(): Return the number of records waiting for replay (spill file and RAM ring).
+static uint32_t getTelemetryCnt(void)
+{
+    uint8_t ringCnt;
+
+    portENTER_CRITICAL(&tlmMux);
+    ringCnt = tlmCnt;
+    portEXIT_CRITICAL(&tlmMux);
+
+    return (tlmFileSize - tlmFilePos) / sizeof(tlmRec_t) + ringCnt;
+}
+
+// *************************************************************************************************************************
+// spillTelemetry(): Move the oldest TLM_SPILL_CNT records to the spill file when the RAM ring is 3/4 full. They are
+// dropped if the spill file is full.
+static void spillTelemetry(void)
+{
+    #ifdef TLM_SPILL_ENB
+    char     logBuff[80];
+    uint8_t  cnt;
+    File     file;
+    tlmRec_t recs[TLM_SPILL_CNT];
+
+    portENTER_CRITICAL(&tlmMux);
+    cnt = tlmCnt;
+    portEXIT_CRITICAL(&tlmMux);
+
+    if (cnt < TLM_RING_CNT - TLM_RING_CNT / 4) {
+        return;
+    }
+    cnt = takeTelemetry(recs, TLM_SPILL_CNT);
+
+    if (tlmFileSize + cnt * sizeof(tlmRec_t) <= TLM_FILE_MAX_SZ) {
+        file = LittleFS.open(TLM_FILE_NAME, FILE_APPEND);
+
+        if (file) {
+            tlmFileSize += file.write((const uint8_t *)recs, cnt * sizeof(tlmRec_t));
+            file.close();
+            return;
+        }
+        Log.errorln("-> spillTelemetry: Can't Open Telemetry File.");
+    }
+
+    portENTER_CRITICAL(&tlmMux);
+    tlmDropCnt += cnt;
+    portEXIT_CRITICAL(&tlmMux);
+
+    sprintf(logBuff, "-> Telemetry File Full, %u Offline Telemetry Records Dropped.", cnt);
+    Log.warningln(logBuff);
+    #endif // ifdef TLM_SPILL_ENB
+}
+
+// *************************************************************************************************************************
+// readTelemetryFile(): Read up to maxCnt of the oldest records from the spill file. The file is deleted once all of it
+// has been read. Returns the number of records.
+static uint8_t readTelemetryFile(tlmRec_t *recs, uint8_t maxCnt)
+{
+    uint8_t cnt = 0;
+
+    #ifdef TLM_SPILL_ENB
+    File file;
+
+    if (tlmFilePos >= tlmFileSize) {
+        return 0;
+    }
+    file = LittleFS.open(TLM_FILE_NAME, FILE_READ);
+
+    if (file && file.seek(tlmFilePos)) {
+        cnt = file.read((uint8_t *)recs, maxCnt * sizeof(tlmRec_t)) / sizeof(tlmRec_t);
+    }
+
+    if (file) {
+        file.close();
+    }
+    tlmFilePos += cnt * sizeof(tlmRec_t);
+
+    if ((cnt == 0) || (tlmFilePos >= tlmFileSize)) { // Done, or unreadable.
+        LittleFS.remove(TLM_FILE_NAME);
+        tlmFileSize = 0;
+        tlmFilePos  = 0;
+    }
+    #endif // ifdef TLM_SPILL_ENB
+
+    return cnt;
+}
+
+// *************************************************************************************************************************
+// replayTelemetry(): Publish the next batch of saved records.
+// Example: {"replay": [[95, "offline", "broker"], [90, "meas", 5.0, 9.1, 450], [42, "cmd", "UDP", "rtm"]], "left": 12}
+//          The first value of each record is its age, in seconds.
+// Returns false if there are no records left.
+static bool replayTelemetry(void)
+{
+    char      payloadBuff[MQTT_PUB_PAYLD_SZ];
+    char      topicBuff[MQTT_NAME_TOPIC_SZ];
+    char     *buffPtr = payloadBuff;
+    uint8_t   cnt;
+    uint32_t  ageSecs;
+    tlmRec_t  recs[TLM_REPLAY_CNT];
+    const cmdEntry_t *cmd;
+
+    cnt = readTelemetryFile(recs, TLM_REPLAY_CNT);
+    cnt += takeTelemetry(recs + cnt, TLM_REPLAY_CNT - cnt);
+
+    if (cnt == 0) {
+        return false;
+    }
+    buffPtr += sprintf(buffPtr, "{\"replay\": [");
+
+    for (uint8_t i = 0; i < cnt; i++) {
+        ageSecs  = (millis() - recs[i].millis) / MSECS_PER_SEC;
+        buffPtr += sprintf(buffPtr, "%s[%u, ", i ? ", " : "", ageSecs);
+
+        if (recs[i].type == TLM_TYPE_MEAS) {
+            buffPtr += sprintf(buffPtr, "\"meas\", %0.1f, %0.1f, %u]",
+                               recs[i].values[0] / 10.0f, recs[i].values[1] / 10.0f, recs[i].values[2]);
+        }
+        else if (recs[i].type == TLM_TYPE_CMD) {
+            cmd      = getCommand(recs[i].values[0]);
+            buffPtr += sprintf(buffPtr, "\"cmd\", \"%s\", \"%s\"]",
+                               getControllerName(recs[i].arg).c_str(), cmd ? cmd->nameStr : "");
+        }
+        else {
+            buffPtr += sprintf(buffPtr, "\"offline\", \"%s\"]", recs[i].values[0] ? "broker" : "wifi");
+        }
+    }
+    sprintf(buffPtr, "], \"left\": %u}", getTelemetryCnt());
+
+    snprintf(topicBuff, sizeof(topicBuff), "%s%s", mqttNameStr.c_str(), MQTT_TLM_STR);
+    mqttPublish(topicBuff, payloadBuff, false, false); // Each replay message is kept.
+
+    return true;
+}
+
+#endif // ifdef MQTT_ENB
+
+// *************************************************************************************************************************
+// initTelemetry(): Delete the spill file left by the previous boot, its record times are no longer valid.
+void initTelemetry(void)
+{
+    #if defined(MQTT_ENB) && defined(TLM_SPILL_ENB)
+
+    if (LittleFS.exists(TLM_FILE_NAME)) {
+        LittleFS.remove(TLM_FILE_NAME);
+        Log.verboseln("-> Deleted Old Offline Telemetry File.");
+    }
+    #endif // if defined(MQTT_ENB) && defined(TLM_SPILL_ENB)
+}
+
+// *************************************************************************************************************************
+// logTelemetryCmd(): Save a controller command while the MQTT Controller is offline. cmdIndex is the getCommand() index.
+void logTelemetryCmd(uint8_t controller, uint8_t cmdIndex)
+{
+    #ifdef MQTT_ENB
+
+    if (tlmRecordFlg) {
+        addTelemetry(TLM_TYPE_CMD, controller, cmdIndex, 0, 0);
+    }
+    #endif // ifdef MQTT_ENB
+}
+
+// *************************************************************************************************************************
+// processTelemetry(): Offline Telemetry Handler, see Note 1. Call it from the main loop after processMQTT().
+void processTelemetry(void)
+{
+    #ifdef MQTT_ENB
+    static bool oldOnlineFlg = false;
+    static unsigned long replayMillis = 0;
+    static unsigned long sampleMillis = 0;
+    uint32_t dropCnt;
+    uint32_t mergeCnt;
+
+    tlmRecordFlg = ctrlMqttFlg && !mqttOnlineFlg;
+
+    if (tlmRecordFlg && oldOnlineFlg) {
+        addTelemetry(TLM_TYPE_OFFLINE, 0, WiFi.status() == WL_CONNECTED, 0, 0);
+    }
+    oldOnlineFlg = mqttOnlineFlg;
+
+    if (millis() - sampleMillis >= TLM_SAMPLE_TIME) {
+        sampleMillis = millis();
+
+        if (tlmRecordFlg) {
+            addTelemetry(TLM_TYPE_MEAS, 0, (uint16_t)(vbatVolts * 10.0f + 0.5f), (uint16_t)(paVolts * 10.0f + 0.5f), tlmAudioPeak);
+        }
+        tlmAudioPeak = 0;
+    }
+    spillTelemetry();
+
+    if (tlmReplayFlg && mqttOnlineFlg && (millis() - replayMillis >= TLM_REPLAY_TIME) &&
+        (getMqttPubStats(&dropCnt, &mergeCnt) == 0)) { // Live messages first.
+        replayMillis = millis();
+
+        if (!replayTelemetry()) {
+            tlmReplayFlg = false;
+            Log.infoln("-> Offline Telemetry Replay Complete.");
+        }
+    }
+    #endif // ifdef MQTT_ENB
+}
+
+// *************************************************************************************************************************
+// setTelemetryAudio(): Report an audio peak measurement (mV). The highest peak is saved in the next measurement record.
+void setTelemetryAudio(uint16_t mV)
+{
+    #ifdef MQTT_ENB
+
+    if (mV > tlmAudioPeak) {
+        tlmAudioPeak = mV;
+    }
+    #endif // ifdef MQTT_ENB
+}
+
+// *************************************************************************************************************************
+// startTelemetryReplay(): The MQTT Controller has connected, start the replay of the offline records. Called by
+// mqttReconnect().
+void startTelemetryReplay(void)
+{
+    #ifdef MQTT_ENB
+    char     logBuff[80];
+    uint32_t dropCnt;
+
+    tlmRecordFlg = false; // Online now, don't wait for processTelemetry() to stop the recording.
+
+    portENTER_CRITICAL(&tlmMux);
+    dropCnt    = tlmDropCnt;
+    tlmDropCnt = 0;
+    portEXIT_CRITICAL(&tlmMux);
+
+    if (getTelemetryCnt() > 0) {
+        sprintf(logBuff, "-> Replaying %u Offline Telemetry Records (%u Dropped).", getTelemetryCnt(), dropCnt);
+        Log.infoln(logBuff);
+        tlmReplayFlg = true;
+    }
+    #endif // ifdef MQTT_ENB
+}
+
+// *************************************************************************************************************************
+// EOF
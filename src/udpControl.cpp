@@ -0,0 +1,250 @@
+/*
+   File: udpControl.cpp
+   Project: PixelRadio, an RBDS/RDS FM Transmitter (QN8027 Digital FM IC)
+   Version: 1.1.2
+   Creation: Oct-18-2022
+   Revised:  Oct-18-2022
+   Revision History: See PixelRadio.cpp
+   Project Leader: T. Black (thomastech)
+   Contributors: thomastech
+
+   (c) copyright T. Black 2021-2022, Licensed under GNU GPL 3.0 and later, under this
+   license absolutely no warranty is given.
+   This Code was formatted with the uncrustify extension.
+
+   Note 1: The UDP Controller is for show control software (such as Falcon Player) that needs RadioText
+           in step with the show. One datagram is one command: "<seq> <cmd>=<arg>", for example
+           "42 rtm=Jingle Bells". The reply is sent back to the sender as "<seq> <JSON reply>".
+   Note 2: seq is a 32-bit sequence number that must increase with each command. A datagram with a
+           duplicate or older seq (late or repeated by the network) is dropped. Send seq 0 to restart
+           the count; A sender that has been quiet for UDP_SEQ_RESET_TIME may also restart it.
+   Note 3: The UDP port is 8081 (UDP_PORT). Test from a PC with: echo -n "1 info=system" | nc -u -w1 <ip> 8081
+ */
+
+// *********************************************************************************************
+
+#include <ArduinoLog.h>
+#include <AsyncUDP.h>
+#include "config.h"
+#include "PixelRadio.h"
+#include "globals.h"
+
+// *********************************************************************************************
+
+static uint32_t staleCnt = 0; // Datagrams dropped for a duplicate or old sequence number.
+
+#ifdef UDP_ENB
+
+// Command Sender, one per sender address and port.
+typedef struct {
+    uint32_t      addr;       // Sender's IP Address, zero if entry is unused.
+    uint16_t      port;
+    uint32_t      lastSeq;    // Sequence number of the last accepted command.
+    unsigned long lastMillis; // Time of the last accepted command.
+} udpSender_t;
+
+// Received Datagram. Copied by the AsyncUDP task and queued for the UDP Task, which runs the command.
+typedef struct {
+    uint32_t addr;
+    uint16_t port;
+    uint32_t rxMicros;                           // Command Latency Trace start.
+    char     data[UDP_PKT_MAX_SZ + 1];
+} udpPkt_t;
+
+AsyncUDP udpServer;
+
+static QueueHandle_t udpPktQueue = NULL;
+static udpSender_t   udpSenders[UDP_SENDER_MAX]; // Owned by the UDP Task.
+
+#endif // ifdef UDP_ENB
+
+// *********************************************************************************************
+// getUdpStaleCnt(): Return the number of UDP Controller commands dropped for a stale sequence number.
+uint32_t getUdpStaleCnt(void)
+{
+    return staleCnt;
+}
+
+#ifdef UDP_ENB
+
+// *********************************************************************************************
+// udpCheckSeq(): Check the sequence number of a sender's command. Returns true if the command is newer
+// than the sender's last command (and saves it), false if it is a duplicate or older. A new sender
+// takes the table entry of the sender that has been quiet the longest.
+static bool udpCheckSeq(udpSender_t *senders, uint32_t addr, uint16_t port, uint32_t seq, unsigned long currentMillis)
+{
+    udpSender_t *oldest = &senders[0];
+    udpSender_t *sender = NULL;
+
+    for (uint8_t i = 0; i < UDP_SENDER_MAX; i++) {
+        if ((senders[i].addr == addr) && (senders[i].port == port)) {
+            sender = &senders[i];
+            break;
+        }
+        else if (currentMillis - senders[i].lastMillis > currentMillis - oldest->lastMillis) {
+            oldest = &senders[i];
+        }
+    }
+
+    if (sender == NULL) {
+        sender       = oldest;
+        sender->addr = addr;
+        sender->port = port;
+    }
+    else if ((seq != 0) && (currentMillis - sender->lastMillis < UDP_SEQ_RESET_TIME) &&
+             ((int32_t)(seq - sender->lastSeq) <= 0)) { // Wrap safe compare.
+        return false;
+    }
+    sender->lastSeq    = seq;
+    sender->lastMillis = currentMillis;
+
+    return true;
+}
+
+// *********************************************************************************************
+// udpParseDatagram(): Split a command datagram ("<seq> <cmd>=<arg>") in place. cmdStr and argStr point
+// into the datagram. Returns false if the datagram is not in this format.
+static bool udpParseDatagram(char *data, uint32_t *seq, char **cmdStr, char **argStr)
+{
+    char *endPtr;
+    char *eqPtr;
+
+    if (!isdigit(*data)) {
+        return false;
+    }
+    *seq = strtoul(data, &endPtr, 10);
+
+    if (*endPtr != ' ') {
+        return false;
+    }
+
+    while (*endPtr == ' ') {
+        endPtr++;
+    }
+    eqPtr = strchr(endPtr, '=');
+
+    if ((eqPtr == NULL) || (eqPtr == endPtr)) {
+        return false;
+    }
+    *eqPtr  = '\0';
+    *cmdStr = endPtr;
+    *argStr = eqPtr + 1;
+
+    return true;
+}
+
+// *********************************************************************************************
+// processUdpCommand(): Run a received command datagram and reply to the sender. Runs in the UDP Task.
+static void processUdpCommand(udpPkt_t *pkt)
+{
+    char  logBuff[80];
+    char  replyBuff[CMD_REPLY_MAX_SZ + 12]; // Room for "<seq> ".
+    char *argStr;
+    char *cmdStr;
+    char *jsonPtr;
+    uint32_t seq;
+    const cmdEntry_t *cmd;
+
+    if (!udpParseDatagram(pkt->data, &seq, &cmdStr, &argStr)) {
+        Log.errorln("-> UDP CMD: Invalid Datagram Format, Ignored.");
+        return;
+    }
+
+    if (!udpCheckSeq(udpSenders, pkt->addr, pkt->port, seq, getClockMillis())) {
+        staleCnt++;
+        sprintf(logBuff, "-> UDP CMD: Stale Sequence Number (%u), Dropped.", seq);
+        Log.verboseln(logBuff);
+        return;
+    }
+
+    jsonPtr = replyBuff + sprintf(replyBuff, "%u ", seq);
+    cmd     = findCommand(cmdStr, UDP_CNTRL);
+
+    if (cmd == NULL) {
+        Log.errorln("-> UDP CMD: COMMAND IS UNDEFINED");
+        strcpy(jsonPtr, "{\"cmd\": \"undefined\"}"); // JSON Fmt.
+    }
+    else if (getCommandArg(argStr, cmd->maxSize) == -1) {
+        sprintf(logBuff, "-> UDP CMD: %s, Missing Value (abort).", cmd->logStr);
+        Log.errorln(logBuff);
+        cmd->replyFn(jsonPtr, cmd, false, "");
+    }
+    else {
+        sprintf(logBuff, "-> UDP CMD: %s (seq %u)", cmd->logStr, seq);
+        Log.verboseln(logBuff);
+        dispatchCommand(cmd, argStr, UDP_CNTRL, jsonPtr, pkt->rxMicros);
+    }
+
+    udpServer.writeTo((const uint8_t *)replyBuff, strlen(replyBuff), IPAddress(pkt->addr), pkt->port);
+}
+
+// *********************************************************************************************
+// udpPacket(): AsyncUDP receive handler, runs in the AsyncUDP task. Queues the datagram for the UDP Task.
+static void udpPacket(void *arg, AsyncUDPPacket& packet)
+{
+    udpPkt_t pkt;
+    size_t   len = packet.length();
+
+    if (!ctrlUdpFlg) {
+        return; // UDP Controller disabled, ignore.
+    }
+
+    if (len > UDP_PKT_MAX_SZ) {
+        Log.warningln("-> UDP CMD: Datagram Too Long, Ignored.");
+        return;
+    }
+    memcpy(pkt.data, packet.data(), len);
+    pkt.data[len] = '\0';
+    pkt.addr      = packet.remoteIP();
+    pkt.port      = packet.remotePort();
+    pkt.rxMicros  = micros();
+
+    if (xQueueSend(udpPktQueue, &pkt, 0) != pdTRUE) {
+        Log.warningln("-> UDP CMD: Command Queue Full, Datagram Dropped.");
+    }
+}
+
+// *********************************************************************************************
+// udpTask(): UDP Controller Task. Waits for command datagrams and runs them as they arrive, so the
+// commands are not delayed by the main loop.
+static void udpTask(void *param)
+{
+    udpPkt_t pkt;
+
+    while (true) {
+        if (xQueueReceive(udpPktQueue, &pkt, portMAX_DELAY) == pdTRUE) {
+            processUdpCommand(&pkt);
+        }
+    }
+}
+
+// *********************************************************************************************
+// udpInit(): Start the UDP Controller listener and its task. Safe to call again after a WiFi reconnect.
+void udpInit(void)
+{
+    char logBuff[60];
+
+    if (udpPktQueue == NULL) {
+        udpPktQueue = xQueueCreate(UDP_QUEUE_CNT, sizeof(udpPkt_t));
+
+        if ((udpPktQueue == NULL) ||
+            (xTaskCreatePinnedToCore(udpTask, "UDP", UDP_TASK_STACK_SZ, NULL, UDP_TASK_PRIORITY, NULL, UDP_TASK_CORE) != pdPASS)) {
+            Log.errorln("-> udpInit: Can't Start UDP Controller Task.");
+            return;
+        }
+    }
+
+    if (udpServer.listen(UDP_PORT)) {
+        udpServer.onPacket(udpPacket, NULL);
+        sprintf(logBuff, "-> UDP Controller Listening on Port %u.", UDP_PORT);
+        Log.infoln(logBuff);
+    }
+    else {
+        Log.errorln("-> udpInit: Can't Start UDP Controller Listener.");
+    }
+}
+
+#endif // ifdef UDP_ENB
+
+// *********************************************************************************************
+// EOF
@@ -129,6 +129,7 @@ uint16_t backupSaveSetID    = 0;
 uint16_t backupSaveSetMsgID = 0;
 
 uint16_t ctrlHttpID      = 0;
+uint16_t ctrlUdpID       = 0;
 uint16_t ctrlLocalID     = 0;
 uint16_t ctrlMqttID      = 0;
 uint16_t ctrlMqttIpID    = 0;
@@ -144,9 +145,11 @@ uint16_t ctrlSaveMsgID   = 0;
 
 uint16_t diagBootID    = 0;
 uint16_t diagBootMsgID = 0;
+uint16_t diagCmdDropID = 0;
 uint16_t diagLogID     = 0;
 uint16_t diagLogMsgID  = 0;
 uint16_t diagMemoryID  = 0;
+uint16_t diagRdsRateID = 0;
 uint16_t diagTimerID   = 0;
 uint16_t diagVbatID    = 0;
 uint16_t diagVdcID     = 0;
@@ -228,6 +231,8 @@ uint16_t wifiStaNameID    = 0;
 uint16_t wifiSubID        = 0;
 uint16_t wifiWpaKeyID     = 0;
 
+static char uiRdsTextStr[RDS_TEXT_MAX_SZ + 1] = ""; // RadioText shown on the homeTab, see getUiRdsText().
+static volatile uint8_t uiActiveCntrl = NO_CNTRL;    // RadioText Controller shown on the homeTab, see getUiActiveController().
 
 // ************************************************************************************************
 // applyCustomCss(): Apply custom CSS to Web GUI controls at the start of runtime.
@@ -243,8 +248,10 @@ void initCustomCss(void)
     ESPUI.setPanelStyle(ctrlMqttPortID, "font-size: 1.25em;");
 
     ESPUI.setPanelStyle(diagBootID,     "color: black;");
+    ESPUI.setPanelStyle(diagCmdDropID,  "color: black; font-size: 1.25em;");
     ESPUI.setPanelStyle(diagLogID,      "color: black;");
     ESPUI.setPanelStyle(diagMemoryID,   "color: black; font-size: 1.25em;");
+    ESPUI.setPanelStyle(diagRdsRateID,  "color: black; font-size: 1.25em;");
     ESPUI.setPanelStyle(diagTimerID,    "color: black; font-size: 1.25em;");
     ESPUI.setPanelStyle(diagVbatID,     "color: black; font-size: 1.25em;");
     ESPUI.setPanelStyle(diagVdcID,      "color: black; font-size: 1.25em;");
@@ -295,7 +302,9 @@ void initCustomCss(void)
     ESPUI.setElementStyle(ctrlSaveMsgID,      CSS_LABEL_STYLE_RED);
 
     ESPUI.setElementStyle(diagBootMsgID,      CSS_LABEL_STYLE_BLACK);
+    ESPUI.setElementStyle(diagCmdDropID,      "max-width: 80%;");
     ESPUI.setElementStyle(diagMemoryID,       "max-width: 40%;");
+    ESPUI.setElementStyle(diagRdsRateID,      "max-width: 50%;");
     ESPUI.setElementStyle(diagLogMsgID,       CSS_LABEL_STYLE_BLACK);
     ESPUI.setElementStyle(diagTimerID,        "max-width: 50%;");
     ESPUI.setElementStyle(diagVbatID,         "max-width: 30%;");
@@ -415,6 +424,8 @@ int8_t getAudioGain(void)
 // displayActiveController(): Display the currently active RadioText Controller.
 void displayActiveController(uint8_t controller)
 {
+    uiActiveCntrl = controller;
+
     if (controller == SERIAL_CNTRL) {
         ESPUI.print(homeTextMsgID, "Source: Serial Controller");
     }
@@ -424,6 +435,9 @@ void displayActiveController(uint8_t controller)
     else if (controller == HTTP_CNTRL) {
         ESPUI.print(homeTextMsgID, "Source: HTTP Controller");
     }
+    else if (controller == UDP_CNTRL) {
+        ESPUI.print(homeTextMsgID, "Source: UDP Controller");
+    }
     else if (controller == LOCAL_CNTRL) {
         ESPUI.print(homeTextMsgID, "Source: Local Controller");
     }
@@ -530,11 +544,12 @@ void updateUiAudioLevel(void)
     char logBuff[60];
 
     if (previousMillis == 0) {
-        previousMillis = millis(); // Initialize First entry;
+        previousMillis = getClockMillis(); // Initialize First entry;
     }
-    else if (millis() - previousMillis >= AUDIO_MEAS_TIME) {
-        previousMillis = millis();
+    else if (getClockMillis() - previousMillis >= AUDIO_MEAS_TIME) {
+        previousMillis = getClockMillis();
         mV             = measureAudioLevel();
+        setTelemetryAudio(mV);
 
         if (mV >= AUDIO_LEVEL_MAX) {
             tempStr = ">";
@@ -648,10 +663,10 @@ void updateUiIpaddress(String ipStr)
 void updateUiFreeMemory(void)
 {
     char logBuff[40];
-    static unsigned long oldMillis = millis();
+    static unsigned long oldMillis = getClockMillis();
 
-    if (millis() > oldMillis + FREE_MEM_UPD_TIME) {
-        oldMillis = millis();
+    if (getClockMillis() > oldMillis + FREE_MEM_UPD_TIME) {
+        oldMillis = getClockMillis();
         tempStr   = ESP.getFreeHeap();
         tempStr  += " Bytes";
         ESPUI.print(diagMemoryID, tempStr);
@@ -705,9 +720,33 @@ void updateUiRdsText(String textStr)
         Log.infoln(logBuff);
     }
 
+    radioLock(); // uiRdsTextStr is also read by other tasks, see getUiRdsText().
+    strlcpy(uiRdsTextStr, textStr.c_str(), sizeof(uiRdsTextStr));
+    radioUnlock();
+
     ESPUI.print(homeRdsTextID, textStr); // Update homeTab RDS Message Panel.
 }
 
+// ************************************************************************************************
+// getUiActiveController(): Return the RadioText Controller last shown on the homeTab (SERIAL_CNTRL, etc), NO_CNTRL if none.
+uint8_t getUiActiveController(void)
+{
+    return uiActiveCntrl;
+}
+
+// ************************************************************************************************
+// getUiRdsText(): Return the RadioText last shown on the homeTab (or the status message shown instead).
+String getUiRdsText(void)
+{
+    String textStr;
+
+    radioLock();
+    textStr = uiRdsTextStr;
+    radioUnlock();
+
+    return textStr;
+}
+
 // ************************************************************************************************
 // updateUiRDSTmr(): Updates the GUI's RDS time on homeTab.
 //                    On Entry rdsMillis=snapshot time for countdown calc.
@@ -721,7 +760,7 @@ void updateUiRDSTmr(unsigned long rdsMillis)
         ESPUI.print(homeRdsTmrID, " ");
     }
     else if (rfCarrierFlg && checkControllerRdsAvail() && (checkLocalRdsAvail() || checkActiveTextAvail())) {
-        timeCnt =  millis() - rdsMillis; // Get Elasped time.
+        timeCnt =  getClockMillis() - rdsMillis; // Get Elasped time.
         timeCnt = rdsMsgTime - timeCnt;  // Now we have Countdown time.
         timeCnt = timeCnt / 1000;        // Coverted to Secs.
 
@@ -776,9 +815,9 @@ void updateUiRSSI(void)
     char logBuff[60];
 
     if (previousMillis == 0) {
-        previousMillis = millis();       // Initialize First entry;
+        previousMillis = getClockMillis();       // Initialize First entry;
     }
-    else if (millis() - previousMillis >= RSSI_UPD_TIME) {
+    else if (getClockMillis() - previousMillis >= RSSI_UPD_TIME) {
         if (getWifiMode() == WIFI_STA) { // Serial log only if STA mode.
             tempStr  = getRSSI();
             tempStr += UNITS_DBM_STR;
@@ -790,7 +829,7 @@ void updateUiRSSI(void)
         }
         ESPUI.print(wifiRssiID, tempStr);
         ESPUI.print(homeRssiID, tempStr);
-        previousMillis = millis(); // Do this last.
+        previousMillis = getClockMillis(); // Do this last.
     }
 }
 
@@ -833,11 +872,11 @@ void updateUiDiagTimer(void)
     static uint8_t  minutes        = 0;
     static uint8_t  hours          = 0;
     static int16_t  days           = 0;
-    static unsigned long previousMillis = millis();
-    unsigned long currentMillis         = millis();
+    static unsigned long previousMillis = getClockMillis();
+    unsigned long currentMillis         = getClockMillis();
 
     if ((currentMillis - previousMillis) >= 1000) {
-        previousMillis = millis() - ((currentMillis - previousMillis) - 1000);
+        previousMillis = getClockMillis() - ((currentMillis - previousMillis) - 1000);
         seconds++;
 
         if (seconds >= 60) {
@@ -859,6 +898,48 @@ void updateUiDiagTimer(void)
     }
 }
 
+// ************************************************************************************************
+// updateUiCmdDrops(): Update the Controller command drop counts (rate limits), the RDS coalesce count, and the MQTT
+//                     Publish Queue counts on the diagTab.
+//                     Only sent to the Web UI when a count changes.
+void updateUiCmdDrops(void)
+{
+    char     dropBuff[220];
+    uint8_t  mqttQueueCnt;
+    uint32_t dropCnt;
+    uint32_t mqttDropCnt;
+    uint32_t mqttMergeCnt;
+    static uint32_t previousCnt = 0xFFFFFFFF;
+    static unsigned long previousMillis = 0;
+
+    if (getClockMillis() - previousMillis < CMD_DROP_UPD_TIME) {
+        return;
+    }
+    previousMillis = getClockMillis();
+    mqttQueueCnt   = getMqttPubStats(&mqttDropCnt, &mqttMergeCnt);
+    dropCnt        = getCmdDropCnt(NO_CNTRL) + getRdsCoalesceCnt() + getUdpStaleCnt() + mqttQueueCnt + mqttDropCnt + mqttMergeCnt;
+
+    if (dropCnt == previousCnt) {
+        return;
+    }
+    previousCnt = dropCnt;
+
+    sprintf(dropBuff, "Serial %u, MQTT %u, HTTP %u, UDP %u (Stale %u), RadioText Coalesced %u, MQTT Publish Queue %u (Drops %u, Coalesced %u)",
+            getCmdDropCnt(SERIAL_CNTRL), getCmdDropCnt(MQTT_CNTRL), getCmdDropCnt(HTTP_CNTRL), getCmdDropCnt(UDP_CNTRL),
+            getUdpStaleCnt(), getRdsCoalesceCnt(), mqttQueueCnt, mqttDropCnt, mqttMergeCnt);
+    ESPUI.print(diagCmdDropID, dropBuff);
+}
+
+// ************************************************************************************************
+// updateUiRdsGroupRate(): Update the measured RDS Group Rate on the diagTab.
+void updateUiRdsGroupRate(void)
+{
+    char rateBuff[40];
+
+    sprintf(rateBuff, "%1.1f / %1.1f Groups/Sec", rdsGroupRate, RDS_GROUP_RATE_MAX);
+    ESPUI.print(diagRdsRateID, rateBuff);
+}
+
 // ************************************************************************************************
 void updateUiVolts(void)
 {
@@ -866,10 +947,10 @@ void updateUiVolts(void)
     char logBuff[60];
 
     if (previousMillis == 0) {
-        previousMillis = millis(); // Initialize First entry;
+        previousMillis = getClockMillis(); // Initialize First entry;
     }
-    else if (millis() - previousMillis >= VOLTS_UPD_TIME) {
-        previousMillis = millis();
+    else if (getClockMillis() - previousMillis >= VOLTS_UPD_TIME) {
+        previousMillis = getClockMillis();
         tempStr        = String(vbatVolts, 1);
         tempStr       += " VDC";
         ESPUI.print(diagVbatID, tempStr);
@@ -1440,6 +1521,18 @@ void buildGUI(void)
 
     // ------------- END OF OPTIONAL HTTP CONTROLLER ------------------------
 
+
+    // ------------- START OF OPTIONAL UDP CONTROLLER ------------------------
+    #ifdef UDP_ENB
+    ESPUI.addControl(ControlType::Separator, CTRL_UDP_SEP_STR, "", ControlColor::None, ctrlTab);
+    ctrlUdpID =
+        ESPUI.addControl(ControlType::Switcher, CTRL_UDP_STR, ctrlUdpFlg ? "1" : "0", ControlColor::Turquoise, ctrlTab,
+                         &controllerCallback);
+    ESPUI.addControl(ControlType::Label, CTRL_UDP_PORT_STR, String(UDP_PORT), ControlColor::Turquoise, ctrlTab);
+    #endif // ifdef UDP_ENB
+
+    // ------------- END OF OPTIONAL UDP CONTROLLER ------------------------
+
     ESPUI.addControl(ControlType::Separator, CTRL_LOCAL_SEP_STR, "", ControlColor::None, ctrlTab);
     ctrlLocalID =
         ESPUI.addControl(ControlType::Switcher,
@@ -1598,6 +1691,10 @@ void buildGUI(void)
 
     diagTimerID = ESPUI.addControl(ControlType::Label, DIAG_RUN_TIME_STR, "", ControlColor::Sunflower, diagTab);
 
+    diagRdsRateID = ESPUI.addControl(ControlType::Label, DIAG_RDS_RATE_STR, "", ControlColor::Sunflower, diagTab);
+
+    diagCmdDropID = ESPUI.addControl(ControlType::Label, DIAG_CMD_DROP_STR, "", ControlColor::Sunflower, diagTab);
+
     diagBootID =
         ESPUI.addControl(ControlType::Button,
                          DIAG_REBOOT_STR,
@@ -53,6 +53,7 @@ extern uint16_t backupSaveSetID;
 extern uint16_t backupSaveSetMsgID;
 
 extern uint16_t ctrlHttpID;
+extern uint16_t ctrlUdpID;
 extern uint16_t ctrlLocalID;
 extern uint16_t ctrlMqttID;
 extern uint16_t ctrlMqttIpID;
@@ -68,9 +69,11 @@ extern uint16_t ctrlSaveMsgID;
 
 extern uint16_t diagBootID;
 extern uint16_t diagBootMsgID;
+extern uint16_t diagCmdDropID;
 extern uint16_t diagLogID;
 extern uint16_t diagLogMsgID;
 extern uint16_t diagMemoryID;
+extern uint16_t diagRdsRateID;
 extern uint16_t diagSoundID;
 extern uint16_t diagTimerID;
 extern uint16_t diagVbatID;
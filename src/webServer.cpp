@@ -12,7 +12,7 @@
    This Code was formatted with the uncrustify extension.
 
    Notes:
-   1. The HTTP GET server uses port 8080 (default).
+   1. The HTTP GET server uses port 8080 (default). It is async, clients are served by the AsyncTCP task.
    2. If host name is changed then FLASH must be fully erased before loading new code. Platformio command: pio run -t erase
    3. mDNS can be excluded from build, see config.h. Default mDNS access is 'PixelRadio.local", but can be changed in the WebUI.
    4. Use Android "Service Browser" app for mDNS Host name debugging. PixelRadio will be found in the android.tcp section.
@@ -25,22 +25,34 @@
 // *********************************************************************************************
 
 #include <ArduinoLog.h>
+#include <AsyncTCP.h>
 #include <DNSServer.h>
 #include <ESPmDNS.h>
 #include <WiFi.h>
+#include <new>
 #include "ESPUI.h"
 #include "config.h"
 #include "PixelRadio.h"
 #include "credentials.h"
 #include "globals.h"
+#include "httpControl.h"
 #include "language.h"
 
 // ************************************************************************************************
 
 DNSServer  dnsServer;
-WiFiServer server(HTTP_PORT);      // WiFi WebServer object.
 const uint16_t dnsPort = DNS_PORT; // Hot Spot AP DNS port.
 
+#ifdef HTTP_ENB
+AsyncServer httpServer(HTTP_PORT); // HTTP Controller (command) server, async.
+
+// Status Event Stream. The main loop writes the latest event, the AsyncTCP task sends it to the clients.
+static portMUX_TYPE eventMux = portMUX_INITIALIZER_UNLOCKED;
+static char     eventBuff[HTTP_EVENT_SZ] = ""; // Latest status event, guarded by eventMux.
+static uint32_t eventSeq       = 0;            // Incremented for each new event, guarded by eventMux.
+static volatile uint8_t eventClientCnt = 0;    // Event stream clients. Written by the AsyncTCP task only, also read by loop().
+#endif // ifdef HTTP_ENB
+
 // ************************************************************************************************
 // convertIpString(): Convert IP String ("192.168.1.50") to IP class array dereference operators (192,168,1,50).
 IPAddress convertIpString(String ipStr)
@@ -69,52 +81,6 @@ String IpAddressToString(const IPAddress& ipAddress) {
     return addrStr;
 }
 
-// ************************************************************************************************
-// getCommandArg(): Get the Webserver's Command Argument. Result is returned as String passed by reference.
-// Also returns String Length. If argument missing then returns -1;
-#ifdef HTTP_ENB
-int16_t getCommandArg(String& requestStr, uint8_t maxSize) {
-    int16_t argStart = 0;
-    int16_t argStop  = 0;
-    String  argStr   = ""; // Copy of Argument String.
-    String  argLcStr = ""; // Lowercase version.
-
-    argLcStr = requestStr;
-    argLcStr.toLowerCase();
-    argStart = requestStr.indexOf("=");
-
-    if (argStart >= 0) {
-        argStop = argLcStr.indexOf(HTTP_CMD_END_STR); // Search for end of command data arg.
-
-        if (argStop < 0) {
-            argStop = requestStr.length();
-        }
-
-        argStr = requestStr.substring(argStart + 1, argStop - 1);
-        argStr.replace("%7f", " "); // Replace html encoded control "DEL" with space (Text Clear Cmd).
-        argStr.replace("%7F", " ");
-        argStr = urlDecode(argStr); // Convert all remaining html encoded text to ASCII.
-
-        if (argStr.length() > maxSize) {
-            argStr = argStr.substring(0, maxSize);
-        }
-        else if (argStr.length() == 0) {
-            return -1; // Fail, Argument Missing.
-        }
-
-        argStr.trim(); // Arg length is OK, now safe to Trim off leading and trailing spaces.
-        requestStr = argStr;
-    }
-    else {             // Fail, Improper Argument Provided.
-        requestStr = "";
-        return -1;
-    }
-
-    return requestStr.length();
-}
-
-#endif // ifdef HTTP_ENB
-
 // ************************************************************************************************
 // getRSSI(): Get the RSSI value.
 //            Note: AP Mode will always return 0 since it doesn't receive a sgnal from a router.
@@ -180,613 +146,208 @@ String getWifiModeStr(void)
     return wifiModeStr;
 }
 
-// *************************************************************************************************************************
-// gpioHttpControl(): HTTP handler for GPIO Commands. This is a companion to processWebClient().
+// ************************************************************************************************
+// httpSendEvent(): Send the latest status event to an event stream client if it has not seen it. Sends a
+//                  keep-alive comment if the stream has been quiet. Runs in the AsyncTCP task.
 #ifdef HTTP_ENB
-void gpioHttpControl(WiFiClient client, String requestStr, uint8_t pin)
+static void httpSendEvent(httpClient_t *conn, AsyncClient *client)
 {
-    bool successFlg = true;
-    char charBuff[60];
-
-    sprintf(charBuff, "-> HTTP Controller: Received GPIO Pin-%d Command", pin);
-    Log.infoln(charBuff);
+    char     buff[HTTP_EVENT_SZ];
+    uint32_t seq;
 
-    successFlg = gpioCmd(requestStr, HTTP_CNTRL, pin);
+    portENTER_CRITICAL(&eventMux);
+    seq = eventSeq;
 
-    client.print(HTML_HEADER_STR);
-    client.print(HTML_DOCTYPE_STR);
+    if (seq != conn->eventSeq) {
+        strcpy(buff, eventBuff);
+    }
+    portEXIT_CRITICAL(&eventMux);
 
-    if (!successFlg) {
-        sprintf(charBuff, "{\"%s%d\": \"fail\"}", CMD_GPIO_STR, pin);
+    if (seq != conn->eventSeq) {
+        if (client->space() > strlen(buff)) { // Else try again next poll, the client gets the latest event only.
+            client->write(buff, strlen(buff));
+            conn->eventSeq    = seq;
+            conn->startMillis = millis();
+        }
     }
-    else if (requestStr == CMD_GPIO_READ_STR) {
-        sprintf(charBuff, "{\"%s%d\": \"%d\"}", CMD_GPIO_STR, pin, digitalRead(pin));
+    else if (millis() - conn->startMillis > HTTP_EVENT_KEEP_TIME) {
+        client->write(":\n\n", 3); // SSE comment, keeps proxies from closing the stream.
+        conn->startMillis = millis();
     }
-    else {
-        sprintf(charBuff, "{\"%s%d\": \"ok\"}", CMD_GPIO_STR, pin);
+}
+
+#endif // ifdef HTTP_ENB
+
+// ************************************************************************************************
+// httpStartEvents(): Turn the client's connection into a status event stream. The connection stays open,
+//                    events are sent on each AsyncTCP poll. Runs in the AsyncTCP task.
+#ifdef HTTP_ENB
+static void httpStartEvents(httpClient_t *conn, AsyncClient *client)
+{
+    String replyStr;
+
+    if (eventClientCnt >= HTTP_EVENT_CLIENT_MAX) {
+        Log.warningln("-> HTTP Controller: Too Many Event Clients, Request Refused.");
+        replyStr = makeHttpPageStr("{\"events\": \"busy\"}", false); // JSON Fmt.
+        client->write(replyStr.c_str(), replyStr.length());
+        client->close();
+        return;
     }
 
-    client.print(charBuff);
-    client.println(HTML_CLOSE_STR);
+    Log.infoln("-> HTTP Controller: Status Event Stream Started.");
+    eventClientCnt++;
+    conn->eventFlg    = true;
+    conn->eventSeq    = 0; // Send the current status first.
+    conn->startMillis = millis();
+    client->write(HTML_EVENT_HEADER_STR, strlen(HTML_EVENT_HEADER_STR));
+    httpSendEvent(conn, client);
 }
 
 #endif // ifdef HTTP_ENB
 
 // ************************************************************************************************
-// makeHttpCmdStr(): Return the HTTP command string. On entry cmdStr has command keyword.
-//                   This is a companion to processWebClient().
+// httpClientWrite(): Send a reply to the client, for httpClientReceive().
 #ifdef HTTP_ENB
-String makeHttpCmdStr(String cmdStr) {
-    cmdStr = String(HTTP_CMD_STR) + cmdStr;
-
-    return cmdStr;
+static void httpClientWrite(void *arg, const char *data, size_t len)
+{
+    ((AsyncClient *)arg)->write(data, len);
 }
 
 #endif // ifdef HTTP_ENB
 
 // ************************************************************************************************
-// processWebClient(): Web Client Handler. Must be installed in main loop.
-// URL Example: http://pixelradio.local:8080/cmd?aud=mono
+// httpClientData(): HTTP Controller receive handler, called by AsyncTCP each time a client's data
+//                   arrives. The requests are answered by httpClientReceive().
 #ifdef HTTP_ENB
-void processWebClient(void)
+static void httpClientData(void *arg, AsyncClient *client, void *data, size_t len)
 {
-    static bool connectFlg = false;
-    bool successFlg        = true;
-    uint16_t charCnt       = 0;
-    unsigned long previousTime  = millis();
+    httpClient_t *conn = (httpClient_t *)arg;
 
-    String argStr       = "";
-    String currentLine  = "";
-    String requestStr   = "";               // Var to capture the HTTP request reply.
-    String requestLcStr = "";               // Var to store the lower case HTTP request reply.
+    switch (httpClientReceive(conn, (const char *)data, len, httpClientWrite, client)) {
+        case HTTP_CLIENT_CLOSE:
+            client->close(); // Close the HTTP connection, reply is flushed first.
+            break;
 
-    WiFiClient client = server.available(); // Listen for incoming web clients.
+        case HTTP_CLIENT_EVENTS:
+            httpStartEvents(conn, client);
+            break;
 
-    if (client) {                           // New client connection (web page access).
-        requestStr.reserve(HTTP_RESPONSE_MAX_SZ + 10);
-        requestLcStr.reserve(HTTP_RESPONSE_MAX_SZ + 10);
+        default:
+            break;
+    }
+}
 
-        if (!connectFlg) {
-            Log.infoln("HTTP Controller: New Client");
-            previousTime = millis();
-        }
+#endif // ifdef HTTP_ENB
 
-        if (!client.available()) { // If no bytes available then this is a Browser Prefetch.
-            Log.infoln("-> HTTP Controller: Empty Prefetch, Close Connection.");
-            client.stop();
+// ************************************************************************************************
+// httpInit(): Start the async HTTP Controller server. Clients are served by the AsyncTCP task, so a slow
+//             client never blocks the main loop. Safe to call again after a WiFi reconnect.
+// URL Example: http://pixelradio.local:8080/cmd?aud=mono
+// Batch Example: POST http://pixelradio.local:8080/batch with data {"freq": 1011, "rtm": "Now Playing"}
+// Event Stream Example: http://pixelradio.local:8080/events (see updateHttpEvents()).
+#ifdef HTTP_ENB
+void httpInit(void)
+{
+    httpServer.onClient([](void *arg, AsyncClient *client) {
+        httpClient_t *conn = new (std::nothrow) httpClient_t; // NULL if out of memory, no exception.
+
+        if (conn == NULL) {
+            client->close(true);
             return;
         }
 
-        connectFlg  = true;
-        currentLine = ""; // Init string to hold incoming data from the client,
+        Log.infoln("HTTP Controller: New Client");
+        httpClientInit(conn);
 
-        // while (client.connected()) { // loop while the client is connected.
-        while (client.connected() && millis() - previousTime <= CLIENT_TIMEOUT) {
-            if (client.available()) {
-                char c = client.read();
+        client->onData(httpClientData, conn);
 
-                if (charCnt < HTTP_RESPONSE_MAX_SZ) {
-                    // Serial.write(c); // DEBUG ONLY: Log saved URI chars to serial monitor.
-                    requestStr += c; // Build URI string.
-                    charCnt++;
-                }
+        client->onPoll([](void *arg, AsyncClient *client) {
+            httpClient_t *conn = (httpClient_t *)arg;
 
-                if (c == '\n') {
-                    // if the current line is zero, you got two newline characters in a row.
-                    // that's the end of the client HTTP request body, so check for the
-                    // optional post data. Then process the command.
-                    if (currentLine.length() == 0) {
-                        // Log.verboseln(requestStr.c_str());
-                        requestLcStr = requestStr;
-                        requestLcStr.toLowerCase();
-
-                        // ************ PROCESS POST DATA (if any) ***************
-                        uint16_t contentLenIndex = requestLcStr.indexOf(HTTP_POST_STR);
-
-                        if (contentLenIndex > 0) {
-                            String lenStr = requestLcStr.substring(contentLenIndex + sizeof(HTTP_POST_STR));
-
-                            if (lenStr.toInt() > 0) {
-                                Log.verboseln("-> HTTP CMD: Found Post Data");
-
-                                uint16_t endCmdIndex = requestLcStr.indexOf(HTTP_CMD_END_STR);
-
-                                if (endCmdIndex > 0) {
-                                    requestStr =  requestStr.substring(0, endCmdIndex);
-                                }
-
-                                while (client.available() && charCnt < HTTP_RESPONSE_MAX_SZ) {
-                                    char c = client.read();
-
-                                    if ((c == '\r') || (c == '\n')) {
-                                        break;
-                                    }
-
-                                    // Serial.write(c); // DEBUG ONLY: Log saved URI chars to serial monitor.
-                                    requestStr += c; // Build URI string.
-                                    charCnt++;
-                                }
-                                requestStr  += ' ';  // Must pad end of Post data with Space (needed by cmd processor).
-                                requestLcStr = requestStr;
-                                requestLcStr.toLowerCase();
-                            }
-                        }
-
-                        // ************ NO COMMAND, EMPTY PAYLOAD ***************
-                        if (requestLcStr.indexOf(HTTP_EMPTY_RESP_STR) == 0) {
-                            Log.verboseln("-> HTTP CMD: Empty Payload, Ignored");
-                            break;
-                        }
-
-                        // ************ AUDIO MODE COMMAND ***************
-                        else if (requestLcStr.indexOf(makeHttpCmdStr(CMD_AUDMODE_STR)) > 0) {
-                            Log.infoln("-> HTTP CMD: Audio Mode");
-
-                            if (getCommandArg(requestStr, CMD_AUD_MAX_SZ) == -1) {
-                                successFlg = false;
-                                Log.errorln("-> HTTP CMD: Audio Mode Missing Value (abort).");
-                            }
-                            else {
-                                if (audioModeCmd(requestStr, HTTP_CNTRL) == false) {
-                                    successFlg = false;
-                                }
-                            }
-
-                            client.print(HTML_HEADER_STR);
-                            client.print(HTML_DOCTYPE_STR);
-
-                            if (successFlg) {
-                                client.printf("{\"%s\": \"ok\"}\r\n", CMD_AUDMODE_STR);
-                            }
-                            else {
-                                client.printf("{\"%s\": \"fail\"}\r\n", CMD_AUDMODE_STR);
-                            }
-                            client.println(HTML_CLOSE_STR);
-                        }
-
-                        // ************ GPIO19 COMMAND ***************
-                        else if (requestLcStr.indexOf(makeHttpCmdStr(CMD_GPIO19_STR)) > 0) {
-                            Log.infoln("-> HTTP CMD: GPIO19");
-
-                            if (getCommandArg(requestStr, CMD_GPIO_MAX_SZ) == -1) {
-                                Log.errorln("-> HTTP CMD: GPIO Control Missing Value (abort).");
-                            }
-                            else {
-                                gpioHttpControl(client, requestStr, GPIO19_PIN);
-                            }
-                        }
-
-                        // ************ GPIO23 COMMAND ***************
-                        else if (requestLcStr.indexOf(makeHttpCmdStr(CMD_GPIO23_STR)) > 0) {
-                            Log.infoln("-> HTTP CMD: GPIO23");
-
-                            if (getCommandArg(requestStr, CMD_GPIO_MAX_SZ) == -1) {
-                                Log.errorln("-> HTTP CMD: GPIO Control Missing Value (abort).");
-                            }
-                            else {
-                                gpioHttpControl(client, requestStr, GPIO23_PIN);
-                            }
-                        }
-
-                        // ************ GPIO33 COMMAND ***************
-                        else if (requestLcStr.indexOf(makeHttpCmdStr(CMD_GPIO33_STR)) > 0) {
-                            Log.infoln("-> HTTP CMD: GPIO33");
-
-                            if (getCommandArg(requestStr, CMD_GPIO_MAX_SZ) == -1) {
-                                Log.errorln("-> HTTP CMD: GPIO Control Missing Value (abort).");
-                            }
-                            else {
-                                gpioHttpControl(client, requestStr, GPIO33_PIN);
-                            }
-                        }
-
-                        // ************ INFO COMMAND ***************
-                        else if (requestLcStr.indexOf(makeHttpCmdStr(CMD_INFO_STR)) >= 0) {
-                            Log.infoln("-> HTTP CMD: INFO");
-
-                            if (getCommandArg(requestStr, CMD_SYS_MAX_SZ) == -1) {
-                                successFlg = false;
-                                Log.errorln("-> HTTP CMD: Info Missing Value (abort).");
-                            }
-                            else {
-                                if (infoCmd(requestStr, HTTP_CNTRL) == false) {
-                                    successFlg = false;
-                                }
-                            }
-
-                            client.print(HTML_HEADER_STR);
-                            client.print(HTML_DOCTYPE_STR);
-
-                            if (successFlg) {
-                                client.printf(
-                                    "{\"%s\": \"ok\", \"version\": \"%s\", \"hostName\": \"%s\", \"ip\": \"%s\", \"rssi\": %d, \"status\": \"0x%02X\"}\r\n",
-                                    CMD_INFO_STR,
-                                    VERSION_STR,
-                                    staNameStr.c_str(),
-                                    WiFi.localIP().toString().c_str(),
-                                    WiFi.RSSI(),
-                                    getControllerStatus());
-                            }
-                            else {
-                                client.printf("{\"%s\": \"fail\"}\r\n", CMD_INFO_STR);
-                            }
-                            client.println(HTML_CLOSE_STR);
-                        }
-
-                        // ************ FREQUENCY COMMAND ***************
-                        else if (requestLcStr.indexOf(makeHttpCmdStr(CMD_FREQ_STR)) >= 0) {
-                            Log.infoln("-> HTTP CMD: FREQUENCY");
-
-                            if (getCommandArg(requestStr, CMD_FREQ_MAX_SZ) == -1) {
-                                successFlg = false;
-                                Log.errorln("-> HTTP CMD: Frequency Missing Value (abort).");
-                            }
-                            else {
-                                if (frequencyCmd(requestStr, HTTP_CNTRL) == false) {
-                                    successFlg = false;
-                                }
-                            }
-                            client.print(HTML_HEADER_STR);
-                            client.print(HTML_DOCTYPE_STR);
-
-                            if (successFlg) {
-                                client.printf("{\"%s\": \"ok\"}\r\n", CMD_FREQ_STR);
-                            }
-                            else {
-                                client.printf("{\"%s\": \"fail\"}\r\n", CMD_FREQ_STR);
-                            }
-                            client.println(HTML_CLOSE_STR);
-                        }
-
-                        // ************ MUTE COMMAND ***************
-                        else if (requestLcStr.indexOf(makeHttpCmdStr(CMD_MUTE_STR)) >= 0) {
-                            Log.infoln("-> HTTP CMD: MUTE");
-
-                            if (getCommandArg(requestStr, CMD_MUTE_MAX_SZ) == -1) {
-                                successFlg = false;
-                                Log.errorln("-> HTTP CMD: Mute Missing Value (abort).");
-                            }
-                            else {
-                                if (muteCmd(requestStr, HTTP_CNTRL) == false) {
-                                    successFlg = false;
-                                }
-                            }
-                            client.print(HTML_HEADER_STR);
-                            client.print(HTML_DOCTYPE_STR);
-
-                            if (successFlg) {
-                                client.printf("{\"%s\": \"ok\"}\r\n", CMD_MUTE_STR);
-                            }
-                            else {
-                                client.printf("{\"%s\": \"fail\"}\r\n", CMD_MUTE_STR);
-                            }
-                            client.println(HTML_CLOSE_STR);
-                        }
-
-                        // ************* PI CODE COMMAND ****************
-                        else if (requestLcStr.indexOf(makeHttpCmdStr(CMD_PICODE_STR)) >= 0) {
-                            Log.infoln("-> HTTP CMD: PI (Program ID) CODE");
-
-                            if (getCommandArg(requestStr, CMD_PI_MAX_SZ) == -1) {
-                                successFlg = false;
-                                Log.errorln("-> HTTP CMD: PI Code Missing Value (abort).");
-                            }
-                            else {
-                                if (piCodeCmd(requestStr, HTTP_CNTRL) == false) {
-                                    successFlg = false;
-                                }
-                            }
-                            client.print(HTML_HEADER_STR);
-                            client.print(HTML_DOCTYPE_STR);
-
-                            if (successFlg) {
-                                client.printf("{\"%s\": \"ok\"}\r\n", CMD_PICODE_STR);
-                            }
-                            else {
-                                client.printf("{\"%s\": \"fail\"}\r\n", CMD_PICODE_STR);
-                            }
-                            client.println(HTML_CLOSE_STR);
-                        }
-
-                        // ************* PTY CODE COMMAND ****************
-                        else if (requestLcStr.indexOf(makeHttpCmdStr(CMD_PTYCODE_STR)) >= 0) {
-                            Log.infoln("-> HTTP CMD: PTY CODE");
-
-                            if (getCommandArg(requestStr, CMD_PTY_MAX_SZ) == -1) {
-                                successFlg = false;
-                                Log.errorln("-> HTTP CMD: PTY Code Missing Value (abort).");
-                            }
-                            else {
-                                if (ptyCodeCmd(requestStr, HTTP_CNTRL) == false) {
-                                    successFlg = false;
-                                }
-                            }
-                            client.print(HTML_HEADER_STR);
-                            client.print(HTML_DOCTYPE_STR);
-
-                            if (successFlg) {
-                                client.printf("{\"%s\": \"ok\"}\r\n", CMD_PTYCODE_STR);
-                            }
-                            else {
-                                client.printf("{\"%s\": \"fail\"}\r\n", CMD_PTYCODE_STR);
-                            }
-                            client.println(HTML_CLOSE_STR);
-                        }
-
-                        // ********PROGRAM SERVICE NAME COMMAND *********
-                        else if (requestLcStr.indexOf(makeHttpCmdStr(CMD_PSN_STR)) >= 0) {
-                            Log.infoln("-> HTTP CMD: PSN (Program Service Name)");
-
-                            if (getCommandArg(requestStr, RDS_PSN_MAX_SZ) == -1) {
-                                successFlg = false;
-                                Log.errorln("-> HTTP CMD: PSN Missing Value, (abort).");
-                            }
-                            else {
-                                if (programServiceNameCmd(requestStr, HTTP_CNTRL) == false) {
-                                    successFlg = false;
-                                }
-                            }
-                            client.print(HTML_HEADER_STR);
-                            client.print(HTML_DOCTYPE_STR);
-
-                            if (successFlg) {
-                                client.printf("{\"%s\": \"ok\"}\r\n", CMD_PSN_STR);
-                            }
-                            else {
-                                client.printf("{\"%s\": \"fail\"}\r\n", CMD_PSN_STR);
-                            }
-                            client.println(HTML_CLOSE_STR);
-                        }
-
-                        // ************ RT COMMAND ***************
-                        // To clear RadioText display send %20 as payload.
-                        else if (requestLcStr.indexOf(makeHttpCmdStr(CMD_RADIOTEXT_STR)) >= 0) {
-                            Log.infoln("-> HTTP CMD: RTM (RadioText Message)");
-
-                            if (getCommandArg(requestStr, RDS_TEXT_MAX_SZ) == -1) {
-                                successFlg = false;
-                                Log.errorln("-> HTTP CMD: RTM, Missing RadioText Message, Ignored.");
-                            }
-                            else {
-                                if (radioTextCmd(requestStr, HTTP_CNTRL) == false) {
-                                    successFlg = false;
-                                }
-                            }
-                            client.print(HTML_HEADER_STR);
-                            client.print(HTML_DOCTYPE_STR);
-
-                            if (successFlg) {
-                                client.printf("{\"%s\": \"ok\"}\r\n", CMD_RADIOTEXT_STR);   // JSON Fmt.
-                            }
-                            else {
-                                client.printf("{\"%s\": \"fail\"}\r\n", CMD_RADIOTEXT_STR); // JSON Fmt.
-                            }
-                            client.println(HTML_CLOSE_STR);
-                        }
-
-                        // ************ RFC COMMAND ***************
-                        else if (requestLcStr.indexOf(makeHttpCmdStr(CMD_RF_CARRIER_STR)) >= 0) {
-                            Log.infoln("-> HTTP CMD: RFC (RF Carrier Control)");
-
-                            if (getCommandArg(requestStr, CMD_RF_MAX_SZ) == -1) {
-                                successFlg = false;
-                                Log.errorln("-> HTTP CMD: RFC, Missing Value (abort).");
-                            }
-                            else {
-                                if (rfCarrierCmd(requestStr, HTTP_CNTRL) == false) {
-                                    successFlg = false;
-                                }
-                            }
-                            client.print(HTML_HEADER_STR);
-                            client.print(HTML_DOCTYPE_STR);
-
-                            if (successFlg) {
-                                client.printf("{\"%s\": \"ok\"}\r\n", CMD_RF_CARRIER_STR);   // JSON Fmt.
-                            }
-                            else {
-                                client.printf("{\"%s\": \"fail\"}\r\n", CMD_RF_CARRIER_STR); // JSON Fmt.
-                            }
-                            client.println(HTML_CLOSE_STR);
-                        }
-
-                        // ************ REBOOT COMMAND ***************
-                        else if (requestLcStr.indexOf(makeHttpCmdStr(CMD_REBOOT_STR)) >= 0) {
-                            Log.infoln("-> HTTP CMD: REBOOT");
-
-                            if (getCommandArg(requestStr, CMD_SYS_MAX_SZ) == -1) {
-                                successFlg = false;
-                                Log.errorln("-> HTTP CMD: REBOOT, Missing Value (abort).");
-                            }
-                            else {
-                                if (rebootCmd(requestStr, HTTP_CNTRL) == false) {
-                                    successFlg = false;
-                                }
-                            }
-
-                            client.print(HTML_HEADER_STR);
-                            client.print(HTML_DOCTYPE_STR);
-
-                            if (successFlg) {
-                                client.printf("{\"%s\": \"ok\"}\r\n", CMD_REBOOT_STR);   // JSON Fmt.
-                            }
-                            else {
-                                client.printf("{\"%s\": \"fail\"}\r\n", CMD_REBOOT_STR); // JSON Fmt.
-                            }
-
-                            client.println(HTML_CLOSE_STR);
-                        }
-
-                        // ************** START COMMAND ***************
-                        else if (requestLcStr.indexOf(makeHttpCmdStr(CMD_START_STR)) >= 0) {
-                            Log.infoln("-> HTTP CMD: START");
-
-                            if (getCommandArg(requestStr, CMD_RDS_MAX_SZ) == -1) {
-                                successFlg = false;
-                                Log.errorln("-> HTTP CMD: START, Missing Value (abort).");
-                            }
-                            else {
-                                if (startCmd(requestStr, HTTP_CNTRL) == false) {
-                                    successFlg = false;
-                                }
-                            }
-
-                            client.print(HTML_HEADER_STR);
-                            client.print(HTML_DOCTYPE_STR);
-
-                            if (successFlg) {
-                                client.printf("{\"%s\": \"ok\"}\r\n", CMD_START_STR);   // JSON Fmt.
-                            }
-                            else {
-                                client.printf("{\"%s\": \"fail\"}\r\n", CMD_START_STR); // JSON Fmt.
-                            }
-
-                            client.println(HTML_CLOSE_STR);
-                        }
-
-                        // **************** STOP COMMAND ****************
-                        else if (requestLcStr.indexOf(makeHttpCmdStr(CMD_STOP_STR)) >= 0) {
-                            Log.infoln("-> HTTP CMD: STOP");
-
-                            if (getCommandArg(requestStr, CMD_RDS_MAX_SZ) == -1) {
-                                successFlg = false;
-                                Log.errorln("-> HTTP CMD: STOP, Missing Value (abort).");
-                            }
-                            else {
-                                if (stopCmd(requestStr, HTTP_CNTRL) == false) {
-                                    successFlg = false;
-                                }
-                            }
-
-                            client.print(HTML_HEADER_STR);
-                            client.print(HTML_DOCTYPE_STR);
-
-                            if (successFlg) {
-                                client.printf("{\"%s\": \"ok\"}\r\n", CMD_STOP_STR);   // JSON Fmt.
-                            }
-                            else {
-                                client.printf("{\"%s\": \"fail\"}\r\n", CMD_STOP_STR); // JSON Fmt.
-                            }
-
-                            client.println(HTML_CLOSE_STR);
-                        }
-
-                        // ************* TIME PERIOID COMMAND ************
-                        else if (requestLcStr.indexOf(makeHttpCmdStr(CMD_PERIOD_STR)) >= 0) {
-                            Log.infoln("-> HTTP CMD: RTPER (RadioText Time Period)");
-
-                            if (getCommandArg(requestStr, CMD_TIME_MAX_SZ) == -1) {
-                                successFlg = false;
-                                Log.errorln("-> HTTP CMD: RTPER, Missing Value (abort).");
-                            }
-                            else {
-                                if (rdsTimePeriodCmd(requestStr, HTTP_CNTRL) == false) {
-                                    successFlg = false;
-                                }
-                            }
-
-                            client.print(HTML_HEADER_STR);
-                            client.print(HTML_DOCTYPE_STR);
-
-                            if (successFlg) {
-                                client.printf("{\"%s\": \"ok\"}\r\n", CMD_PERIOD_STR);   // JSON Fmt.
-                            }
-                            else {
-                                client.printf("{\"%s\": \"fail\"}\r\n", CMD_PERIOD_STR); // JSON Fmt.
-                            }
-
-                            client.println(HTML_CLOSE_STR);
-                        }
-
-                        // ************ UNKNOWN COMMAND ***************
-                        else {
-                            Log.errorln("-> HTTP CMD: COMMAND IS UNDEFINED");
-                            client.print(HTML_HEADER_STR);
-                            client.print(HTML_DOCTYPE_STR);
-                            client.println("{\"cmd\": \"undefined\"}\r\n"); // JSON Fmt.
-                            client.println(HTML_CLOSE_STR);
-                        }
-
-                        // Break out of the while loop
-                        break;
-                    }
-                    else { // if you got a newline, then clear currentLine
-                        currentLine = "";
-                    }
-                }
-                else if (c != '\r') { // if you got anything else but a carriage return character,
-                    currentLine += c; // add it to the end of the currentLine
-                }
+            if (conn->eventFlg) {
+                httpSendEvent(conn, client);
             }
-        }
-        requestStr   = ""; // Clear the reply request variable.
-        requestLcStr = "";
+            else if (httpClientPoll(conn) == HTTP_CLIENT_CLOSE) {
+                client->close();
+            }
+        }, conn);
 
-        connectFlg = false;
-        client.stop();     // Close the GET HTTP connection.
-        Log.infoln("-> HTTP Controller: Client Disconnected.");
-    }
-    else if (connectFlg) { // Client was connected, but now nothing to do.
-        connectFlg = false;
-        client.stop();     // Close the GET HTTP connection.
-        Log.infoln("-> HTTP Controller: Connected Client Now Idle, Disconnected).");
-    }
+        client->onDisconnect([](void *arg, AsyncClient *client) {
+            if (((httpClient_t *)arg)->eventFlg) {
+                eventClientCnt--;
+            }
+            delete (httpClient_t *)arg;
+            delete client;
+            Log.infoln("-> HTTP Controller: Client Disconnected.");
+        }, conn);
+    }, NULL);
+
+    httpServer.begin(); // Start HTTP GET server.
 }
 
 #endif // ifdef HTTP_ENB
 
 // ************************************************************************************************
-// processDnsServer(): DNS Server for AP hot spot. Must be called in main loop.
-void processDnsServer(void)
-{
-    dnsServer.processNextRequest();
-}
-
-// *********************************************************************************************
-// urlDecode(): Convert URL encoding into ASII.
-String urlDecode(String urlStr)
+// updateHttpEvents(): Publish a status event (RSSI, Controller Status, RF Carrier, Frequency, RadioText) for the
+//                     HTTP Controller's event stream clients when the status changes. Changes are checked once per
+//                     HTTP_EVENT_TIME, so a burst of changes is sent as one event. Call from main loop().
+// Event Example: event: status
+//                data: {"rssi": -61, "status": "0xA2", "carrier": "on", "freq": 1011, "rtm": "Now Playing"}
+#ifdef HTTP_ENB
+void updateHttpEvents(void)
 {
-    String encodeStr = "";
-    char   c;
-    char   code0;
-    char   code1;
-
-    for (int i = 0; i < urlStr.length(); i++) {
-        c = urlStr.charAt(i);
-
-        if (c == '%') {
-            code0      = urlStr.charAt(++i);
-            code1      = urlStr.charAt(++i);
-            c          = (urlDecodeHex(code0) << 4) | urlDecodeHex(code1);
-            encodeStr += c;
-        }
-        else if (c == '+') {
-            encodeStr += ' ';
-        }
-        else {
-            encodeStr += c;
-        }
+    char   buff[HTTP_EVENT_SZ];
+    char  *buffPtr;
+    int8_t rssi;
+    String textStr;
+    static int8_t rssiReported = 0;
+    static unsigned long previousMillis = 0;
+
+    // eventClientCnt is a single byte read (atomic), a stale count only builds or skips one event.
+    if ((eventClientCnt == 0) || (millis() - previousMillis < HTTP_EVENT_TIME)) {
+        return;
     }
+    previousMillis = millis();
 
-    return encodeStr;
-}
+    rssi = getRSSI();
 
-// *********************************************************************************************
-// urlDecodeHex(): convert hex to integer base. This is companion function for urlDecode().
-unsigned char urlDecodeHex(char c)
-{
-    if ((c >= '0') && (c <= '9')) {
-        return (unsigned char)c - '0';
+    if (abs(rssi - rssiReported) >= HTTP_EVENT_RSSI_HYST) { // Ignore RSSI jitter.
+        rssiReported = rssi;
     }
 
-    if ((c >= 'a') && (c <= 'f')) {
-        return (unsigned char)c - 'a' + 10;
+    textStr = getUiRdsText();
+    buffPtr = buff + sprintf(buff,
+                             "event: status\ndata: {\"rssi\": %d, \"status\": \"0x%02X\", \"carrier\": \"%s\", \"freq\": %u, \"rtm\": \"",
+                             rssiReported,
+                             getControllerStatus(),
+                             rfCarrierFlg ? "on" : "off",
+                             fmFreqX10);
+
+    for (uint8_t i = 0; (i < textStr.length()) && (i < CMD_RT_MAX_SZ); i++) { // JSON escape the RadioText.
+        char c = textStr[i];
+
+        if ((c == '"') || (c == '\\')) {
+            *buffPtr++ = '\\';
+        }
+        *buffPtr++ = ((uint8_t)c < ' ') ? ' ' : c;
     }
+    strcpy(buffPtr, "\"}\n\n");
 
-    if ((c >= 'A') && (c <= 'F')) {
-        return (unsigned char)c - 'A' + 10;
+    if (strcmp(buff, eventBuff) != 0) { // Only this task writes eventBuff, safe to read without the lock.
+        portENTER_CRITICAL(&eventMux);
+        strcpy(eventBuff, buff);
+        eventSeq++;
+        portEXIT_CRITICAL(&eventMux);
     }
+}
+
+#endif // ifdef HTTP_ENB
 
-    return 0;
+// ************************************************************************************************
+// processDnsServer(): DNS Server for AP hot spot. Must be called in main loop.
+void processDnsServer(void)
+{
+    dnsServer.processNextRequest();
 }
 
 // ************************************************************************************************
@@ -937,7 +498,12 @@ bool wifiConnect(void)
         // Print local IP address and start web server
         sprintf(logBuff, "-> WiFi connected, IP address: %s, RSSI: %ddBm", WiFi.localIP().toString().c_str(), WiFi.RSSI());
         Log.infoln(logBuff);
-        server.begin(); // Start HTTP GET server.
+        #ifdef HTTP_ENB
+        httpInit(); // Start HTTP GET server.
+        #endif // ifdef HTTP_ENB
+        #ifdef UDP_ENB
+        udpInit(); // Start UDP Controller listener.
+        #endif // ifdef UDP_ENB
 
         #ifdef MDNS_ENB
         MDNS.addService("http", "tcp", WEBSERVER_PORT);
@@ -0,0 +1,261 @@
+/*
+   File: Arduino.h (native test stub)
+   Project: PixelRadio, an RBDS/RDS FM Transmitter (QN8027 Digital FM IC)
+   Version: 1.1.2
+   Creation: Oct-18-2022
+   Revised:  Oct-18-2022
+   Revision History: See PixelRadio.cpp
+   Project Leader: T. Black (thomastech)
+   Contributors: thomastech
+
+   (c) copyright T. Black 2021-2022, Licensed under GNU GPL 3.0 and later, under this
+   license absolutely no warranty is given.
+   This Code was formatted with the uncrustify extension.
+
+   Note 1: Just enough of the Arduino core to build the radio, RDS, and codec modules on a host
+           ([env:native], see platformio.ini). Header only.
+   Note 2: millis() and micros() follow the host's steady clock, unless a simulation sets
+           stubMicrosFn to its own clock.
+   Note 3: FreeRTOS is single task here. Queues work, tasks are never started (a test calls the
+           task's work function itself) and critical sections do nothing.
+ */
+
+// *********************************************************************************************
+
+#pragma once
+#include <ctype.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <deque>
+#include <string>
+#include <vector>
+
+// *********************************************************************************************
+
+typedef uint8_t byte;
+typedef bool    boolean;
+
+#define HIGH           1
+#define LOW            0
+#define INPUT          0x01
+#define OUTPUT         0x03
+#define IRAM_ATTR
+#define highByte(w)    ((uint8_t)((w) >> 8))
+#define lowByte(w)     ((uint8_t)((w) & 0xFF))
+
+// *********************************************************************************************
+
+inline unsigned long (*stubMicrosFn)(void) = nullptr; // Simulated clock, nullptr = host clock.
+
+inline unsigned long micros(void)
+{
+    static const auto startTime = std::chrono::steady_clock::now();
+
+    if (stubMicrosFn) {
+        return stubMicrosFn();
+    }
+    return (unsigned long)std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - startTime).count();
+}
+
+inline unsigned long millis(void)
+{
+    return micros() / 1000;
+}
+
+inline void delay(unsigned long)           {}
+inline void delayMicroseconds(unsigned int) {}
+inline void yield(void)                    {}
+
+inline void pinMode(uint8_t, uint8_t)      {}
+inline void digitalWrite(uint8_t, uint8_t) {}
+inline int  digitalRead(uint8_t)           {
+    return LOW;
+}
+
+// *********************************************************************************************
+// FreeRTOS, single task.
+typedef int      BaseType_t;
+typedef uint32_t TickType_t;
+typedef void    *TaskHandle_t;
+typedef int      portMUX_TYPE;
+
+#define pdFALSE                       0
+#define pdTRUE                        1
+#define pdPASS                        1
+#define pdMS_TO_TICKS(ms)             ((TickType_t)(ms))
+#define portMAX_DELAY                 0xFFFFFFFF
+#define portMUX_INITIALIZER_UNLOCKED  0
+#define portENTER_CRITICAL(mux)       ((void)(mux))
+#define portEXIT_CRITICAL(mux)        ((void)(mux))
+
+struct stubQueue_t {
+    size_t                           itemSize;
+    size_t                           depth;
+    std::deque<std::vector<uint8_t> > items;
+};
+typedef stubQueue_t *QueueHandle_t;
+
+inline QueueHandle_t xQueueCreate(size_t depth, size_t itemSize)
+{
+    return new stubQueue_t{ itemSize, depth, {} };
+}
+
+inline BaseType_t xQueueSend(QueueHandle_t queue, const void *item, TickType_t)
+{
+    if (queue->items.size() >= queue->depth) {
+        return pdFALSE;
+    }
+    queue->items.emplace_back((const uint8_t *)item, (const uint8_t *)item + queue->itemSize);
+    return pdTRUE;
+}
+
+inline BaseType_t xQueueOverwrite(QueueHandle_t queue, const void *item)
+{
+    queue->items.clear();
+    return xQueueSend(queue, item, 0);
+}
+
+inline BaseType_t xQueueReceive(QueueHandle_t queue, void *item, TickType_t)
+{
+    if (queue->items.empty()) {
+        return pdFALSE;
+    }
+    memcpy(item, queue->items.front().data(), queue->itemSize);
+    queue->items.pop_front();
+    return pdTRUE;
+}
+
+inline BaseType_t xTaskCreatePinnedToCore(void (*)(void *), const char *, uint32_t, void *, int, TaskHandle_t *, int)
+{
+    return pdPASS;
+}
+
+inline void vTaskDelay(TickType_t) {}
+
+// *********************************************************************************************
+// String: The subset of the Arduino String class used by the modules under test.
+class String {
+public:
+    String(const char *str = "") : s(str ? str : "") {}
+    String(const std::string& str) : s(str) {}
+    String(char c) : s(1, c) {}
+    String(int val) : s(std::to_string(val)) {}
+    String(unsigned int val) : s(std::to_string(val)) {}
+    String(long val) : s(std::to_string(val)) {}
+    String(unsigned long val) : s(std::to_string(val)) {}
+
+    const char* c_str(void) const {
+        return s.c_str();
+    }
+
+    unsigned int length(void) const {
+        return s.length();
+    }
+
+    bool reserve(unsigned int size) {
+        s.reserve(size);
+        return true;
+    }
+
+    char charAt(unsigned int index) const {
+        return index < s.length() ? s[index] : 0;
+    }
+
+    char operator[](unsigned int index) const {
+        return charAt(index);
+    }
+
+    int indexOf(char c, unsigned int from = 0) const {
+        size_t pos = s.find(c, from);
+
+        return pos == std::string::npos ? -1 : int(pos);
+    }
+
+    int indexOf(const String& str, unsigned int from = 0) const {
+        size_t pos = s.find(str.s, from);
+
+        return pos == std::string::npos ? -1 : int(pos);
+    }
+
+    String substring(unsigned int left, unsigned int right = 0xFFFF) const {
+        if (left >= s.length() || right <= left) {
+            return String();
+        }
+        return String(s.substr(left, right - left));
+    }
+
+    void toCharArray(char *buff, unsigned int size) const {
+        if (size) {
+            strncpy(buff, s.c_str(), size - 1);
+            buff[size - 1] = 0;
+        }
+    }
+
+    long toInt(void) const {
+        return atol(s.c_str());
+    }
+
+    void toLowerCase(void) {
+        for (char& c : s) {
+            c = tolower(c);
+        }
+    }
+
+    void toUpperCase(void) {
+        for (char& c : s) {
+            c = toupper(c);
+        }
+    }
+
+    void trim(void) {
+        size_t first = s.find_first_not_of(" \t\r\n");
+
+        s = (first == std::string::npos) ? "" : s.substr(first, s.find_last_not_of(" \t\r\n") - first + 1);
+    }
+
+    String& operator+=(const String& str) {
+        s += str.s;
+        return *this;
+    }
+
+    String& operator+=(const char *str) {
+        s += str;
+        return *this;
+    }
+
+    String& operator+=(char c) {
+        s += c;
+        return *this;
+    }
+
+    friend String operator+(const String& a, const String& b) {
+        return String(a.s + b.s);
+    }
+
+    bool operator==(const String& str) const {
+        return s == str.s;
+    }
+
+    bool operator==(const char *str) const {
+        return s == str;
+    }
+
+    bool operator!=(const String& str) const {
+        return s != str.s;
+    }
+
+    bool operator!=(const char *str) const {
+        return s != str;
+    }
+
+private:
+    std::string s;
+};
+
+// *********************************************************************************************
+// EOF
@@ -0,0 +1,42 @@
+/*
+   File: ArduinoLog.h (native test stub)
+   Project: PixelRadio, an RBDS/RDS FM Transmitter (QN8027 Digital FM IC)
+   Version: 1.1.2
+   Creation: Oct-18-2022
+   Revised:  Oct-18-2022
+   Revision History: See PixelRadio.cpp
+   Project Leader: T. Black (thomastech)
+   Contributors: thomastech
+
+   (c) copyright T. Black 2021-2022, Licensed under GNU GPL 3.0 and later, under this
+   license absolutely no warranty is given.
+   This Code was formatted with the uncrustify extension.
+
+   Note 1: Log calls are counted and discarded. Tests can check Log.errorCnt.
+ */
+
+// *********************************************************************************************
+
+#pragma once
+#include "Arduino.h"
+
+// *********************************************************************************************
+
+class Logging {
+public:
+    template<class ... T>void errorln(T ...) {
+        errorCnt++;
+    }
+
+    template<class ... T>void warningln(T ...) {}
+    template<class ... T>void infoln(T ...)    {}
+    template<class ... T>void verboseln(T ...) {}
+    template<class ... T>void traceln(T ...)   {}
+
+    uint32_t errorCnt = 0;
+};
+
+inline Logging Log;
+
+// *********************************************************************************************
+// EOF
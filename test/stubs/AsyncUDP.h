@@ -0,0 +1,82 @@
+/*
+   File: AsyncUDP.h (native test stub)
+   Project: PixelRadio, an RBDS/RDS FM Transmitter (QN8027 Digital FM IC)
+   Version: 1.1.2
+   Creation: Oct-18-2022
+   Revised:  Oct-18-2022
+   Revision History: See PixelRadio.cpp
+   Project Leader: T. Black (thomastech)
+   Contributors: thomastech
+
+   (c) copyright T. Black 2021-2022, Licensed under GNU GPL 3.0 and later, under this
+   license absolutely no warranty is given.
+   This Code was formatted with the uncrustify extension.
+
+   Note 1: No network. A test hands datagrams to the onPacket handler itself, and writeTo() keeps
+           the replies in replyStrs so the test can check them.
+ */
+
+// *********************************************************************************************
+
+#pragma once
+#include <vector>
+#include "Arduino.h"
+#include "WiFi.h"
+
+// *********************************************************************************************
+
+class AsyncUDPPacket {
+public:
+    AsyncUDPPacket(const uint8_t *data, size_t len, IPAddress addr, uint16_t port) :
+        pktData(data), pktLen(len), pktAddr(addr), pktPort(port) {}
+
+    const uint8_t* data(void) {
+        return pktData;
+    }
+
+    size_t length(void) {
+        return pktLen;
+    }
+
+    IPAddress remoteIP(void) {
+        return pktAddr;
+    }
+
+    uint16_t remotePort(void) {
+        return pktPort;
+    }
+
+private:
+    const uint8_t *pktData;
+    size_t         pktLen;
+    IPAddress      pktAddr;
+    uint16_t       pktPort;
+};
+
+typedef void (*AuPacketHandlerFunctionWithArg)(void *arg, AsyncUDPPacket& packet);
+
+class AsyncUDP {
+public:
+    bool listen(uint16_t port) {
+        listenPort = port;
+        return true;
+    }
+
+    void onPacket(AuPacketHandlerFunctionWithArg fn, void *arg = NULL) {
+        packetFn  = fn;
+        packetArg = arg;
+    }
+
+    size_t writeTo(const uint8_t *data, size_t len, const IPAddress& addr, uint16_t port) {
+        replyStrs.push_back(std::string((const char *)data, len));
+        return len;
+    }
+
+    uint16_t                       listenPort = 0;
+    AuPacketHandlerFunctionWithArg packetFn   = NULL;
+    void                          *packetArg  = NULL;
+    std::vector<std::string>       replyStrs;
+};
+
+// *********************************************************************************************
+// EOF
@@ -0,0 +1,35 @@
+/*
+   File: ESPUI.h (native test stub)
+   Project: PixelRadio, an RBDS/RDS FM Transmitter (QN8027 Digital FM IC)
+   Version: 1.1.2
+   Creation: Oct-18-2022
+   Revised:  Oct-18-2022
+   Revision History: See PixelRadio.cpp
+   Project Leader: T. Black (thomastech)
+   Contributors: thomastech
+
+   (c) copyright T. Black 2021-2022, Licensed under GNU GPL 3.0 and later, under this
+   license absolutely no warranty is given.
+   This Code was formatted with the uncrustify extension.
+
+   Note 1: Types only. The modules under test must not call the Web UI.
+ */
+
+// *********************************************************************************************
+
+#pragma once
+#include "Arduino.h"
+
+// *********************************************************************************************
+
+enum ControlColor : uint8_t { Turquoise, Emerald, Peterriver, Wetasphalt, Sunflower, Carrot, Alizarin, Dark, None = 0xFF };
+
+class Control {
+public:
+    uint16_t     id;
+    String       value;
+    ControlColor color;
+};
+
+// *********************************************************************************************
+// EOF
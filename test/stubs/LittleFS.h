@@ -0,0 +1,94 @@
+/*
+   File: LittleFS.h (native test stub)
+   Project: PixelRadio, an RBDS/RDS FM Transmitter (QN8027 Digital FM IC)
+   Version: 1.1.2
+   Creation: Oct-18-2022
+   Revised:  Oct-18-2022
+   Revision History: See PixelRadio.cpp
+   Project Leader: T. Black (thomastech)
+   Contributors: thomastech
+
+   (c) copyright T. Black 2021-2022, Licensed under GNU GPL 3.0 and later, under this
+   license absolutely no warranty is given.
+   This Code was formatted with the uncrustify extension.
+
+   Note 1: The files are kept in RAM (LittleFS.files), so a test can look at them. Only the File
+           calls used by the telemetry spill file.
+ */
+
+// *********************************************************************************************
+
+#pragma once
+#include <algorithm>
+#include <map>
+#include "Arduino.h"
+
+// *********************************************************************************************
+
+#define FILE_READ   "r"
+#define FILE_WRITE  "w"
+#define FILE_APPEND "a"
+
+class File {
+public:
+    File(void) {}
+    File(std::vector<uint8_t> *data) : fileData(data) {}
+
+    operator bool() const {
+        return fileData != NULL;
+    }
+
+    size_t write(const uint8_t *buff, size_t size) {
+        fileData->insert(fileData->end(), buff, buff + size);
+        return size;
+    }
+
+    size_t read(uint8_t *buff, size_t size) {
+        size = std::min(size, fileData->size() - std::min(pos, fileData->size()));
+        memcpy(buff, fileData->data() + pos, size);
+        pos += size;
+        return size;
+    }
+
+    bool seek(uint32_t newPos) {
+        pos = newPos;
+        return newPos <= fileData->size();
+    }
+
+    void close(void) {
+        fileData = NULL;
+    }
+
+private:
+    std::vector<uint8_t> *fileData = NULL;
+    size_t                pos      = 0;
+};
+
+class LittleFSFS {
+public:
+    File open(const char *path, const char *mode) {
+        if (!strcmp(mode, FILE_READ) && !exists(path)) {
+            return File();
+        }
+
+        if (!strcmp(mode, FILE_WRITE)) {
+            files[path].clear();
+        }
+        return File(&files[path]);
+    }
+
+    bool exists(const char *path) {
+        return files.count(path) != 0;
+    }
+
+    bool remove(const char *path) {
+        return files.erase(path) != 0;
+    }
+
+    std::map<std::string, std::vector<uint8_t> > files;
+};
+
+inline LittleFSFS LittleFS;
+
+// *********************************************************************************************
+// EOF
@@ -0,0 +1,72 @@
+/*
+   File: WiFi.h (native test stub)
+   Project: PixelRadio, an RBDS/RDS FM Transmitter (QN8027 Digital FM IC)
+   Version: 1.1.2
+   Creation: Oct-18-2022
+   Revised:  Oct-18-2022
+   Revision History: See PixelRadio.cpp
+   Project Leader: T. Black (thomastech)
+   Contributors: thomastech
+
+   (c) copyright T. Black 2021-2022, Licensed under GNU GPL 3.0 and later, under this
+   license absolutely no warranty is given.
+   This Code was formatted with the uncrustify extension.
+
+   Note 1: Only the types PixelRadio.h uses for its defaults, IPAddress for the UDP Controller, and
+           WiFi.status(). A test sets WiFi.wifiStatus to take the network down.
+ */
+
+// *********************************************************************************************
+
+#pragma once
+#include "Arduino.h"
+
+// *********************************************************************************************
+
+typedef enum { WIFI_POWER_19_5dBm = 78 } wifi_power_t;
+
+class IPAddress {
+public:
+    IPAddress(void) : addr{0, 0, 0, 0} {}
+    IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) : addr{a, b, c, d} {}
+    IPAddress(uint32_t value) { // Network byte order, as on the ESP32.
+        memcpy(addr, &value, sizeof(addr));
+    }
+
+    operator uint32_t() const {
+        uint32_t value;
+
+        memcpy(&value, addr, sizeof(value));
+        return value;
+    }
+
+    uint8_t operator[](int index) const {
+        return addr[index & 0x03];
+    }
+
+    String toString(void) const {
+        char buff[16];
+
+        snprintf(buff, sizeof(buff), "%u.%u.%u.%u", addr[0], addr[1], addr[2], addr[3]);
+        return String(buff);
+    }
+
+private:
+    uint8_t addr[4];
+};
+
+typedef enum { WL_IDLE_STATUS = 0, WL_CONNECTED = 3, WL_DISCONNECTED = 6 } wl_status_t;
+
+class WiFiClass {
+public:
+    wl_status_t status(void) {
+        return wifiStatus;
+    }
+
+    wl_status_t wifiStatus = WL_CONNECTED;
+};
+
+inline WiFiClass WiFi;
+
+// *********************************************************************************************
+// EOF
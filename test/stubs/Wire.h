@@ -0,0 +1,108 @@
+/*
+   File: Wire.h (native test stub)
+   Project: PixelRadio, an RBDS/RDS FM Transmitter (QN8027 Digital FM IC)
+   Version: 1.1.2
+   Creation: Oct-18-2022
+   Revised:  Oct-18-2022
+   Revision History: See PixelRadio.cpp
+   Project Leader: T. Black (thomastech)
+   Contributors: thomastech
+
+   (c) copyright T. Black 2021-2022, Licensed under GNU GPL 3.0 and later, under this
+   license absolutely no warranty is given.
+   This Code was formatted with the uncrustify extension.
+
+   Note 1: The I2C bus is a 32 register file (one device, auto-increment addressing). Every
+           transaction is counted in txnCnt, so a test can report the radio calls it caused.
+   Note 2: A test can model the chip with the writeHook / readHook callbacks (e.g. the
+           QN8027 STATUS_REG RDS toggle bit).
+ */
+
+// *********************************************************************************************
+
+#pragma once
+#include "Arduino.h"
+
+// *********************************************************************************************
+
+class TwoWire {
+public:
+    bool begin(int sda = -1, int scl = -1, uint32_t freq = 0) {
+        return true;
+    }
+
+    bool setClock(uint32_t freq) {
+        return true;
+    }
+
+    void beginTransmission(uint8_t addr) {
+        txnCnt++;
+        regPtr = -1;
+    }
+
+    uint8_t endTransmission(bool stopFlg = true) {
+        return 0; // ACK.
+    }
+
+    size_t write(uint8_t data) {
+        if (regPtr < 0) {
+            regPtr = data & 0x1F;
+        }
+        else {
+            regs[regPtr] = data;
+
+            if (writeHook) {
+                writeHook(regPtr, data);
+            }
+            regPtr = (regPtr + 1) & 0x1F;
+        }
+        return 1;
+    }
+
+    size_t write(const uint8_t *data, size_t len) {
+        for (size_t i = 0; i < len; i++) {
+            write(data[i]);
+        }
+        return len;
+    }
+
+    uint8_t requestFrom(uint8_t addr, uint8_t len) {
+        readCnt = len;
+        return len;
+    }
+
+    int available(void) {
+        return readCnt;
+    }
+
+    int read(void) {
+        uint8_t data;
+
+        if (!readCnt) {
+            return -1;
+        }
+        readCnt--;
+        regPtr &= 0x1F;
+
+        if (readHook) {
+            readHook(regPtr);
+        }
+        data   = regs[regPtr];
+        regPtr = (regPtr + 1) & 0x1F;
+        return data;
+    }
+
+    uint8_t  regs[32] = { 0 };
+    uint32_t txnCnt   = 0;
+    void (*writeHook)(uint8_t reg, uint8_t data) = nullptr;
+    void (*readHook)(uint8_t reg)                = nullptr;
+
+private:
+    int     regPtr  = -1;
+    uint8_t readCnt = 0;
+};
+
+inline TwoWire Wire;
+
+// *********************************************************************************************
+// EOF
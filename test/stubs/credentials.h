@@ -0,0 +1,24 @@
+/*
+   File: credentials.h (native test stub)
+   Project: PixelRadio, an RBDS/RDS FM Transmitter (QN8027 Digital FM IC)
+   Version: 1.1.2
+   Creation: Oct-18-2022
+   Revised:  Oct-18-2022
+   Revision History: See PixelRadio.cpp
+   Project Leader: T. Black (thomastech)
+   Contributors: thomastech
+
+   (c) copyright T. Black 2021-2022, Licensed under GNU GPL 3.0 and later, under this
+   license absolutely no warranty is given.
+   This Code was formatted with the uncrustify extension.
+
+   Note 1: Used only when src/credentials.h has not been created (see credentials_user.h).
+ */
+
+// *********************************************************************************************
+
+#pragma once
+#include "../../src/credentials_user.h"
+
+// *********************************************************************************************
+// EOF
@@ -0,0 +1,722 @@
+/*
+   File: test_main.cpp (test_http_control)
+   Project: PixelRadio, an RBDS/RDS FM Transmitter (QN8027 Digital FM IC)
+   Version: 1.1.2
+   Creation: Oct-18-2022
+   Revised:  Oct-18-2022
+   Revision History: See PixelRadio.cpp
+   Project Leader: T. Black (thomastech)
+   Contributors: thomastech
+
+   (c) copyright T. Black 2021-2022, Licensed under GNU GPL 3.0 and later, under this
+   license absolutely no warranty is given.
+   This Code was formatted with the uncrustify extension.
+
+   Note 1: HTTP Controller connection tests. Run on the host: pio test -e native -f test_http_control
+   Note 2: The requests are answered by httpClientReceive(), the receive loop that webServer.cpp's
+           httpClientData() calls, through processHttpRequest() and makeHttpPageStr(). Only the command
+           itself is a stand-in: dispatchCommand() echoes the argument in its reply, for checking.
+   Note 3: test_keep_alive_load runs many keep-alive clients that pipeline their requests. Their data
+           is interleaved in random size TCP segments.
+   Note 4: The loopback tests serve real TCP connections on 127.0.0.1 (one task serves all, as AsyncTCP
+           does). test_close_compare reports commands/s with keep-alive against close-per-request.
+           test_concurrent_load reports requests/s and the latency percentiles of many mixed clients.
+           They are skipped on Windows.
+ */
+
+// *********************************************************************************************
+
+#include <unity.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "../../src/httpControl.cpp" // Not in [env:native]'s source filter, it needs the stand-ins below.
+
+#ifndef _WIN32
+# include <arpa/inet.h>
+# include <fcntl.h>
+# include <netinet/in.h>
+# include <netinet/tcp.h>
+# include <poll.h>
+# include <sys/socket.h>
+# include <unistd.h>
+#endif // ifndef _WIN32
+
+// *********************************************************************************************
+
+const uint16_t LOAD_CLIENT_CNT = 64;   // Keep-alive clients in the load test.
+const uint16_t LOAD_ROUND_CNT  = 50;   // Connections opened by each client.
+const uint16_t LOAD_SEG_MAX    = 1460; // Largest TCP segment, one Ethernet MSS.
+const uint32_t COMPARE_REQ_CNT = 5000; // Requests sent in each mode by test_close_compare.
+const uint16_t CONC_CLIENT_CNT = 64;   // Concurrent clients in test_concurrent_load.
+const uint32_t CONC_REQ_CNT    = 500;  // Requests sent by each keep-alive client. Close clients send a fifth.
+
+// *********************************************************************************************
+// Functions used by httpControl.cpp.
+static void testReply(char *replyBuff, const cmdEntry_t *cmd, bool successFlg, const String& payloadStr)
+{
+    sprintf(replyBuff, "{\"%s\": \"%s\"}", cmd->nameStr, successFlg ? payloadStr.c_str() : "fail");
+}
+
+static const cmdEntry_t rtmEntry = { CMD_RADIOTEXT_STR, "RadioText Message", NULL, testReply, CMD_CLASS_RDS, NULL, NULL,
+                                     RDS_TEXT_MAX_SZ, 0, CMD_REMOTE_CNTRLS };
+
+const cmdEntry_t* findCommand(const char *nameStr, uint8_t controller)
+{
+    return strcmp(nameStr, rtmEntry.nameStr) ? NULL : &rtmEntry;
+}
+
+// dispatchCommand(): The reply echoes the argument.
+bool dispatchCommand(const cmdEntry_t *cmd, String payloadStr, uint8_t controller, char *replyBuff, uint32_t rxMicros)
+{
+    cmd->replyFn(replyBuff, cmd, true, payloadStr);
+    return true;
+}
+
+// *********************************************************************************************
+static uint32_t rng = 20221018;
+
+static uint32_t testRandom(void) // xorshift32.
+{
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return rng;
+}
+
+static unsigned long simMillis = 0;
+
+static unsigned long simMicros(void)
+{
+    return simMillis * 1000UL;
+}
+
+// loadRequest(): Request n of a connection, its query or POST data holds tagStr and n for checking.
+static std::string loadRequest(const std::string& tagStr, uint32_t n, bool closeFlg)
+{
+    std::string argStr  = tagStr + "-" + std::to_string(n);
+    std::string connStr = closeFlg ? "Connection: close\r\n" : ((n % 3) ? "" : "Connection: keep-alive\r\n");
+    std::string bodyStr;
+
+    if (n % 2) {
+        return "GET /cmd?rtm=Load%20" + argStr + " HTTP/1.1\r\nHost: pixelradio\r\n" + connStr + "\r\n";
+    }
+    bodyStr = "rtm=Load+" + argStr;
+    return "POST /cmd HTTP/1.1\r\nHost: pixelradio\r\n" + connStr + "Content-Length: " + std::to_string(bodyStr.length()) +
+           "\r\n\r\n" + bodyStr;
+}
+
+// takeReply(): Remove the first complete reply from rxStr. Returns false if there is none yet. closeFlg is true if
+// the reply closes the connection. Any reply that is not a command echo sets bodyStr to "bad".
+static bool takeReply(std::string& rxStr, std::string *argStr, bool *closeFlg)
+{
+    size_t      hdrEnd = rxStr.find("\r\n\r\n");
+    size_t      lenPos;
+    size_t      bodyLen;
+    size_t      argPos;
+    std::string hdrStr;
+    std::string bodyStr;
+
+    if (hdrEnd == std::string::npos) {
+        return false;
+    }
+    hdrStr = rxStr.substr(0, hdrEnd + 4);
+    lenPos = hdrStr.find("Content-Length: ");
+
+    if ((hdrStr.compare(0, strlen(HTML_HEADER_STR), HTML_HEADER_STR) != 0) || (lenPos == std::string::npos)) {
+        *argStr = "bad";
+        rxStr.clear();
+        return true;
+    }
+    bodyLen = strtoul(hdrStr.c_str() + lenPos + 16, NULL, 10);
+
+    if (rxStr.length() < hdrEnd + 4 + bodyLen) {
+        return false;
+    }
+    bodyStr   = rxStr.substr(hdrEnd + 4, bodyLen);
+    *closeFlg = hdrStr.find(HTML_CONN_CLOSE_STR) != std::string::npos;
+    rxStr.erase(0, hdrEnd + 4 + bodyLen);
+
+    argPos = bodyStr.find("{\"rtm\": \"");
+    *argStr = (argPos == std::string::npos) ? "bad" : bodyStr.substr(argPos + 9, bodyStr.find('"', argPos + 9) - argPos - 9);
+
+    return true;
+}
+
+// *********************************************************************************************
+void setUp(void)    {}
+void tearDown(void) {}
+
+// *********************************************************************************************
+static void appendWrite(void *arg, const char *data, size_t len)
+{
+    ((std::string *)arg)->append(data, len);
+}
+
+void test_request_reply(void)
+{
+    static httpClient_t conn;
+    std::string argStr;
+    std::string replyStr;
+    std::string reqStr = loadRequest("A", 1, false) + loadRequest("A", 2, false) + "GET /favicon.ico HTTP/1.1\r\n\r\n";
+    bool        closeFlg;
+
+    httpClientInit(&conn);
+    TEST_ASSERT_EQUAL_UINT8(HTTP_CLIENT_CLOSE, httpClientReceive(&conn, reqStr.data(), reqStr.length(), appendWrite, &replyStr));
+    TEST_ASSERT_TRUE(takeReply(replyStr, &argStr, &closeFlg));
+    TEST_ASSERT_EQUAL_STRING("Load A-1", argStr.c_str());
+    TEST_ASSERT_FALSE(closeFlg);
+    TEST_ASSERT_TRUE(takeReply(replyStr, &argStr, &closeFlg));
+    TEST_ASSERT_EQUAL_STRING("Load A-2", argStr.c_str());
+    TEST_ASSERT_FALSE(closeFlg);
+    TEST_ASSERT_TRUE(replyStr.empty()); // No reply to the empty request, only the close.
+    TEST_ASSERT_TRUE(conn.doneFlg);
+    TEST_ASSERT_EQUAL_UINT8(HTTP_CLIENT_OPEN, httpClientReceive(&conn, reqStr.data(), reqStr.length(), appendWrite, &replyStr));
+    TEST_ASSERT_TRUE(replyStr.empty()); // Closing, extra data is ignored.
+
+    reqStr = "GET /cmd?psn=Hello HTTP/1.0\r\n\r\n"; // Unknown command, HTTP/1.0 closes.
+    httpClientInit(&conn);
+    TEST_ASSERT_EQUAL_UINT8(HTTP_CLIENT_CLOSE, httpClientReceive(&conn, reqStr.data(), reqStr.length(), appendWrite, &replyStr));
+    TEST_ASSERT_TRUE(replyStr.find("{\"cmd\": \"undefined\"}") != std::string::npos);
+    TEST_ASSERT_TRUE(replyStr.find(HTML_CONN_CLOSE_STR) != std::string::npos);
+
+    replyStr.clear();
+    reqStr = "GET /cmd?rtm= HTTP/1.1\r\nConnection: close\r\n\r\n"; // Missing argument.
+    httpClientInit(&conn);
+    TEST_ASSERT_EQUAL_UINT8(HTTP_CLIENT_CLOSE, httpClientReceive(&conn, reqStr.data(), reqStr.length(), appendWrite, &replyStr));
+    TEST_ASSERT_TRUE(takeReply(replyStr, &argStr, &closeFlg));
+    TEST_ASSERT_EQUAL_STRING("fail", argStr.c_str());
+    TEST_ASSERT_TRUE(closeFlg);
+
+    replyStr.clear();
+    reqStr = "GET /events HTTP/1.1\r\n\r\n" + loadRequest("A", 1, false);
+    httpClientInit(&conn);
+    TEST_ASSERT_EQUAL_UINT8(HTTP_CLIENT_EVENTS, httpClientReceive(&conn, reqStr.data(), reqStr.length(), appendWrite, &replyStr));
+    TEST_ASSERT_TRUE(replyStr.empty()); // The event stream is started by webServer.cpp.
+}
+
+// *********************************************************************************************
+void test_keep_alive_max(void)
+{
+    static httpClient_t conn;
+    std::string argStr;
+    std::string replyStr;
+    std::string reqStr;
+    bool        closeFlg = false;
+    uint16_t    replyCnt = 0;
+
+    for (uint16_t n = 0; n < HTTP_KEEP_ALIVE_MAX + 5; n++) {
+        reqStr += loadRequest("M", n, false);
+    }
+    httpClientInit(&conn);
+    TEST_ASSERT_EQUAL_UINT8(HTTP_CLIENT_CLOSE, httpClientReceive(&conn, reqStr.data(), reqStr.length(), appendWrite, &replyStr));
+
+    while (takeReply(replyStr, &argStr, &closeFlg)) {
+        TEST_ASSERT_EQUAL_STRING(("Load M-" + std::to_string(replyCnt)).c_str(), argStr.c_str());
+        TEST_ASSERT_EQUAL(++replyCnt == HTTP_KEEP_ALIVE_MAX, closeFlg); // Only the last reply closes.
+    }
+    TEST_ASSERT_EQUAL_UINT16(HTTP_KEEP_ALIVE_MAX, replyCnt);
+    TEST_ASSERT_EQUAL_UINT8(HTTP_KEEP_ALIVE_MAX, conn.reqCnt);
+}
+
+// *********************************************************************************************
+void test_client_poll(void)
+{
+    static httpClient_t conn;
+    std::string replyStr;
+    std::string reqStr = loadRequest("P", 1, false);
+
+    stubMicrosFn = simMicros;
+    simMillis    = 1000;
+    httpClientInit(&conn);
+    simMillis += CLIENT_TIMEOUT;
+    TEST_ASSERT_EQUAL_UINT8(HTTP_CLIENT_OPEN, httpClientPoll(&conn));
+    simMillis++;
+    TEST_ASSERT_EQUAL_UINT8(HTTP_CLIENT_CLOSE, httpClientPoll(&conn)); // Connected, no request.
+    TEST_ASSERT_EQUAL_UINT8(HTTP_CLIENT_OPEN, httpClientPoll(&conn));  // Closing.
+
+    httpClientInit(&conn);
+    httpClientReceive(&conn, reqStr.data(), reqStr.length(), appendWrite, &replyStr);
+    simMillis += HTTP_KEEP_ALIVE_TIME;
+    TEST_ASSERT_EQUAL_UINT8(HTTP_CLIENT_OPEN, httpClientPoll(&conn));
+    httpClientReceive(&conn, reqStr.data(), 10, appendWrite, &replyStr); // Next request starts, slowly.
+    simMillis += CLIENT_TIMEOUT;
+    TEST_ASSERT_EQUAL_UINT8(HTTP_CLIENT_OPEN, httpClientPoll(&conn));
+    httpClientReceive(&conn, reqStr.data() + 10, reqStr.length() - 10, appendWrite, &replyStr);
+    simMillis += HTTP_KEEP_ALIVE_TIME + 1;
+    TEST_ASSERT_EQUAL_UINT8(HTTP_CLIENT_CLOSE, httpClientPoll(&conn)); // Idle keep-alive.
+    TEST_ASSERT_EQUAL_UINT8(2, conn.reqCnt);
+    stubMicrosFn = nullptr;
+}
+
+// *********************************************************************************************
+// Keep-alive load test: One connection = a stream of pipelined requests. The last one asks to close,
+// unless the stream is longer than HTTP_KEEP_ALIVE_MAX (the server closes then, extra data is ignored).
+typedef struct {
+    httpClient_t conn;
+    bool         closedFlg;              // httpClientReceive() asked for the close.
+    uint16_t     sendCnt;                // Requests in streamStr.
+    std::string  tagStr;                 // Connection name, in each request.
+    std::string  streamStr;              // Everything the client sends on this connection.
+    std::string  rxStr;                  // Replies.
+    size_t       sentLen;
+} loadClient_t;
+
+// loadConnect(): Open a new connection with 1..HTTP_KEEP_ALIVE_MAX + 10 requests.
+static void loadConnect(loadClient_t *client, uint16_t idx, uint16_t round)
+{
+    uint16_t reqCnt = 1 + testRandom() % (HTTP_KEEP_ALIVE_MAX + 10);
+
+    httpClientInit(&client->conn);
+    client->closedFlg = false;
+    client->sentLen   = 0;
+    client->sendCnt   = reqCnt;
+    client->tagStr    = std::to_string(idx) + "." + std::to_string(round);
+    client->streamStr.clear();
+    client->rxStr.clear();
+
+    for (uint16_t n = 0; n < reqCnt; n++) {
+        client->streamStr += loadRequest(client->tagStr, n, n == reqCnt - 1);
+    }
+}
+
+// loadCheck(): Check the replies of a finished connection. Returns the number of errors.
+static uint32_t loadCheck(loadClient_t *client, uint32_t *replyCnt)
+{
+    std::string argStr;
+    bool        closeFlg  = false;
+    uint16_t    expectCnt = (client->sendCnt < HTTP_KEEP_ALIVE_MAX) ? client->sendCnt : HTTP_KEEP_ALIVE_MAX;
+    uint16_t    cnt       = 0;
+    uint32_t    errCnt    = 0;
+
+    while (takeReply(client->rxStr, &argStr, &closeFlg)) {
+        errCnt += (argStr != "Load " + client->tagStr + "-" + std::to_string(cnt)) ? 1 : 0;
+        errCnt += (closeFlg != (cnt == expectCnt - 1)) ? 1 : 0;
+        cnt++;
+    }
+    *replyCnt += cnt;
+
+    return errCnt + ((cnt == expectCnt) && client->closedFlg && client->rxStr.empty() ? 0 : 1);
+}
+
+void test_keep_alive_load(void)
+{
+    static loadClient_t clientTbl[LOAD_CLIENT_CNT];
+    char          msgBuff[100];
+    uint16_t      roundTbl[LOAD_CLIENT_CNT] = { 0 };
+    uint16_t      liveCnt  = LOAD_CLIENT_CNT;
+    uint32_t      connCnt  = 0;
+    uint32_t      errCnt   = 0;
+    uint32_t      replyCnt = 0;
+    uint32_t      segCnt   = 0;
+    uint64_t      byteCnt  = 0;
+    unsigned long loadMicros;
+
+    for (uint16_t i = 0; i < LOAD_CLIENT_CNT; i++) {
+        loadConnect(&clientTbl[i], i, 0);
+    }
+    loadMicros = micros();
+
+    while (liveCnt > 0) {
+        loadClient_t *client = &clientTbl[testRandom() % LOAD_CLIENT_CNT]; // Segments arrive interleaved.
+        uint16_t      idx    = client - clientTbl;
+        size_t        segLen = 1 + testRandom() % LOAD_SEG_MAX;
+
+        if (roundTbl[idx] >= LOAD_ROUND_CNT) {
+            continue;
+        }
+        segLen = std::min(segLen, client->streamStr.length() - client->sentLen);
+
+        if (httpClientReceive(&client->conn, client->streamStr.data() + client->sentLen, segLen, appendWrite,
+                              &client->rxStr) == HTTP_CLIENT_CLOSE) {
+            errCnt           += client->closedFlg ? 1 : 0; // Only one close.
+            client->closedFlg = true;
+        }
+        client->sentLen += segLen;
+        byteCnt         += segLen;
+        segCnt++;
+
+        if (client->sentLen < client->streamStr.length()) {
+            continue;
+        }
+
+        // Everything sent. The server closed after the last request, or at HTTP_KEEP_ALIVE_MAX.
+        errCnt += loadCheck(client, &replyCnt);
+        connCnt++;
+
+        if (++roundTbl[idx] < LOAD_ROUND_CNT) {
+            loadConnect(client, idx, roundTbl[idx]);
+        }
+        else {
+            liveCnt--;
+        }
+    }
+    loadMicros = micros() - loadMicros;
+
+    snprintf(msgBuff, sizeof(msgBuff), "Load: %u connections, %u requests in %u segments (%1.1f MB), %1.3f uS/Request.",
+             connCnt, replyCnt, segCnt, byteCnt / 1000000.0, float(loadMicros) / float(replyCnt));
+    TEST_MESSAGE(msgBuff);
+    TEST_ASSERT_EQUAL_UINT32(LOAD_CLIENT_CNT * LOAD_ROUND_CNT, connCnt);
+    TEST_ASSERT_EQUAL_UINT32(0, errCnt);
+}
+
+// *********************************************************************************************
+// Loopback server and clients, all served from one poll() loop.
+#ifndef _WIN32
+
+typedef struct {
+    int          fd;
+    httpClient_t conn;
+    std::string  txStr;                  // Reply data not yet sent.
+    bool         closeFlg;               // Close once txStr is sent.
+} srvConn_t;
+
+typedef struct {
+    bool                      keepFlg;   // Keep-alive, else one request per connection ("Connection: close").
+    uint8_t                   depth;     // Requests in flight (pipelined).
+    uint32_t                  sendCnt;   // Requests to send.
+    int                       fd;        // -1 = not connected.
+    uint32_t                  sentCnt;   // Requests sent.
+    uint32_t                  doneCnt;   // Replies received.
+    uint16_t                  connReqCnt; // Requests sent on this connection.
+    std::string               rxStr;
+    std::vector<unsigned long> sentMicros; // Send time of each request in flight, oldest first.
+} loopClient_t;
+
+typedef struct {
+    uint32_t                   reqCnt;
+    uint32_t                   connCnt;
+    uint32_t                   errCnt;
+    unsigned long              runMicros;
+    std::vector<unsigned long> latency;  // Request latency (send to reply), in uS.
+} loopResult_t;
+
+static int listenFd = -1;
+static uint16_t listenPort = 0;
+
+static void noDelay(int fd)
+{
+    int one = 1;
+
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+}
+
+// loopListen(): Open the server socket on a free loopback port. Returns false if the host has no loopback.
+static bool loopListen(void)
+{
+    sockaddr_in addr;
+    socklen_t   addrLen = sizeof(addr);
+
+    if (listenFd >= 0) {
+        return true;
+    }
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family      = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    listenFd             = socket(AF_INET, SOCK_STREAM, 0);
+
+    if ((listenFd < 0) || (bind(listenFd, (sockaddr *)&addr, sizeof(addr)) != 0) || (listen(listenFd, 256) != 0) ||
+        (getsockname(listenFd, (sockaddr *)&addr, &addrLen) != 0)) {
+        return false;
+    }
+    listenPort = ntohs(addr.sin_port);
+    fcntl(listenFd, F_SETFL, fcntl(listenFd, F_GETFL) | O_NONBLOCK);
+
+    return true;
+}
+
+static void srvWrite(void *arg, const char *data, size_t len)
+{
+    ((srvConn_t *)arg)->txStr.append(data, len);
+}
+
+// srvFlush(): Send what the socket takes. Returns false once the connection is closed.
+static bool srvFlush(srvConn_t *srv)
+{
+    ssize_t len;
+
+    while (!srv->txStr.empty()) {
+        len = send(srv->fd, srv->txStr.data(), srv->txStr.length(), MSG_NOSIGNAL);
+
+        if (len <= 0) {
+            return !((len < 0) && (errno != EAGAIN) && (errno != EWOULDBLOCK));
+        }
+        srv->txStr.erase(0, len);
+    }
+
+    if (srv->closeFlg) {
+        close(srv->fd);
+        return false;
+    }
+    return true;
+}
+
+// clientSend(): Connect if needed, then send requests until depth are in flight.
+static void clientSend(loopClient_t *client, uint16_t idx, loopResult_t *result)
+{
+    sockaddr_in addr;
+    std::string reqStr;
+    bool        closeFlg;
+
+    if (client->fd < 0) {
+        if (client->sentCnt >= client->sendCnt) {
+            return;
+        }
+        memset(&addr, 0, sizeof(addr));
+        addr.sin_family      = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port        = htons(listenPort);
+        client->fd           = socket(AF_INET, SOCK_STREAM, 0);
+        connect(client->fd, (sockaddr *)&addr, sizeof(addr)); // Blocking, quick on loopback.
+        noDelay(client->fd);
+        client->connReqCnt = 0;
+        result->connCnt++;
+    }
+
+    while ((client->sentMicros.size() < client->depth) && (client->sentCnt < client->sendCnt) &&
+           (client->keepFlg ? (client->connReqCnt < HTTP_KEEP_ALIVE_MAX) : (client->connReqCnt == 0))) {
+        closeFlg = !client->keepFlg;
+        reqStr   = loadRequest(std::to_string(idx), client->sentCnt, closeFlg);
+
+        if (send(client->fd, reqStr.data(), reqStr.length(), MSG_NOSIGNAL) != (ssize_t)reqStr.length()) {
+            result->errCnt++; // Small requests, the socket buffer always takes them.
+        }
+        client->sentMicros.push_back(micros());
+        client->sentCnt++;
+        client->connReqCnt++;
+    }
+}
+
+// clientReceive(): Read the replies. Checks each one and the server's close.
+static void clientReceive(loopClient_t *client, uint16_t idx, loopResult_t *result)
+{
+    char        buff[2048];
+    ssize_t     len;
+    std::string argStr;
+    bool        closeFlg;
+    bool        lastFlg;
+    uint32_t    reqNum;
+
+    while ((len = recv(client->fd, buff, sizeof(buff), 0)) > 0) {
+        client->rxStr.append(buff, len);
+    }
+
+    while (!client->sentMicros.empty() && takeReply(client->rxStr, &argStr, &closeFlg)) {
+        reqNum  = client->doneCnt++;
+        lastFlg = !client->keepFlg || (client->connReqCnt == HTTP_KEEP_ALIVE_MAX && client->sentMicros.size() == 1);
+        result->latency.push_back(micros() - client->sentMicros.front());
+        result->errCnt += (argStr != "Load " + std::to_string(idx) + "-" + std::to_string(reqNum)) ? 1 : 0;
+        result->errCnt += (closeFlg != lastFlg) ? 1 : 0;
+        result->reqCnt++;
+        client->sentMicros.erase(client->sentMicros.begin());
+    }
+
+    if (len == 0) { // Server closed.
+        result->errCnt += (client->sentMicros.empty() && client->rxStr.empty()) ? 0 : 1;
+        close(client->fd);
+        client->fd = -1;
+        client->sentMicros.clear();
+        client->rxStr.clear();
+    }
+}
+
+// runLoopback(): Serve the clients until each one has its replies. The server is AsyncTCP's part: accept, receive,
+// httpClientReceive(), send, close.
+static loopResult_t runLoopback(std::vector<loopClient_t>& clients)
+{
+    loopResult_t              result = { 0, 0, 0, 0, {} };
+    std::vector<srvConn_t *>  srvTbl;
+    std::vector<pollfd>       pollTbl;
+    char                      buff[LOAD_SEG_MAX];
+    ssize_t                   len = 1;
+    uint32_t                  liveCnt = clients.size();
+
+    for (loopClient_t& client : clients) {
+        client.fd = -1;
+        client.sentCnt = client.doneCnt = 0;
+        client.rxStr.clear();
+        client.sentMicros.clear();
+    }
+    result.runMicros = micros();
+
+    while (liveCnt > 0) {
+        for (uint16_t i = 0; i < clients.size(); i++) {
+            clientSend(&clients[i], i, &result);
+        }
+
+        pollTbl.clear();
+        pollTbl.push_back({ listenFd, POLLIN, 0 });
+
+        for (srvConn_t *srv : srvTbl) {
+            pollTbl.push_back({ srv->fd, (short)(POLLIN | (srv->txStr.empty() ? 0 : POLLOUT)), 0 });
+        }
+
+        for (loopClient_t& client : clients) {
+            pollTbl.push_back({ client.fd, POLLIN, 0 }); // fd -1 is skipped.
+        }
+
+        if (poll(pollTbl.data(), pollTbl.size(), 1000) <= 0) {
+            result.errCnt++; // Stalled.
+            break;
+        }
+
+        if (pollTbl[0].revents) {
+            int fd;
+
+            while ((fd = accept(listenFd, NULL, NULL)) >= 0) {
+                srvConn_t *srv = new srvConn_t;
+
+                noDelay(fd);
+                srv->fd       = fd;
+                srv->closeFlg = false;
+                httpClientInit(&srv->conn);
+                srvTbl.push_back(srv);
+            }
+        }
+
+        for (size_t i = 0; i < srvTbl.size(); i++) {
+            srvConn_t *srv  = srvTbl[i];
+            bool       liveFlg = true;
+
+            if ((i + 1 < pollTbl.size()) && (pollTbl[i + 1].fd == srv->fd) && pollTbl[i + 1].revents) {
+                while (liveFlg && !srv->closeFlg && ((len = recv(srv->fd, buff, 1 + testRandom() % sizeof(buff), 0)) > 0)) {
+                    if (httpClientReceive(&srv->conn, buff, len, srvWrite, srv) != HTTP_CLIENT_OPEN) {
+                        srv->closeFlg = true;
+                    }
+                }
+
+                if (len == 0) { // Client closed.
+                    srv->txStr.clear();
+                    srv->closeFlg = true;
+                }
+            }
+            liveFlg = srvFlush(srv);
+
+            if (!liveFlg) {
+                delete srv;
+                srvTbl.erase(srvTbl.begin() + i--);
+            }
+        }
+
+        liveCnt = 0;
+
+        for (uint16_t i = 0; i < clients.size(); i++) {
+            if (clients[i].fd >= 0) {
+                clientReceive(&clients[i], i, &result);
+            }
+            liveCnt += (clients[i].doneCnt < clients[i].sendCnt) ? 1 : 0;
+        }
+    }
+    result.runMicros = micros() - result.runMicros;
+
+    for (loopClient_t& client : clients) {
+        if (client.fd >= 0) {
+            close(client.fd);
+        }
+    }
+
+    for (srvConn_t *srv : srvTbl) {
+        close(srv->fd);
+        delete srv;
+    }
+
+    return result;
+}
+
+#endif // ifndef _WIN32
+
+// *********************************************************************************************
+// test_close_compare(): One client, commands/s with one connection per request (close), keep-alive, and keep-alive
+// with 8 pipelined requests.
+void test_close_compare(void)
+{
+    #ifdef _WIN32
+    TEST_IGNORE_MESSAGE("Loopback tests need POSIX sockets.");
+    #else // ifdef _WIN32
+    static const struct {
+        const char *nameStr;
+        bool        keepFlg;
+        uint8_t     depth;
+    } modeTbl[] = { { "Close-per-request", false, 1 }, { "Keep-alive", true, 1 }, { "Keep-alive, pipelined x8", true, 8 } };
+    char msgBuff[120];
+    float cmdRate[3];
+
+    if (!loopListen()) {
+        TEST_IGNORE_MESSAGE("No loopback network.");
+    }
+
+    for (uint8_t m = 0; m < 3; m++) {
+        std::vector<loopClient_t> clients(1);
+        loopResult_t result;
+
+        clients[0].keepFlg = modeTbl[m].keepFlg;
+        clients[0].depth   = modeTbl[m].depth;
+        clients[0].sendCnt = COMPARE_REQ_CNT;
+        result             = runLoopback(clients);
+        cmdRate[m]         = result.reqCnt * 1000000.0f / result.runMicros;
+
+        snprintf(msgBuff, sizeof(msgBuff), "%s: %1.0f Commands/s (%u requests, %u connections).", modeTbl[m].nameStr,
+                 cmdRate[m], result.reqCnt, result.connCnt);
+        TEST_MESSAGE(msgBuff);
+        TEST_ASSERT_EQUAL_UINT32(0, result.errCnt);
+        TEST_ASSERT_EQUAL_UINT32(COMPARE_REQ_CNT, result.reqCnt);
+        TEST_ASSERT_EQUAL_UINT32(modeTbl[m].keepFlg ? (COMPARE_REQ_CNT + HTTP_KEEP_ALIVE_MAX - 1) / HTTP_KEEP_ALIVE_MAX :
+                                 COMPARE_REQ_CNT, result.connCnt);
+    }
+    snprintf(msgBuff, sizeof(msgBuff), "Keep-alive is %1.1fx, pipelined %1.1fx the close-per-request rate.",
+             cmdRate[1] / cmdRate[0], cmdRate[2] / cmdRate[0]);
+    TEST_MESSAGE(msgBuff);
+    #endif // ifdef _WIN32
+}
+
+// *********************************************************************************************
+// test_concurrent_load(): Many clients at once: a quarter close-per-request, a quarter keep-alive one request at a
+// time, the rest keep-alive with 2..8 pipelined requests. Reports requests/s and the p50, p99 latency.
+void test_concurrent_load(void)
+{
+    #ifdef _WIN32
+    TEST_IGNORE_MESSAGE("Loopback tests need POSIX sockets.");
+    #else // ifdef _WIN32
+    char msgBuff[140];
+    std::vector<loopClient_t> clients(CONC_CLIENT_CNT);
+    loopResult_t result;
+    uint32_t     sendCnt = 0;
+
+    if (!loopListen()) {
+        TEST_IGNORE_MESSAGE("No loopback network.");
+    }
+
+    for (uint16_t i = 0; i < CONC_CLIENT_CNT; i++) {
+        clients[i].keepFlg = (i % 4) != 0;
+        clients[i].depth   = (i % 4 < 2) ? 1 : 2 + testRandom() % 7;
+        clients[i].sendCnt = clients[i].keepFlg ? CONC_REQ_CNT : CONC_REQ_CNT / 5;
+        sendCnt           += clients[i].sendCnt;
+    }
+    result = runLoopback(clients);
+    std::sort(result.latency.begin(), result.latency.end());
+
+    snprintf(msgBuff, sizeof(msgBuff), "%u clients: %1.0f Requests/s (%u requests, %u connections), latency p50 %lu uS, p99 %lu uS.",
+             CONC_CLIENT_CNT, result.reqCnt * 1000000.0f / result.runMicros, result.reqCnt, result.connCnt,
+             result.latency[result.latency.size() / 2], result.latency[result.latency.size() * 99 / 100]);
+    TEST_MESSAGE(msgBuff);
+    TEST_ASSERT_EQUAL_UINT32(0, result.errCnt);
+    TEST_ASSERT_EQUAL_UINT32(sendCnt, result.reqCnt);
+    #endif // ifdef _WIN32
+}
+
+// *********************************************************************************************
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_request_reply);
+    RUN_TEST(test_keep_alive_max);
+    RUN_TEST(test_client_poll);
+    RUN_TEST(test_keep_alive_load);
+    RUN_TEST(test_close_compare);
+    RUN_TEST(test_concurrent_load);
+    return UNITY_END();
+}
+
+// *********************************************************************************************
+// EOF
@@ -0,0 +1,354 @@
+/*
+   File: test_main.cpp (test_http_parser)
+   Project: PixelRadio, an RBDS/RDS FM Transmitter (QN8027 Digital FM IC)
+   Version: 1.1.2
+   Creation: Oct-18-2022
+   Revised:  Oct-18-2022
+   Revision History: See PixelRadio.cpp
+   Project Leader: T. Black (thomastech)
+   Contributors: thomastech
+
+   (c) copyright T. Black 2021-2022, Licensed under GNU GPL 3.0 and later, under this
+   license absolutely no warranty is given.
+   This Code was formatted with the uncrustify extension.
+
+   Note 1: HTTP Controller request parser tests. Run on the host: pio test -e native -f test_http_parser
+   Note 2: The fuzz test mutates a corpus of good and bad requests and feeds each one in random size
+           pieces. The parser must stay inside its buffer and give the same result as one piece.
+   Note 3: test_parse_bench reports the parse time. It fails only if the output is wrong.
+   Note 4: The keep-alive receive loop is tested with the parser in test_http_control.
+ */
+
+// *********************************************************************************************
+
+#include <unity.h>
+#include <string.h>
+#include <string>
+#include "PixelRadio.h"
+#include "httpParser.h"
+
+// *********************************************************************************************
+
+const uint32_t BENCH_CNT = 100000; // Requests parsed by the benchmark.
+const uint32_t FUZZ_CNT  = 200000; // Mutated requests parsed by the fuzz test.
+
+static const char *postReqStr = "POST /cmd? HTTP/1.1\r\nHost: pixelradio.local:8080\r\nContent-Type: "
+                                "application/x-www-form-urlencoded\r\nContent-Length: 23\r\n\r\nrtm=Now+Playing%3A+Test";
+
+static const char binReqStr[] = "GET /cmd?rtm=\x01\x7f\xff\xfe HTTP/1.1\r\nX: \x00\x01\r\n\r\n"; // Has a NUL.
+
+// Fuzz corpus: Good requests and the odd ones clients and scanners send.
+static const char *corpusTbl[] = {
+    "GET /cmd?aud=mono HTTP/1.1\r\nHost: pixelradio\r\n\r\n",
+    "GET /cmd?rtm=Hello%20World&mute=off HTTP/1.0\r\nConnection: Keep-Alive\r\n\r\n",
+    "POST /batch HTTP/1.1\r\nCONTENT-LENGTH: 27\r\nConnection: close\r\n\r\n{\"freq\": 1011, \"rtm\": \"A\"}\n",
+    "POST /cmd HTTP/1.1\ncontent-length:9\n\nrtm=LF+only",
+    "\r\n\r\nGET /events HTTP/1.1\r\n\r\n",
+    "GET /cmd?psn\n\n",
+    "GET /favicon.ico HTTP/1.1\r\nConnection:\r\n\r\n",
+    "POST /cmd HTTP/1.1\r\nContent-Length: 99999999\r\n\r\nrtm=clamped",
+    "POST /cmd HTTP/1.1\r\nContent-Length: \r\nX-Content-Length: 5\r\n\r\n",
+    "GET /cmd?%%%2%zz%4=%+ HTTP/9.9\r\n\r\n",
+    binReqStr,
+    "GET  /cmd??a=b=c&&=& HTTP/1.1\r\n\r\n",
+};
+
+// *********************************************************************************************
+static uint32_t rng = 20221018;
+
+static uint32_t testRandom(void) // xorshift32.
+{
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return rng;
+}
+
+static uint8_t refHexValue(char c)
+{
+    return isxdigit(c) ? (uint8_t)std::stoi(std::string(1, c), nullptr, 16) : 0;
+}
+
+// refUrlDecode(): Reference URL decoder, written separately from urlDecodeInPlace(). A non-hex
+// escape digit counts as zero. An incomplete trailing escape is dropped.
+static std::string refUrlDecode(const std::string& str)
+{
+    std::string outStr;
+
+    for (size_t i = 0; i < str.length(); i++) {
+        if (str[i] == '%') {
+            if (i + 2 >= str.length()) {
+                break;
+            }
+            outStr += (char)((refHexValue(str[i + 1]) << 4) | refHexValue(str[i + 2]));
+            i      += 2;
+        }
+        else {
+            outStr += (str[i] == '+') ? ' ' : str[i];
+        }
+    }
+    return outStr;
+}
+
+// parseAll(): Parse a request fed in pieces of 1..maxPiece chars (0 = one piece). Returns chars used.
+static size_t parseAll(httpParser_t *parser, const char *data, size_t len, size_t maxPiece)
+{
+    size_t usedLen = 0;
+    size_t pieceLen;
+
+    httpParserInit(parser);
+
+    while ((usedLen < len) && (parser->state != HTTP_PARSE_DONE)) {
+        pieceLen = maxPiece ? 1 + testRandom() % maxPiece : len;
+        pieceLen = (pieceLen > len - usedLen) ? len - usedLen : pieceLen;
+        usedLen += httpParse(parser, data + usedLen, pieceLen);
+    }
+    return usedLen;
+}
+
+// checkBounds(): Every field points into the buffer. Once the request is done, each field is also
+// terminated there (fields are only used then).
+static void checkBounds(const httpParser_t *parser)
+{
+    const char *fieldTbl[] = { parser->method, parser->path, parser->query, parser->body };
+
+    TEST_ASSERT_LESS_OR_EQUAL(HTTP_PARSE_BUFF_SZ, parser->buffLen);
+
+    for (uint8_t i = 0; i < sizeof(fieldTbl) / sizeof(fieldTbl[0]); i++) {
+        TEST_ASSERT_TRUE(fieldTbl[i] >= parser->buff && fieldTbl[i] < parser->buff + HTTP_PARSE_BUFF_SZ);
+
+        if (parser->state == HTTP_PARSE_DONE) {
+            TEST_ASSERT_NOT_NULL(memchr(fieldTbl[i], '\0', parser->buff + HTTP_PARSE_BUFF_SZ - fieldTbl[i]));
+        }
+    }
+}
+
+// sameResult(): Two parses of the same request agree.
+static bool sameResult(const httpParser_t *a, const httpParser_t *b)
+{
+    return (a->state == b->state) && (a->buffLen == b->buffLen) && (a->contentLen == b->contentLen) &&
+           (a->truncFlg == b->truncFlg) && (httpKeepAlive(a) == httpKeepAlive(b)) &&
+           !memcmp(a->buff, b->buff, a->buffLen) && (a->path - a->buff == b->path - b->buff) &&
+           (a->query - a->buff == b->query - b->buff) && (a->body - a->buff == b->body - b->buff);
+}
+
+// *********************************************************************************************
+void setUp(void)    {}
+void tearDown(void) {}
+
+// *********************************************************************************************
+void test_url_decode(void)
+{
+    static const char *decodeTbl[] = {
+        "", "plain", "a+b+c", "Hello%20World", "%41%42%43", "100%25", "%7f", "%7F%7f", "%2B%2b+", "mixed%3Dcase%3d",
+        "%e2%82%ac", "%4a%4A", "rtm=PixelRadio%20%26%20Friends", "/cmd?psn=ON%20AIR", "trailing%4", "trailing%", "%zz%g1"
+    };
+    static const char alphabet[] = "%+aZ09fF=&";
+    char buff[40];
+
+    for (uint8_t i = 0; i < sizeof(decodeTbl) / sizeof(decodeTbl[0]); i++) {
+        strcpy(buff, decodeTbl[i]);
+        TEST_ASSERT_EQUAL_UINT32(refUrlDecode(decodeTbl[i]).length(), urlDecodeInPlace(buff));
+        TEST_ASSERT_EQUAL_STRING(refUrlDecode(decodeTbl[i]).c_str(), buff);
+    }
+
+    for (uint32_t i = 0; i < 10000; i++) { // Random escapes. "%00" would end the string early, skip it.
+        std::string str;
+
+        for (uint8_t j = testRandom() % sizeof(buff); j > 0; j--) {
+            str += alphabet[testRandom() % (sizeof(alphabet) - 1)];
+        }
+
+        if (refUrlDecode(str).find('\0') != std::string::npos) {
+            continue;
+        }
+        strcpy(buff, str.c_str());
+        urlDecodeInPlace(buff);
+        TEST_ASSERT_EQUAL_STRING(refUrlDecode(str).c_str(), buff);
+    }
+}
+
+// *********************************************************************************************
+void test_post_request(void)
+{
+    httpParser_t parser;
+    httpParser_t refParser;
+    char        *argStr;
+    char        *cmdStr;
+    size_t       reqLen = strlen(postReqStr);
+
+    TEST_ASSERT_EQUAL_UINT32(reqLen, parseAll(&refParser, postReqStr, reqLen, 0));
+    TEST_ASSERT_EQUAL_UINT8(HTTP_PARSE_DONE, refParser.state);
+    TEST_ASSERT_EQUAL_STRING("POST", refParser.method);
+    TEST_ASSERT_EQUAL_STRING(HTTP_CMD_PATH_STR, refParser.path);
+    TEST_ASSERT_EQUAL_STRING("", refParser.query);
+    TEST_ASSERT_TRUE(httpKeepAlive(&refParser));
+
+    for (size_t maxPiece = 1; maxPiece < 16; maxPiece++) { // Same result in any size pieces.
+        TEST_ASSERT_EQUAL_UINT32(reqLen, parseAll(&parser, postReqStr, reqLen, maxPiece));
+        TEST_ASSERT_TRUE(sameResult(&parser, &refParser));
+    }
+
+    TEST_ASSERT_NULL(httpNextParam(refParser.body, &cmdStr, &argStr));
+    TEST_ASSERT_EQUAL_STRING(CMD_RADIOTEXT_STR, cmdStr);
+    TEST_ASSERT_EQUAL_STRING("Now Playing: Test", argStr);
+}
+
+// *********************************************************************************************
+void test_pipelined_requests(void)
+{
+    static const char *pipeStr = "GET /cmd?mute=on HTTP/1.1\r\nHost: pixelradio\r\n\r\n"
+                                 "GET /cmd?mute=off HTTP/1.1\r\nConnection: Close\r\n\r\n";
+    httpParser_t parser;
+    size_t       pipeLen = strlen(pipeStr);
+    size_t       usedLen;
+
+    httpParserInit(&parser); // Parser stops at the end of the first request.
+    usedLen = httpParse(&parser, pipeStr, pipeLen);
+    TEST_ASSERT_EQUAL_UINT8(HTTP_PARSE_DONE, parser.state);
+    TEST_ASSERT_TRUE(httpKeepAlive(&parser));
+    TEST_ASSERT_EQUAL_STRING("mute=on", parser.query);
+
+    httpParserInit(&parser);
+    usedLen += httpParse(&parser, pipeStr + usedLen, pipeLen - usedLen);
+    TEST_ASSERT_EQUAL_UINT8(HTTP_PARSE_DONE, parser.state);
+    TEST_ASSERT_FALSE(httpKeepAlive(&parser));
+    TEST_ASSERT_EQUAL_STRING("mute=off", parser.query);
+    TEST_ASSERT_EQUAL_UINT32(pipeLen, usedLen);
+}
+
+// *********************************************************************************************
+void test_odd_requests(void)
+{
+    httpParser_t parser;
+    std::string  longStr = "GET /cmd?rtm=" + std::string(HTTP_PARSE_BUFF_SZ * 2, 'x') + " HTTP/1.1\r\n\r\n";
+
+    parseAll(&parser, corpusTbl[1], strlen(corpusTbl[1]), 0); // HTTP/1.0 asks for keep-alive.
+    TEST_ASSERT_TRUE(httpKeepAlive(&parser));
+
+    parseAll(&parser, corpusTbl[2], strlen(corpusTbl[2]), 0); // Upper case header, close.
+    TEST_ASSERT_EQUAL_UINT16(27, parser.contentLen);
+    TEST_ASSERT_EQUAL_STRING("{\"freq\": 1011, \"rtm\": \"A\"} ", parser.body);
+    TEST_ASSERT_FALSE(httpKeepAlive(&parser));
+
+    parseAll(&parser, corpusTbl[3], strlen(corpusTbl[3]), 0); // LF line endings.
+    TEST_ASSERT_EQUAL_UINT8(HTTP_PARSE_DONE, parser.state);
+    TEST_ASSERT_EQUAL_STRING("rtm=LF+on", parser.body);
+
+    parseAll(&parser, corpusTbl[5], strlen(corpusTbl[5]), 0); // No version (HTTP/0.9), no keep-alive.
+    TEST_ASSERT_EQUAL_UINT8(HTTP_PARSE_DONE, parser.state);
+    TEST_ASSERT_EQUAL_STRING("psn", parser.query);
+    TEST_ASSERT_FALSE(httpKeepAlive(&parser));
+
+    parseAll(&parser, corpusTbl[7], strlen(corpusTbl[7]), 0); // Huge Content-Length is clamped.
+    TEST_ASSERT_EQUAL_UINT16(0xFFFF, parser.contentLen);
+    TEST_ASSERT_EQUAL_UINT8(HTTP_PARSE_BODY, parser.state);
+
+    parseAll(&parser, corpusTbl[8], strlen(corpusTbl[8]), 0); // Only "Content-Length:" at line start counts.
+    TEST_ASSERT_EQUAL_UINT16(0, parser.contentLen);
+    TEST_ASSERT_EQUAL_UINT8(HTTP_PARSE_DONE, parser.state);
+
+    parseAll(&parser, longStr.c_str(), longStr.length(), 0); // Too long, truncated not overrun.
+    TEST_ASSERT_EQUAL_UINT8(HTTP_PARSE_DONE, parser.state);
+    TEST_ASSERT_TRUE(parser.truncFlg);
+    checkBounds(&parser);
+}
+
+// *********************************************************************************************
+void test_fuzz_corpus(void)
+{
+    httpParser_t parser;
+    httpParser_t refParser;
+    char         msgBuff[80];
+    uint32_t     doneCnt  = 0;
+    uint32_t     truncCnt = 0;
+    size_t       usedLen;
+
+    for (uint32_t i = 0; i < FUZZ_CNT; i++) {
+        const char *seedStr = corpusTbl[testRandom() % (sizeof(corpusTbl) / sizeof(corpusTbl[0]))];
+        std::string reqStr(seedStr, (seedStr == binReqStr) ? sizeof(binReqStr) - 1 : strlen(seedStr));
+
+        for (uint8_t j = testRandom() % 8; j > 0; j--) { // Flip, insert, delete, or repeat.
+            size_t pos = testRandom() % (reqStr.length() + 1);
+
+            switch (testRandom() % 4) {
+                case 0:
+
+                    if (pos < reqStr.length()) {
+                        reqStr[pos] = (char)testRandom();
+                    }
+                    break;
+                case 1:
+                    reqStr.insert(pos, 1, "\r\n :?&=%+0"[testRandom() % 10]);
+                    break;
+                case 2:
+                    reqStr.erase(pos, 1 + testRandom() % 8);
+                    break;
+                default:
+                    reqStr.insert(pos, reqStr.substr(pos, testRandom() % HTTP_PARSE_BUFF_SZ));
+                    break;
+            }
+        }
+
+        usedLen = parseAll(&refParser, reqStr.data(), reqStr.length(), 0);
+        TEST_ASSERT_LESS_OR_EQUAL(reqStr.length(), usedLen);
+        checkBounds(&refParser);
+        TEST_ASSERT_EQUAL_UINT32(usedLen, parseAll(&parser, reqStr.data(), reqStr.length(), 1 + testRandom() % 64));
+        TEST_ASSERT_TRUE(sameResult(&parser, &refParser));
+
+        if (refParser.state == HTTP_PARSE_DONE) {
+            char *nextStr = refParser.query;
+            char *nameStr;
+            char *valueStr;
+
+            while (nextStr != NULL) { // Query split must stay in bounds too.
+                nextStr = httpNextParam(nextStr, &nameStr, &valueStr);
+            }
+            doneCnt++;
+        }
+        truncCnt += refParser.truncFlg ? 1 : 0;
+    }
+
+    snprintf(msgBuff, sizeof(msgBuff), "Fuzz: %u requests, %u complete, %u truncated.", FUZZ_CNT, doneCnt, truncCnt);
+    TEST_MESSAGE(msgBuff);
+}
+
+// *********************************************************************************************
+void test_parse_bench(void)
+{
+    httpParser_t  parser;
+    char         *argStr = NULL;
+    char         *cmdStr;
+    char          msgBuff[80];
+    size_t        reqLen = strlen(postReqStr);
+    unsigned long benchMicros;
+
+    benchMicros = micros();
+
+    for (uint32_t i = 0; i < BENCH_CNT; i++) {
+        httpParserInit(&parser);
+        httpParse(&parser, postReqStr, reqLen);
+        httpNextParam(parser.body, &cmdStr, &argStr);
+    }
+    benchMicros = micros() - benchMicros;
+
+    snprintf(msgBuff, sizeof(msgBuff), "Parse: %1.3f uS/Request (%u chars).", float(benchMicros) / float(BENCH_CNT), (unsigned)reqLen);
+    TEST_MESSAGE(msgBuff);
+    TEST_ASSERT_EQUAL_STRING("Now Playing: Test", argStr);
+}
+
+// *********************************************************************************************
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_url_decode);
+    RUN_TEST(test_post_request);
+    RUN_TEST(test_pipelined_requests);
+    RUN_TEST(test_odd_requests);
+    RUN_TEST(test_fuzz_corpus);
+    RUN_TEST(test_parse_bench);
+    return UNITY_END();
+}
+
+// *********************************************************************************************
+// EOF
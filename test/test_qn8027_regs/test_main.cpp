@@ -0,0 +1,146 @@
+/*
+   File: test_main.cpp (test_qn8027_regs)
+   Project: PixelRadio, an RBDS/RDS FM Transmitter (QN8027 Digital FM IC)
+   Version: 1.1.2
+   Creation: Oct-18-2022
+   Revised:  Oct-18-2022
+   Revision History: See PixelRadio.cpp
+   Project Leader: T. Black (thomastech)
+   Contributors: thomastech
+
+   (c) copyright T. Black 2021-2022, Licensed under GNU GPL 3.0 and later, under this
+   license absolutely no warranty is given.
+   This Code was formatted with the uncrustify extension.
+
+   Note 1: QN8027 register write tests. Run on the host: pio test -e native -f test_qn8027_regs
+   Note 2: The I2C transactions are counted twice, by the radio (i2cTxnCnt) and by the Wire stub
+           (txnCnt). Both counts must agree, and the stub's registers must hold what was written.
+ */
+
+// *********************************************************************************************
+
+#include <unity.h>
+#include <math.h>
+#include <string.h>
+#include "QN8027Radio.h"
+
+// *********************************************************************************************
+
+static const uint8_t testGrp[RDS_GROUP_SIZE] = { 0x64, 0x00, 0x20, 0x40, 'P', 'I', 'X', 'L' };
+
+static unsigned long simMillis = 1000;
+
+static unsigned long simMicros(void)
+{
+    return simMillis * 1000UL;
+}
+
+static uint32_t lastRadioCnt; // Transaction counts at the last txnCheck().
+static uint32_t lastWireCnt;
+
+// txnCheck(): Check that the radio and the Wire stub both saw txnCnt transactions since the last check.
+static void txnCheck(QN8027Radio *radio, uint32_t txnCnt)
+{
+    TEST_ASSERT_EQUAL_UINT32(txnCnt, radio->i2cTxnCnt - lastRadioCnt);
+    TEST_ASSERT_EQUAL_UINT32(txnCnt, Wire.txnCnt - lastWireCnt);
+    lastRadioCnt = radio->i2cTxnCnt;
+    lastWireCnt  = Wire.txnCnt;
+}
+
+// *********************************************************************************************
+void setUp(void)
+{
+    lastRadioCnt = 0; // Each test has a new radio.
+    lastWireCnt  = Wire.txnCnt;
+}
+
+void tearDown(void) {}
+
+// *********************************************************************************************
+// test_rds_group_txn(): One RDS Group costs one STATUS_REG read, then writeRDSGroup()'s RDSD0..7 burst and
+// the SYSTEM_REG update (rdsReady toggle).
+void test_rds_group_txn(void)
+{
+    static QN8027Radio radio;
+    uint8_t readyBit;
+
+    txnCheck(&radio, 0);
+    radio.sendRDS(testGrp[0], testGrp[1], testGrp[2], testGrp[3], testGrp[4], testGrp[5], testGrp[6], testGrp[7]);
+    txnCheck(&radio, 3);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(testGrp, &Wire.regs[RDSD0_REG], RDS_GROUP_SIZE);
+    readyBit = Wire.regs[SYSTEM_REG] & 0x04;
+
+    radio.sendRDS(testGrp[0], testGrp[1], testGrp[2], testGrp[3], testGrp[4], testGrp[5], testGrp[6], testGrp[7]);
+    txnCheck(&radio, 3);
+    TEST_ASSERT_EQUAL_HEX8(readyBit ^ 0x04, Wire.regs[SYSTEM_REG] & 0x04);
+
+    stubMicrosFn = simMicros; // serviceRDS() sends a queued group the same way.
+    TEST_ASSERT_TRUE(radio.queueRDS(testGrp));
+    radio.serviceRDS();
+    txnCheck(&radio, 3);
+    TEST_ASSERT_EQUAL_HEX8(readyBit, Wire.regs[SYSTEM_REG] & 0x04);
+    TEST_ASSERT_EQUAL_UINT32(1, radio.rdsSentCnt);
+    stubMicrosFn = nullptr;
+}
+
+// *********************************************************************************************
+// test_flush_txn(): flush() writes each run of adjacent dirty registers in one burst, and skips registers
+// that did not change.
+void test_flush_txn(void)
+{
+    static QN8027Radio radio;
+    uint8_t sysReg;
+    uint8_t ch1Reg;
+
+    txnCheck(&radio, 0);
+    radio.beginUpdate();
+    radio.setFrequency(88.1f);           // SYSTEM_REG and CH1_REG.
+    radio.setTxPilotFreqDeviation(10);   // GPLT_REG.
+    radio.setTxInputBufferGain(2);       // VGA_REG, XTL_REG is skipped.
+    radio.setTxPower(60);                // PAC_REG.
+    radio.setTxFreqDeviation(100);       // FDEV_REG.
+    radio.RDS(ON);                       // RDS_REG.
+    txnCheck(&radio, 0);                 // Deferred.
+
+    TEST_ASSERT_EQUAL_UINT8(3, radio.flush()); // 0x00-0x02, 0x04, 0x10-0x12.
+    txnCheck(&radio, 3);
+    sysReg = Wire.regs[SYSTEM_REG];
+    ch1Reg = Wire.regs[CH1_REG];
+    TEST_ASSERT_EQUAL_UINT16((8810 - 7600) / 5, ((sysReg & CH0_MASK) << 8) | ch1Reg);
+    TEST_ASSERT_EQUAL_HEX8(radio.preEmphTime | radio.privateMode | radio.PAAutoOffTime | 10, Wire.regs[GPLT_REG]);
+    TEST_ASSERT_EQUAL_HEX8(2 << 4, Wire.regs[VGA_REG] & 0x70);
+    TEST_ASSERT_EQUAL_HEX8(60, Wire.regs[PAC_REG]);
+    TEST_ASSERT_EQUAL_HEX8(100, Wire.regs[FDEV_REG]);
+    TEST_ASSERT_EQUAL_HEX8(128 | radio.RDSFreqDeviationKHz, Wire.regs[RDS_REG]);
+
+    radio.beginUpdate();                 // Same values, nothing to write.
+    radio.setFrequency(88.1f);
+    radio.setTxPower(60);
+    radio.RDS(ON);
+    TEST_ASSERT_EQUAL_UINT8(0, radio.flush());
+    txnCheck(&radio, 0);
+
+    radio.beginUpdate();                 // Two runs again, one of them a single register.
+    radio.setTxPower(50);
+    radio.setTxFreqDeviation(90);
+    radio.setTxPilotFreqDeviation(9);
+    TEST_ASSERT_EQUAL_UINT8(2, radio.flush());
+    txnCheck(&radio, 2);
+    TEST_ASSERT_EQUAL_HEX8(50, Wire.regs[PAC_REG]);
+    TEST_ASSERT_EQUAL_HEX8(90, Wire.regs[FDEV_REG]);
+
+    TEST_ASSERT_TRUE(fabsf(radio.getFrequency() - 88.1f) < 0.01f);
+    txnCheck(&radio, 0);                 // Read from the shadow.
+}
+
+// *********************************************************************************************
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_rds_group_txn);
+    RUN_TEST(test_flush_txn);
+    return UNITY_END();
+}
+
+// *********************************************************************************************
+// EOF
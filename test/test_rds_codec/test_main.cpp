@@ -0,0 +1,198 @@
+/*
+   File: test_main.cpp (test_rds_codec)
+   Project: PixelRadio, an RBDS/RDS FM Transmitter (QN8027 Digital FM IC)
+   Version: 1.1.2
+   Creation: Oct-18-2022
+   Revised:  Oct-18-2022
+   Revision History: See PixelRadio.cpp
+   Project Leader: T. Black (thomastech)
+   Contributors: thomastech
+
+   (c) copyright T. Black 2021-2022, Licensed under GNU GPL 3.0 and later, under this
+   license absolutely no warranty is given.
+   This Code was formatted with the uncrustify extension.
+
+   Note 1: RDS bitstream codec tests. Run on the host: pio test -e native -f test_rds_codec
+   Note 2: The golden bitstreams were computed independently of rdsCodec.cpp (polynomial long
+           division of x^10 * m(x) by g(x), then the IEC 62106 offset words).
+   Note 3: test_group_build_bench reports the time to build (QN8027Radio caches) and encode the
+           RDS Groups of one PSN + RadioText rotation. It fails only if the output is wrong.
+ */
+
+// *********************************************************************************************
+
+#include <unity.h>
+#include <string.h>
+#include "QN8027Radio.h"
+#include "rdsCodec.h"
+
+// *********************************************************************************************
+
+const uint32_t BENCH_CNT = 20000; // Rotations built and encoded by the benchmark.
+
+// 2A Group, PI 0x6400, segment 0 "Pixe".
+static const uint8_t gold2aGrp[RDS_GROUP_BYTES]      = { 0x64, 0x00, 0x25, 0x30, 'P', 'i', 'x', 'e' };
+static const uint8_t gold2aBits[RDS_BITSTREAM_BYTES] = {
+    0x64, 0x00, 0xB1, 0x09, 0x4C, 0x0E, 0x35, 0x06, 0x93, 0x39, 0xE1, 0x94, 0xBA
+};
+
+// 0A Group, PI 0x6400, PSN segment 0 "Pi", AF 0xE0CD.
+static const uint8_t gold0aGrp[RDS_GROUP_BYTES]      = { 0x64, 0x00, 0x05, 0x28, 0xE0, 0xCD, 'P', 'i' };
+static const uint8_t gold0aBits[RDS_BITSTREAM_BYTES] = {
+    0x64, 0x00, 0xB1, 0x01, 0x4A, 0x3F, 0x0E, 0x0C, 0xD7, 0xA5, 0x41, 0xA4, 0x12
+};
+
+// 2B Group (version B, block 3 uses offset C'), PI repeated in block 3.
+static const uint8_t gold2bGrp[RDS_GROUP_BYTES]      = { 0x64, 0x00, 0x2D, 0x31, 0x64, 0x00, 'x', 'e' };
+static const uint8_t gold2bBits[RDS_BITSTREAM_BYTES] = {
+    0x64, 0x00, 0xB1, 0x0B, 0x4C, 0x60, 0x36, 0x40, 0x05, 0xA1, 0xE1, 0x94, 0xBA
+};
+
+// *********************************************************************************************
+void setUp(void)    {}
+void tearDown(void) {}
+
+// *********************************************************************************************
+static void checkGolden(const uint8_t *grp, const uint8_t *goldBits)
+{
+    uint8_t bits[RDS_BITSTREAM_BYTES];
+    uint8_t decGrp[RDS_GROUP_BYTES];
+
+    rdsEncodeGroup(grp, bits);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(goldBits, bits, RDS_BITSTREAM_BYTES);
+    TEST_ASSERT_EQUAL_HEX8(0, rdsDecodeGroup(goldBits, decGrp));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(grp, decGrp, RDS_GROUP_BYTES);
+}
+
+// *********************************************************************************************
+void test_golden_2a(void)
+{
+    checkGolden(gold2aGrp, gold2aBits);
+}
+
+void test_golden_0a(void)
+{
+    checkGolden(gold0aGrp, gold0aBits);
+}
+
+void test_golden_2b_offset_cp(void)
+{
+    checkGolden(gold2bGrp, gold2bBits);
+}
+
+// *********************************************************************************************
+void test_checkword_vectors(void)
+{
+    TEST_ASSERT_EQUAL_HEX16(0x000, rdsCheckword(0x0000));
+    TEST_ASSERT_EQUAL_HEX16(0x1B9, rdsCheckword(0x0001));
+    TEST_ASSERT_EQUAL_HEX16(0x077, rdsCheckword(0x8000));
+    TEST_ASSERT_EQUAL_HEX16(0x238, rdsCheckword(0x6400));
+    TEST_ASSERT_EQUAL_HEX16(0x0CD, rdsCheckword(0xFFFF));
+}
+
+// Every information word: the table driven checkword matches the bit-wise reference.
+void test_checkword_table_exhaustive(void)
+{
+    uint32_t failCnt = 0;
+
+    for (uint32_t info = 0; info <= 0xFFFF; info++) {
+        failCnt += (rdsCheckword(info) != rdsCheckwordRef(info)) ? 1 : 0;
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, failCnt);
+}
+
+// Every information word and offset gives that offset's syndrome (encoder vs parity matrix).
+void test_syndromes_exhaustive(void)
+{
+    static const uint16_t offsets[5]   = { RDS_OFFSET_A, RDS_OFFSET_B, RDS_OFFSET_C, RDS_OFFSET_CP, RDS_OFFSET_D };
+    static const uint16_t syndromes[5] = { RDS_SYNDROME_A, RDS_SYNDROME_B, RDS_SYNDROME_C, RDS_SYNDROME_CP, RDS_SYNDROME_D };
+    uint32_t failCnt = 0;
+
+    for (uint32_t info = 0; info <= 0xFFFF; info++) {
+        for (uint8_t i = 0; i < 5; i++) {
+            failCnt += (rdsSyndrome(rdsEncodeBlock(info, offsets[i])) != syndromes[i]) ? 1 : 0;
+        }
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, failCnt);
+}
+
+// Any single bit error, in any block, is detected and reported in the right block.
+// The B0 (version) bit in block B also selects the block C offset, so it fails block C too.
+void test_single_bit_errors(void)
+{
+    const uint8_t b0BitPos = RDS_BLOCK_BITS + 4;
+    uint8_t bits[RDS_BITSTREAM_BYTES];
+    uint8_t grp[RDS_GROUP_BYTES];
+    uint8_t errMask;
+
+    for (uint8_t bitPos = 0; bitPos < RDS_GROUP_BLOCKS * RDS_BLOCK_BITS; bitPos++) {
+        memcpy(bits, gold2aBits, sizeof(bits));
+        bits[bitPos >> 3] ^= 0x80 >> (bitPos & 0x07);
+        errMask = (1 << (bitPos / RDS_BLOCK_BITS)) | ((bitPos == b0BitPos) ? 0x04 : 0);
+        TEST_ASSERT_EQUAL_HEX8(errMask, rdsDecodeGroup(bits, grp));
+    }
+}
+
+// *********************************************************************************************
+// Group building path: the Scheduler's PSN / RadioText caches as sent to the QN8027, then
+// encoded as they go on-air. Each new RadioText rebuilds the caches.
+void test_group_build_bench(void)
+{
+    static const char *textStrs[2] = {
+        "PixelRadio Benchmark, the quick brown fox jumps over a lazy dog.",
+        "PixelRadio Benchmark, the QUICK brown fox jumps over a lazy cat."
+    };
+    QN8027Radio   radio;
+    uint8_t       bits[RDS_BITSTREAM_BYTES];
+    uint8_t       grp[RDS_GROUP_BYTES];
+    uint32_t      groupCnt = 0;
+    uint32_t      errCnt   = 0;
+    unsigned long benchMicros;
+    char logBuff[120];
+
+    radio.setPiCode(RDS_PI_CODE_DEF);
+    radio.setPtyCode(RDS_PTY_CODE_DEF);
+    benchMicros = micros();
+
+    for (uint32_t i = 0; i < BENCH_CNT; i++) {
+        radio.setStationName((i & 0x01) ? "PIXELRAD" : "RDSBENCH");
+        radio.setRadioText(textStrs[i & 0x01]);
+
+        for (uint8_t j = 0; j < radio.getPsnGroupCnt(); j++) {
+            rdsEncodeGroup(radio.getPsnGroup(j), bits);
+            errCnt += rdsDecodeGroup(bits, grp) ? 1 : 0;
+            groupCnt++;
+        }
+
+        for (uint8_t j = 0; j < radio.getRtGroupCnt(); j++) {
+            rdsEncodeGroup(radio.getNextRtGroup(), bits);
+            errCnt += rdsDecodeGroup(bits, grp) ? 1 : 0;
+            groupCnt++;
+        }
+    }
+    benchMicros = micros() - benchMicros;
+
+    snprintf(logBuff, sizeof(logBuff), "Group build + encode + decode: %u Groups, %1.3f uS/Group.",
+             (unsigned)groupCnt, float(benchMicros) / float(groupCnt));
+    TEST_MESSAGE(logBuff);
+    TEST_ASSERT_EQUAL_UINT32(BENCH_CNT * (PSN_GROUP_CNT + RT_GROUP_CNT), groupCnt);
+    TEST_ASSERT_EQUAL_UINT32(0, errCnt);
+}
+
+// *********************************************************************************************
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_golden_2a);
+    RUN_TEST(test_golden_0a);
+    RUN_TEST(test_golden_2b_offset_cp);
+    RUN_TEST(test_checkword_vectors);
+    RUN_TEST(test_checkword_table_exhaustive);
+    RUN_TEST(test_syndromes_exhaustive);
+    RUN_TEST(test_single_bit_errors);
+    RUN_TEST(test_group_build_bench);
+    return UNITY_END();
+}
+
+// *********************************************************************************************
+// EOF
@@ -0,0 +1,571 @@
+/*
+   File: test_main.cpp (test_rds_sched)
+   Project: PixelRadio, an RBDS/RDS FM Transmitter (QN8027 Digital FM IC)
+   Version: 1.1.2
+   Creation: Oct-18-2022
+   Revised:  Oct-18-2022
+   Revision History: See PixelRadio.cpp
+   Project Leader: T. Black (thomastech)
+   Contributors: thomastech
+
+   (c) copyright T. Black 2021-2022, Licensed under GNU GPL 3.0 and later, under this
+   license absolutely no warranty is given.
+   This Code was formatted with the uncrustify extension.
+
+   Note 1: Accelerated simulation of the RDS Task. Run on the host: pio test -e native -f test_rds_sched
+           processRDS() is called every RDS_TASK_TIME of simulated time. getClockMillis() (the virtual
+           clock) and the QN8027 driver's millis() both read the simulated clock.
+   Note 2: The QN8027 is modeled on the I2C bus stub: a written group is taken at the next group
+           slot (104 bits at 1187.5 bps), then STATUS_REG bit 3 toggles. A slot with no new group
+           is an idle (starved) slot.
+   Note 3: Traffic: Local Controller rotation (three messages) plus random Serial, UDP, MQTT, and HTTP
+           RadioText jobs, with update bursts and stops, for SIM_DAYS days.
+   Note 4: Every RadioText starts with a 4 char tag (Controller letter + job number). A new text
+           toggles the A/B flag and its changed segments go first, so the first 2A group after a
+           toggle names the text. Slot accuracy compares a message's time on-air with its
+           RadioText display time.
+ */
+
+// *********************************************************************************************
+
+#include <unity.h>
+#include <vector>
+#include "../../src/rds.cpp" // Not in [env:native]'s source filter, it needs the globals below.
+
+// *********************************************************************************************
+
+const unsigned long SIM_DAYS       = 3;
+const unsigned long SIM_SEED       = 20221018;
+const unsigned long TASK_MICROS    = RDS_TASK_TIME * 1000UL;
+const unsigned long LOOP_MICROS    = 10000;       // loop() pass time.
+const double        GROUP_MICROS   = 1000000.0 * 104.0 / 1187.5;
+const unsigned long TAIL_MICROS    = 900000000UL; // Jobs posted this close to the end are not judged.
+const unsigned long SLOT_ERR_MAX   = 250;         // Slot accuracy limit, in mS.
+const unsigned long LOCAL_MSG_TIME = 15000;
+
+// *********************************************************************************************
+// Globals used by rds.cpp (normally in PixelRadio.cpp).
+QN8027Radio   radio;
+bool          activeTextHttpFlg   = false;
+bool          activeTextLocalFlg  = false;
+bool          activeTextMqttFlg   = false;
+bool          activeTextSerialFlg = false;
+bool          activeTextUdpFlg    = false;
+bool          ctrlHttpFlg         = true;
+bool          ctrlLocalFlg        = true;
+bool          ctrlMqttFlg         = true;
+bool          ctrlUdpFlg          = true;
+bool          rdsText1EnbFlg      = true;
+bool          rdsText2EnbFlg      = true;
+bool          rdsText3EnbFlg      = true;
+bool          rfCarrierFlg        = true;
+bool          testModeFlg         = false;
+float         rdsGroupRate        = 0.0f;
+uint8_t       rdsHttpPtyCode      = RDS_PTY_CODE_DEF;
+uint8_t       rdsLocalPtyCode     = RDS_PTY_CODE_DEF;
+uint8_t       rdsMqttPtyCode      = RDS_PTY_CODE_DEF;
+uint8_t       rdsSerialPtyCode    = RDS_PTY_CODE_DEF;
+uint8_t       rdsUdpPtyCode       = RDS_PTY_CODE_DEF;
+uint16_t      rdsHttpPiCode       = RDS_PI_CODE_DEF;
+uint16_t      rdsLocalPiCode      = RDS_PI_CODE_DEF;
+uint16_t      rdsMqttPiCode       = RDS_PI_CODE_DEF;
+uint16_t      rdsSerialPiCode     = RDS_PI_CODE_DEF;
+uint16_t      rdsUdpPiCode        = RDS_PI_CODE_DEF;
+unsigned long rdsHttpMsgTime      = RDS_DSP_TM_DEF;
+unsigned long rdsLocalMsgTime     = LOCAL_MSG_TIME;
+unsigned long rdsMqttMsgTime      = RDS_DSP_TM_DEF;
+unsigned long rdsMsgTime          = RDS_DSP_TM_DEF;
+unsigned long rdsSerialMsgTime    = RDS_DSP_TM_DEF;
+unsigned long rdsUdpMsgTime       = RDS_DSP_TM_DEF;
+String        rdsHttpPsnStr       = "PIXEL-H";
+String        rdsLocalPsnStr      = "PIXEL-L";
+String        rdsMqttPsnStr       = "PIXEL-M";
+String        rdsSerialPsnStr     = "PIXEL-S";
+String        rdsUdpPsnStr        = "PIXEL-U";
+String        rdsHttpTextStr      = "";
+String        rdsMqttTextStr      = "";
+String        rdsSerialTextStr    = "";
+String        rdsUdpTextStr       = "";
+String        rdsTextMsgStr       = "";
+String        rdsTextMsg1Str      = "L001 Local RadioText Message One";
+String        rdsTextMsg2Str      = "L002 Local RadioText Message Two, a bit longer than the first";
+String        rdsTextMsg3Str      = "L003 Three";
+
+// *********************************************************************************************
+// Simulated clock, and the functions rds.cpp calls in other modules.
+static unsigned long simMicros = 1000000;
+static bool          rdsTaskFlg = false; // processRDS() is running (RDS Task context).
+static uint32_t      uiCallCnt  = 0;     // Web UI calls made from loop().
+static uint32_t      uiTaskCnt  = 0;     // Web UI calls made from the RDS Task, must be zero.
+
+static unsigned long simClockMicros(void)
+{
+    return simMicros;
+}
+
+unsigned long getClockMillis(void)
+{
+    return simMicros / 1000;
+}
+
+static void uiCall(void)
+{
+    uiCallCnt++;
+    uiTaskCnt += rdsTaskFlg ? 1 : 0;
+}
+
+bool     ctrlSerialFlg(void)                     {
+    return true;
+}
+
+uint32_t getCmdTraceId(void)                     {
+    return 0;
+}
+
+void     stampCmdTrace(uint32_t, uint8_t)        {}
+void     radioLock(void)                         {}
+void     radioUnlock(void)                       {}
+void     displayActiveController(uint8_t)        {
+    uiCall();
+}
+
+void     displayRdsText(void)                    {
+    uiCall();
+}
+
+void     updateUiRdsGroupRate(void)              {
+    uiCall();
+}
+
+void     updateUiRdsText(String)                 {
+    uiCall();
+}
+
+void     updateUiRDSTmr(unsigned long)           {
+    uiCall();
+}
+
+// *********************************************************************************************
+// Simulation state.
+static uint32_t rng = SIM_SEED;
+
+static uint32_t simRandom(void) // xorshift32.
+{
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return rng;
+}
+
+static double simExpRandom(double mean)
+{
+    return -mean * log((simRandom() % 1000000 + 1) / 1000001.0);
+}
+
+typedef struct {
+    uint8_t       cntrlIdx;         // Index into simCntrls[], RDS_LOCAL_MSG_CNT + 4 for Local messages.
+    unsigned long msgTime;          // Display time, in mS.
+    unsigned long postMicros;
+    unsigned long firstAirMicros;   // Zero = never on-air.
+    unsigned long airMicros;        // Total time on-air (all runs).
+    bool          supersededFlg;    // Replaced by a newer job from the same Controller.
+    bool          stoppedFlg;
+} simJob_t;
+
+typedef struct {
+    uint8_t        id;
+    char           letter;
+    double         meanSecs;        // Mean time between traffic events.
+    String        *textStr;
+    unsigned long *msgTime;
+    uint16_t      *piCode;
+    unsigned long  nextMicros;
+    int32_t        lastJob;         // Latest job, -1 if none.
+    uint32_t       postCnt;
+    uint32_t       stopCnt;
+} simCntrl_t;
+
+static simCntrl_t simCntrls[] = { // Priority order, as in rds.cpp.
+    { SERIAL_CNTRL, 'S', 900.0, &rdsSerialTextStr, &rdsSerialMsgTime, &rdsSerialPiCode, 0, -1, 0, 0 },
+    { UDP_CNTRL,    'U', 240.0, &rdsUdpTextStr,    &rdsUdpMsgTime,    &rdsUdpPiCode,    0, -1, 0, 0 },
+    { MQTT_CNTRL,   'M', 60.0,  &rdsMqttTextStr,   &rdsMqttMsgTime,   &rdsMqttPiCode,   0, -1, 0, 0 },
+    { HTTP_CNTRL,   'H', 120.0, &rdsHttpTextStr,   &rdsHttpMsgTime,   &rdsHttpPiCode,   0, -1, 0, 0 },
+};
+static const uint8_t SIM_CNTRL_CNT = sizeof(simCntrls) / sizeof(simCntrls[0]);
+static const uint8_t SIM_LOCAL_IDX = SIM_CNTRL_CNT;
+
+static std::vector<simJob_t> simJobs;  // Remote jobs; job number = index + 1.
+
+// QN8027 model.
+static uint8_t       chipReady     = 0;     // Last SYSTEM_REG RDS ready bit written.
+static bool          chipPendFlg   = false; // A written group waits for the next slot.
+static uint8_t       chipGrp[RDS_GROUP_SIZE];
+static uint64_t      chipSlot      = 0;
+static unsigned long chipSlotMicros;        // Start time of the next slot.
+static unsigned long chipBaseMicros;
+static bool          chipRunFlg    = false; // First group has been taken.
+static uint32_t      chipIdleCnt   = 0;
+static uint32_t      chipOverrunCnt = 0;    // Groups written before the previous one was taken.
+static uint32_t      chipAirCnt    = 0;
+
+// On-air RadioText runs.
+static bool          runFlg        = false;
+static uint8_t       runAbFlg      = 0;
+static unsigned long runMicros     = 0;
+static int32_t       runJob        = 0;      // > 0 remote job number, < 0 local message, 0 unknown.
+static int32_t       endedJob      = 0;      // Run waiting for the next run's owner, see closeRun().
+static unsigned long endedMicros   = 0;
+static uint32_t      runCnt        = 0;
+static uint32_t      runUnknownCnt = 0;
+
+// Results.
+static uint32_t      slotCnt        = 0;
+static double        slotErrSum     = 0.0;
+static unsigned long slotErrMax     = 0;
+static unsigned long localGapMax    = 0;
+static unsigned long localEndMicros = 0;
+
+// *********************************************************************************************
+// Job tag: Controller letter + 3 char base 62 job number, the first RadioText segment.
+static void makeTag(char *tagStr, char letter, uint32_t jobNum)
+{
+    static const char digits[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz";
+
+    tagStr[0] = letter;
+    tagStr[1] = digits[(jobNum / 3844) % 62];
+    tagStr[2] = digits[(jobNum / 62) % 62];
+    tagStr[3] = digits[jobNum % 62];
+    tagStr[4] = 0;
+}
+
+static int32_t parseTag(const uint8_t *seg)
+{
+    uint32_t jobNum = 0;
+
+    if (seg[0] == 'L') {
+        return -(seg[3] - '0');
+    }
+
+    for (uint8_t i = 1; i < 4; i++) {
+        const char *pos = strchr("0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz", seg[i]);
+
+        if ((pos == NULL) || (seg[i] == 0)) {
+            return 0;
+        }
+        jobNum = jobNum * 62 + (pos - "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz");
+    }
+    return (jobNum && jobNum <= simJobs.size()) ? (int32_t)jobNum : 0;
+}
+
+// Priority of a run's owner, 0 = highest. Local is lowest.
+static uint8_t runPriority(int32_t job)
+{
+    return (job > 0) ? simJobs[job - 1].cntrlIdx : SIM_LOCAL_IDX;
+}
+
+// *********************************************************************************************
+// closeRun(): The previous run's owner is judged when the next run's owner is known. A run that
+// hands over to a lower priority owner has used up its display time.
+static void closeRun(int32_t nextJob)
+{
+    unsigned long airMicros = runMicros - endedMicros; // runMicros = start of the next run.
+    unsigned long expectMicros;
+    unsigned long errMillis;
+    bool          expiredFlg;
+
+    if (endedJob == 0) {
+        return;
+    }
+    expiredFlg = (nextJob == 0) || (runPriority(nextJob) > runPriority(endedJob)) ||
+                 ((endedJob < 0) && (nextJob < 0));
+
+    if (endedJob < 0) {
+        localEndMicros = runMicros;
+
+        if (!expiredFlg) {
+            return;
+        }
+        expectMicros = LOCAL_MSG_TIME * 1000UL;
+    }
+    else {
+        simJob_t *job = &simJobs[endedJob - 1];
+
+        job->airMicros += airMicros;
+        airMicros       = job->airMicros;
+
+        if (!expiredFlg || job->stoppedFlg || job->supersededFlg) {
+            return;
+        }
+        expectMicros = job->msgTime * 1000UL;
+    }
+    errMillis = (airMicros > expectMicros ? airMicros - expectMicros : expectMicros - airMicros) / 1000;
+    slotErrSum += errMillis;
+    slotErrMax  = errMillis > slotErrMax ? errMillis : slotErrMax;
+    slotCnt++;
+}
+
+// airGroup(): A group went on-air at slotMicros.
+static void airGroup(const uint8_t *grp, unsigned long slotMicros)
+{
+    uint8_t abFlg = grp[3] & 0x10;
+    int32_t job;
+
+    chipAirCnt++;
+
+    if ((grp[2] & 0xF8) != 0x20) { // Not a 2A (RadioText) group.
+        return;
+    }
+
+    if (!runFlg || (abFlg != runAbFlg)) { // New RadioText, its first group is segment 0 (the tag).
+        job = ((grp[3] & 0x0F) == 0) ? parseTag(&grp[4]) : 0;
+
+        if (runFlg) {
+            endedJob    = runJob;
+            endedMicros = runMicros;
+            runMicros   = slotMicros;
+            closeRun(job);
+        }
+        else if (job < 0) {
+            localEndMicros = slotMicros;
+        }
+        runFlg    = true;
+        runAbFlg  = abFlg;
+        runMicros = slotMicros;
+        runJob    = job;
+        runCnt++;
+        runUnknownCnt += (job == 0) ? 1 : 0;
+
+        if (job < 0) {
+            unsigned long gapMicros = slotMicros - localEndMicros;
+
+            localGapMax = gapMicros > localGapMax ? gapMicros : localGapMax;
+        }
+        else if ((job > 0) && (simJobs[job - 1].firstAirMicros == 0)) {
+            simJobs[job - 1].firstAirMicros = slotMicros;
+        }
+    }
+}
+
+// *********************************************************************************************
+// chipAdvance(): Run the modeled QN8027 up to the simulated time.
+static void chipAdvance(void)
+{
+    while (simMicros >= chipSlotMicros) {
+        if (chipPendFlg) {
+            chipPendFlg             = false;
+            chipRunFlg              = true;
+            Wire.regs[STATUS_REG] ^= 0x08; // Group taken, the driver may write the next one.
+            airGroup(chipGrp, chipSlotMicros);
+        }
+        else if (chipRunFlg) {
+            chipIdleCnt++;
+        }
+        chipSlot++;
+        chipSlotMicros = chipBaseMicros + (unsigned long)(chipSlot * GROUP_MICROS);
+    }
+}
+
+static void chipWrite(uint8_t reg, uint8_t data)
+{
+    if ((reg == SYSTEM_REG) && ((data & 0x04) != chipReady)) { // RDS ready toggled, group written.
+        chipReady = data & 0x04;
+        chipAdvance();
+        chipOverrunCnt += chipPendFlg ? 1 : 0;
+        chipPendFlg     = true;
+        memcpy(chipGrp, &Wire.regs[RDSD0_REG], RDS_GROUP_SIZE);
+    }
+}
+
+static void chipRead(uint8_t reg)
+{
+    if (reg == STATUS_REG) {
+        chipAdvance();
+    }
+}
+
+// *********************************************************************************************
+// runTraffic(): Post the remote Controller jobs that are due.
+static void postJob(simCntrl_t *cntrl)
+{
+    static const unsigned long msgTimes[] = { 5000, 10000, 15000, 30000, 60000, 120000 };
+    char     textBuff[RDS_TEXT_MAX_SZ * 2]; // Long texts are truncated by postRdsJob().
+    char     tagStr[5];
+    simJob_t job;
+
+    if (cntrl->lastJob > 0) {
+        simJobs[cntrl->lastJob - 1].supersededFlg = true;
+    }
+    memset(&job, 0, sizeof(job));
+    job.cntrlIdx   = cntrl - simCntrls;
+    job.msgTime    = msgTimes[simRandom() % (sizeof(msgTimes) / sizeof(msgTimes[0]))];
+    job.postMicros = simMicros;
+    simJobs.push_back(job);
+    cntrl->lastJob = simJobs.size();
+    cntrl->postCnt++;
+
+    makeTag(tagStr, cntrl->letter, simJobs.size());
+    snprintf(textBuff, sizeof(textBuff), "%s %s RadioText, display %lu secs.%.*s", tagStr,
+             getControllerName(cntrl->id).c_str(), job.msgTime / 1000, (int)(simRandom() % 24), "........................");
+    *cntrl->textStr = textBuff;
+    *cntrl->msgTime = job.msgTime;
+    *cntrl->piCode  = 0x6400 + job.cntrlIdx;
+    postRdsJob(cntrl->id, RDS_JOB_START);
+}
+
+static void runTraffic(void)
+{
+    static unsigned long burstMicros[SIM_CNTRL_CNT] = { 0 };
+    static uint8_t       burstCnt[SIM_CNTRL_CNT]    = { 0 };
+    uint32_t             pick;
+
+    for (uint8_t i = 0; i < SIM_CNTRL_CNT; i++) {
+        simCntrl_t *cntrl = &simCntrls[i];
+
+        if (burstCnt[i] && (simMicros >= burstMicros[i])) { // Fast updates, coalesced by the RDS Task.
+            burstCnt[i]--;
+            burstMicros[i] = simMicros + 250000;
+            postJob(cntrl);
+        }
+
+        if (simMicros < cntrl->nextMicros) {
+            continue;
+        }
+        cntrl->nextMicros = simMicros + (unsigned long)(simExpRandom(cntrl->meanSecs) * 1000000.0);
+        pick              = simRandom() % 100;
+
+        if (pick < 5) {
+            if (cntrl->lastJob > 0) {
+                simJobs[cntrl->lastJob - 1].stoppedFlg = true;
+            }
+            cntrl->stopCnt++;
+            postRdsJob(cntrl->id, RDS_JOB_STOP);
+        }
+        else {
+            postJob(cntrl);
+
+            if (pick < 15) {
+                burstCnt[i]    = 3;
+                burstMicros[i] = simMicros + 250000;
+            }
+        }
+    }
+}
+
+// *********************************************************************************************
+String getControllerName(uint8_t controller)
+{
+    return (controller == SERIAL_CNTRL) ? "Serial" : (controller == UDP_CNTRL) ? "UDP" :
+           (controller == MQTT_CNTRL) ? "MQTT" : (controller == HTTP_CNTRL) ? "HTTP" : "Local";
+}
+
+void setUp(void)    {}
+void tearDown(void) {}
+
+// *********************************************************************************************
+void test_rds_sched_multi_day(void)
+{
+    const unsigned long endMicros = simMicros + SIM_DAYS * 86400UL * 1000000UL;
+    unsigned long loopMicros      = simMicros;
+    unsigned long hostMicros;
+    uint32_t      taskCnt = 0;
+    uint32_t      starveCnt[SIM_CNTRL_CNT]   = { 0 };
+    uint32_t      airedCnt[SIM_CNTRL_CNT]    = { 0 };
+    uint32_t      coalesceCnt[SIM_CNTRL_CNT] = { 0 };
+    unsigned long latencyMax[SIM_CNTRL_CNT]  = { 0 };
+    double        latencySum[SIM_CNTRL_CNT]  = { 0 };
+    uint32_t      starveTotal = 0;
+    double        hours       = SIM_DAYS * 24.0;
+    char          logBuff[200];
+
+    hostMicros     = micros();
+    stubMicrosFn   = simClockMicros;
+    Wire.writeHook = chipWrite;
+    Wire.readHook  = chipRead;
+    chipBaseMicros = simMicros;
+    chipSlotMicros = simMicros;
+
+    for (uint8_t i = 0; i < SIM_CNTRL_CNT; i++) {
+        simCntrls[i].nextMicros = simMicros + (unsigned long)(simExpRandom(simCntrls[i].meanSecs) * 1000000.0);
+    }
+    resetControllerRdsValues();
+    initRdsTask();
+
+    for (; simMicros < endMicros; simMicros += TASK_MICROS) {
+        runTraffic();
+
+        if (simMicros - loopMicros >= LOOP_MICROS) { // loop()
+            loopMicros = simMicros;
+            postRdsLocalJob();
+            processRdsUi();
+        }
+
+        rdsTaskFlg = true; // rdsTask()
+        radioLock();
+        processRDS();
+        radioUnlock();
+        rdsTaskFlg = false;
+        chipAdvance();
+        taskCnt++;
+    }
+    stubMicrosFn = nullptr;
+    hostMicros   = micros() - hostMicros;
+
+    for (size_t i = 0; i < simJobs.size(); i++) {
+        simJob_t *job = &simJobs[i];
+
+        if (job->firstAirMicros) {
+            unsigned long latency = job->firstAirMicros - job->postMicros;
+
+            airedCnt[job->cntrlIdx]++;
+            latencySum[job->cntrlIdx] += latency / 1000.0;
+            latencyMax[job->cntrlIdx]  = latency > latencyMax[job->cntrlIdx] ? latency : latencyMax[job->cntrlIdx];
+        }
+        else if (job->supersededFlg) {
+            coalesceCnt[job->cntrlIdx]++;
+        }
+        else if (!job->stoppedFlg && (endMicros - job->postMicros > TAIL_MICROS)) {
+            starveCnt[job->cntrlIdx]++;
+            starveTotal++;
+        }
+    }
+
+    snprintf(logBuff, sizeof(logBuff), "Simulated %lu days in %1.1f secs: %u RDS Task passes, %u RadioText runs (%u untagged).",
+             SIM_DAYS, hostMicros / 1000000.0, taskCnt, runCnt, runUnknownCnt);
+    TEST_MESSAGE(logBuff);
+    snprintf(logBuff, sizeof(logBuff), "Slot accuracy: %u expired messages, error mean %1.1f mS, max %lu mS. Longest Local gap %1.1f secs.",
+             slotCnt, slotCnt ? slotErrSum / slotCnt : 0.0, slotErrMax, localGapMax / 1000000.0);
+    TEST_MESSAGE(logBuff);
+    snprintf(logBuff, sizeof(logBuff), "Starvation: %u idle group slots of %llu, %u overruns, %u starved jobs. Groups on-air %u (%1.2f/sec).",
+             chipIdleCnt, (unsigned long long)chipSlot, chipOverrunCnt, starveTotal, chipAirCnt, chipAirCnt / (hours * 3600.0));
+    TEST_MESSAGE(logBuff);
+
+    for (uint8_t i = 0; i < SIM_CNTRL_CNT; i++) {
+        snprintf(logBuff, sizeof(logBuff), "  %-6s jobs %5u, on-air %5u, coalesced %4u, stops %3u, starved %u, latency mean %1.2f secs, max %1.2f secs.",
+                 getControllerName(simCntrls[i].id).c_str(), simCntrls[i].postCnt, airedCnt[i], coalesceCnt[i], simCntrls[i].stopCnt,
+                 starveCnt[i], airedCnt[i] ? latencySum[i] / airedCnt[i] / 1000.0 : 0.0, latencyMax[i] / 1000000.0);
+        TEST_MESSAGE(logBuff);
+    }
+    snprintf(logBuff, sizeof(logBuff), "Radio calls: %u I2C transactions (%1.0f/hour, %1.2f/group), %u groups written. RDS Job coalesced %u. Web UI calls %u.",
+             Wire.txnCnt, Wire.txnCnt / hours, float(Wire.txnCnt) / radio.rdsSentCnt, radio.rdsSentCnt, getRdsCoalesceCnt(), uiCallCnt);
+    TEST_MESSAGE(logBuff);
+
+    TEST_ASSERT_EQUAL_UINT32(0, uiTaskCnt);  // The RDS Task never calls the Web UI.
+    TEST_ASSERT_EQUAL_UINT32(0, chipIdleCnt);
+    TEST_ASSERT_EQUAL_UINT32(0, chipOverrunCnt);
+    TEST_ASSERT_EQUAL_UINT32(0, starveTotal);
+    TEST_ASSERT_EQUAL_UINT32(0, runUnknownCnt);
+    TEST_ASSERT_GREATER_THAN(0, slotCnt);
+    TEST_ASSERT_LESS_OR_EQUAL(SLOT_ERR_MAX, slotErrMax);
+    TEST_ASSERT_EQUAL_UINT32(0, Log.errorCnt);
+}
+
+// *********************************************************************************************
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_rds_sched_multi_day);
+    return UNITY_END();
+}
+
+// *********************************************************************************************
+// EOF
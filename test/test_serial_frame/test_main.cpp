@@ -0,0 +1,262 @@
+/*
+   File: test_main.cpp (test_serial_frame)
+   Project: PixelRadio, an RBDS/RDS FM Transmitter (QN8027 Digital FM IC)
+   Version: 1.1.2
+   Creation: Oct-18-2022
+   Revised:  Oct-18-2022
+   Revision History: See PixelRadio.cpp
+   Project Leader: T. Black (thomastech)
+   Contributors: thomastech
+
+   (c) copyright T. Black 2021-2022, Licensed under GNU GPL 3.0 and later, under this
+   license absolutely no warranty is given.
+   This Code was formatted with the uncrustify extension.
+
+   Note 1: Serial Controller Binary Mode frame tests. Run on the host: pio test -e native -f test_serial_frame
+   Note 2: test_frame_stream sends frames with line noise between them, split at the zero delimiters
+           the way the Serial Controller does. Every frame must be found, and no noise accepted.
+   Note 3: test_frame_bench reports the frame build + parse time. It fails only if the output is wrong.
+ */
+
+// *********************************************************************************************
+
+#include <unity.h>
+#include <Arduino.h>
+#include <string.h>
+#include <vector>
+#include "serialFrame.h"
+
+// *********************************************************************************************
+
+const uint32_t BENCH_CNT = 100000; // Frames built and parsed by the benchmark.
+const uint32_t ROUND_CNT = 20000;  // Random frames in the round trip and stream tests.
+
+static const char benchStr[] = "rtm=Now Playing: Carol of the Bells, Trans-Siberian Orchestra";
+
+// *********************************************************************************************
+static uint32_t rng = 20221018;
+
+static uint32_t testRandom(void) // xorshift32.
+{
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return rng;
+}
+
+// randomPayload(): Random payload, often with zeros and long runs without them.
+static size_t randomPayload(uint8_t *payload)
+{
+    size_t  len  = testRandom() % (SFRAME_PAYLOAD_MAX + 1);
+    uint8_t zero = testRandom() % 4; // 0 = no zeros.
+
+    for (size_t i = 0; i < len; i++) {
+        payload[i] = (zero && (testRandom() % (zero * 8) == 0)) ? 0 : 1 + testRandom() % 255;
+    }
+    return len;
+}
+
+// *********************************************************************************************
+void setUp(void)    {}
+void tearDown(void) {}
+
+// *********************************************************************************************
+void test_crc16(void)
+{
+    TEST_ASSERT_EQUAL_HEX16(0x29B1, crc16Ccitt((const uint8_t *)"123456789", 9)); // CCITT-FALSE check value.
+    TEST_ASSERT_EQUAL_HEX16(SFRAME_CRC_INIT, crc16Ccitt(NULL, 0));
+    TEST_ASSERT_EQUAL_HEX16(0xE1F0, crc16Ccitt((const uint8_t *)"\x00", 1));
+}
+
+// *********************************************************************************************
+void test_cobs_vectors(void)
+{
+    static const uint8_t zeroTbl[] = { 0x11, 0x00, 0x00, 0x22 };
+    static const uint8_t zeroEnc[] = { 0x02, 0x11, 0x01, 0x02, 0x22 };
+    uint8_t raw[600];
+    uint8_t enc[700];
+    size_t  len;
+
+    TEST_ASSERT_EQUAL_UINT32(sizeof(zeroEnc), cobsEncode(zeroTbl, sizeof(zeroTbl), enc));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(zeroEnc, enc, sizeof(zeroEnc));
+    TEST_ASSERT_EQUAL_UINT32(sizeof(zeroTbl), cobsDecode(enc, sizeof(zeroEnc), raw));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(zeroTbl, raw, sizeof(zeroTbl));
+
+    for (uint16_t i = 0; i < sizeof(raw); i++) {
+        raw[i] = (i % 100) + 1; // No zeros, forces full 254 byte code blocks.
+    }
+
+    for (size_t rawLen = 250; rawLen <= sizeof(raw); rawLen++) { // Across the first and second block limits.
+        len = cobsEncode(raw, rawLen, enc);
+        TEST_ASSERT_EQUAL_UINT32(rawLen + 1 + (rawLen >= 254) + (rawLen >= 508), len);
+        TEST_ASSERT_EQUAL_HEX8((rawLen >= 254) ? 0xFF : rawLen + 1, enc[0]);
+        TEST_ASSERT_NULL(memchr(enc, 0, len));
+        TEST_ASSERT_EQUAL_UINT32(rawLen, cobsDecode(enc, len, enc)); // In place.
+        TEST_ASSERT_EQUAL_HEX8_ARRAY(raw, enc, rawLen);
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(0, cobsDecode((const uint8_t *)"\x05\x11", 2, raw));     // Short block.
+    TEST_ASSERT_EQUAL_UINT32(0, cobsDecode((const uint8_t *)"\x02\x11\x00", 3, raw)); // Zero code.
+}
+
+// *********************************************************************************************
+void test_frame_round_trip(void)
+{
+    uint8_t        payload[SFRAME_PAYLOAD_MAX + 10];
+    uint8_t        frame[SFRAME_ENC_MAX];
+    uint8_t        type;
+    uint8_t        seq;
+    const uint8_t *rxPayload;
+    size_t         frameLen;
+    size_t         len;
+
+    for (uint32_t i = 0; i < ROUND_CNT; i++) {
+        len      = randomPayload(payload);
+        frameLen = serialFrameBuild(i % 4, i, payload, len, frame);
+        TEST_ASSERT_LESS_OR_EQUAL(SFRAME_ENC_MAX, frameLen);
+        TEST_ASSERT_EQUAL_HEX8(0, frame[frameLen - 1]);
+        TEST_ASSERT_NULL(memchr(frame, 0, frameLen - 1));
+        TEST_ASSERT_EQUAL_INT16(len, serialFrameParse(frame, frameLen - 1, &type, &seq, &rxPayload));
+        TEST_ASSERT_EQUAL_HEX8(i % 4, type);
+        TEST_ASSERT_EQUAL_HEX8(i & 0xFF, seq);
+
+        if (len) {
+            TEST_ASSERT_EQUAL_HEX8_ARRAY(payload, rxPayload, len);
+        }
+    }
+
+    memset(payload, 'x', sizeof(payload)); // Too long, truncated to SFRAME_PAYLOAD_MAX.
+    frameLen = serialFrameBuild(SFRAME_CMD, 1, payload, sizeof(payload), frame);
+    TEST_ASSERT_LESS_OR_EQUAL(SFRAME_ENC_MAX, frameLen);
+    TEST_ASSERT_EQUAL_INT16(SFRAME_PAYLOAD_MAX, serialFrameParse(frame, frameLen - 1, &type, &seq, &rxPayload));
+}
+
+// *********************************************************************************************
+void test_frame_corruption(void)
+{
+    uint8_t        frame[SFRAME_ENC_MAX];
+    uint8_t        goodFrame[SFRAME_ENC_MAX];
+    uint8_t        type;
+    uint8_t        seq;
+    const uint8_t *rxPayload;
+    size_t         frameLen;
+
+    frameLen = serialFrameBuild(SFRAME_CMD, 0x2A, (const uint8_t *)benchStr, sizeof(benchStr) - 1, goodFrame);
+
+    for (size_t pos = 0; pos < frameLen - 1; pos++) { // Every single bit error is caught.
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            memcpy(frame, goodFrame, frameLen);
+            frame[pos] ^= 1 << bit;
+            TEST_ASSERT_EQUAL_INT16(-1, serialFrameParse(frame, frameLen - 1, &type, &seq, &rxPayload));
+        }
+    }
+
+    for (size_t len = 0; len < frameLen - 1; len++) { // So is every truncation.
+        memcpy(frame, goodFrame, frameLen);
+        TEST_ASSERT_EQUAL_INT16(-1, serialFrameParse(frame, len, &type, &seq, &rxPayload));
+    }
+}
+
+// *********************************************************************************************
+void test_frame_stream(void)
+{
+    std::vector<uint8_t> stream;
+    std::vector<uint8_t> rxFrame;
+    uint8_t        payload[SFRAME_PAYLOAD_MAX];
+    uint8_t        frame[SFRAME_ENC_MAX];
+    uint8_t        type;
+    uint8_t        seq;
+    const uint8_t *rxPayload;
+    uint32_t       goodCnt    = 0;
+    uint32_t       noiseCnt   = 0;
+    uint32_t       noiseOkCnt = 0;
+    bool           overFlg    = false;
+    int16_t        rxLen;
+    size_t         len;
+
+    for (uint32_t i = 0; i < ROUND_CNT; i++) {
+        len = randomPayload(payload);
+        len = serialFrameBuild(SFRAME_CMD, i, payload, len, frame);
+        stream.insert(stream.end(), frame, frame + len);
+
+        if (testRandom() % 8 == 0) { // Line noise, ends at the next frame's start.
+            noiseCnt++;
+
+            for (uint8_t j = 1 + testRandom() % 32; j > 0; j--) {
+                stream.push_back(testRandom() & 0xFF);
+            }
+            stream.push_back(0);
+        }
+    }
+
+    for (uint8_t c : stream) { // Receiver, as serialBinaryService(): Collect bytes up to each zero delimiter.
+        if (c != 0) {
+            overFlg |= (rxFrame.size() >= SFRAME_ENC_MAX);
+
+            if (!overFlg) {
+                rxFrame.push_back(c);
+            }
+            continue;
+        }
+
+        if (!overFlg && !rxFrame.empty()) {
+            rxLen = serialFrameParse(rxFrame.data(), rxFrame.size(), &type, &seq, &rxPayload);
+
+            if ((rxLen >= 0) && (type == SFRAME_CMD) && (seq == (goodCnt & 0xFF))) {
+                goodCnt++;
+            }
+            else if (rxLen >= 0) {
+                noiseOkCnt++; // Noise passed the CRC.
+            }
+        }
+        rxFrame.clear();
+        overFlg = false;
+    }
+
+    TEST_ASSERT_GREATER_THAN(0, noiseCnt);
+    TEST_ASSERT_EQUAL_UINT32(ROUND_CNT, goodCnt);
+    TEST_ASSERT_EQUAL_UINT32(0, noiseOkCnt);
+}
+
+// *********************************************************************************************
+void test_frame_bench(void)
+{
+    char           msgBuff[80];
+    int16_t        payloadLen = 0;
+    uint8_t        frame[SFRAME_ENC_MAX];
+    uint8_t        seq;
+    uint8_t        type;
+    const uint8_t *payload;
+    size_t         frameLen;
+    unsigned long  benchMicros;
+
+    benchMicros = micros();
+
+    for (uint32_t i = 0; i < BENCH_CNT; i++) {
+        frameLen   = serialFrameBuild(SFRAME_CMD, i, (const uint8_t *)benchStr, sizeof(benchStr) - 1, frame);
+        payloadLen = serialFrameParse(frame, frameLen - 1, &type, &seq, &payload);
+    }
+    benchMicros = micros() - benchMicros;
+
+    snprintf(msgBuff, sizeof(msgBuff), "Round Trip: %1.3f uS/Frame (%u byte payload).", float(benchMicros) / float(BENCH_CNT),
+             (unsigned)(sizeof(benchStr) - 1));
+    TEST_MESSAGE(msgBuff);
+    TEST_ASSERT_EQUAL_INT16(sizeof(benchStr) - 1, payloadLen);
+    TEST_ASSERT_EQUAL_MEMORY(benchStr, payload, sizeof(benchStr) - 1);
+}
+
+// *********************************************************************************************
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_crc16);
+    RUN_TEST(test_cobs_vectors);
+    RUN_TEST(test_frame_round_trip);
+    RUN_TEST(test_frame_corruption);
+    RUN_TEST(test_frame_stream);
+    RUN_TEST(test_frame_bench);
+    return UNITY_END();
+}
+
+// *********************************************************************************************
+// EOF
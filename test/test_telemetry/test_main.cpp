@@ -0,0 +1,242 @@
+/*
+   File: test_main.cpp (test_telemetry)
+   Project: PixelRadio, an RBDS/RDS FM Transmitter (QN8027 Digital FM IC)
+   Version: 1.1.2
+   Creation: Oct-18-2022
+   Revised:  Oct-18-2022
+   Revision History: See PixelRadio.cpp
+   Project Leader: T. Black (thomastech)
+   Contributors: thomastech
+
+   (c) copyright T. Black 2021-2022, Licensed under GNU GPL 3.0 and later, under this
+   license absolutely no warranty is given.
+   This Code was formatted with the uncrustify extension.
+
+   Note 1: Offline Telemetry tests. Run on the host: pio test -e native -f test_telemetry
+   Note 2: The loop() task is run on a simulated clock (LOOP_MILLIS passes) through broker outages.
+           A long outage fills the ring and the spill file (LittleFS stub), a short one only spills.
+           The replay messages are collected from mqttPublish() and checked record by record.
+ */
+
+// *********************************************************************************************
+
+#include <unity.h>
+#include "../../src/telemetry.cpp" // Not in [env:native]'s source filter, it needs the globals below.
+
+// *********************************************************************************************
+
+const unsigned long LOOP_MILLIS  = 100;     // loop() pass time.
+const unsigned long CMD_MILLIS   = 10000;   // A controller command is logged this often.
+const unsigned long LONG_OUTAGE  = 6UL * 60UL * 60UL * 1000UL;
+const unsigned long SHORT_OUTAGE = 20UL * 60UL * 1000UL;
+
+// *********************************************************************************************
+// Globals and functions used by telemetry.cpp.
+bool   ctrlMqttFlg   = true;
+bool   mqttOnlineFlg = true;
+float  vbatVolts     = 5.0f;
+float  paVolts       = 9.1f;
+String mqttNameStr   = "PixelRadio";
+
+static const char cmdRecStr[] = ", \"cmd\", \"UDP\", \"rtm\"]";
+
+static unsigned long simMillis = 1000000;
+static std::vector<std::string> tlmMsgs; // Replay messages.
+
+static unsigned long simMicros(void)
+{
+    return simMillis * 1000UL;
+}
+
+uint8_t getMqttPubStats(uint32_t *dropCnt, uint32_t *mergeCnt)
+{
+    *dropCnt  = 0;
+    *mergeCnt = 0;
+    return 0; // Publish Queue is always empty.
+}
+
+bool mqttPublish(const char *topicStr, const char *payloadStr, bool retainFlg, bool coalesceFlg)
+{
+    TEST_ASSERT_EQUAL_STRING("PixelRadio" MQTT_TLM_STR, topicStr);
+    TEST_ASSERT_FALSE(coalesceFlg);
+    tlmMsgs.push_back(payloadStr);
+    return true;
+}
+
+const cmdEntry_t* getCommand(uint8_t index)
+{
+    static const cmdEntry_t rtmEntry = { CMD_RADIOTEXT_STR, "RadioText Message", NULL, NULL, CMD_CLASS_RDS, NULL, NULL,
+                                         RDS_TEXT_MAX_SZ, 0, CMD_REMOTE_CNTRLS };
+
+    return index == 1 ? &rtmEntry : NULL;
+}
+
+String getControllerName(uint8_t controller)
+{
+    return controller == UDP_CNTRL ? "UDP" : "?";
+}
+
+// *********************************************************************************************
+// runLoop(): Run loop() passes for runMillis, with a controller command every CMD_MILLIS. Returns the number of
+// commands logged while offline, and the largest spill file size in maxFileSize.
+static uint32_t runLoop(unsigned long runMillis, uint32_t *maxFileSize)
+{
+    uint32_t cmdCnt = 0;
+
+    for (unsigned long endMillis = simMillis + runMillis; simMillis < endMillis; simMillis += LOOP_MILLIS) {
+        if (simMillis % CMD_MILLIS == 0) {
+            cmdCnt += tlmRecordFlg ? 1 : 0;
+            logTelemetryCmd(UDP_CNTRL, 1);
+        }
+        setTelemetryAudio(simMillis % 1000);
+        processTelemetry();
+
+        if (LittleFS.exists(TLM_FILE_NAME)) {
+            *maxFileSize = std::max(*maxFileSize, (uint32_t)LittleFS.files[TLM_FILE_NAME].size());
+        }
+    }
+    return cmdCnt;
+}
+
+// *********************************************************************************************
+// replayOutage(): Take MQTT offline for outageMillis, then reconnect and collect the replay. Checks the replay order,
+// the record count, and the "left" count of each message. The first record must be the outage's offline record.
+static void replayOutage(unsigned long outageMillis, bool wifiFlg, uint32_t *dropCnt, uint32_t *maxFileSize)
+{
+    char          msgBuff[120];
+    char          typeStr[16];
+    char          detailStr[16];
+    uint32_t      cmdCnt;
+    uint32_t      measCnt   = 0;
+    uint32_t      replayCnt = 0;
+    uint32_t      savedCnt;
+    unsigned      ageSecs;
+    unsigned      leftCnt   = 0;
+    long          lastSecs  = 0;
+    long          recSecs;
+    unsigned long outageEnd;
+
+    *maxFileSize    = 0;
+    mqttOnlineFlg   = false;
+    WiFi.wifiStatus = wifiFlg ? WL_CONNECTED : WL_DISCONNECTED;
+    cmdCnt          = runLoop(outageMillis, maxFileSize);
+    outageEnd       = simMillis;
+
+    mqttOnlineFlg   = true;
+    WiFi.wifiStatus = WL_CONNECTED;
+    *dropCnt        = tlmDropCnt;
+    savedCnt        = getTelemetryCnt();
+    tlmMsgs.clear();
+    startTelemetryReplay();
+
+    while (tlmReplayFlg) {
+        unsigned long msgCnt = tlmMsgs.size();
+
+        runLoop(LOOP_MILLIS, maxFileSize);
+
+        if (tlmMsgs.size() == msgCnt) {
+            continue;
+        }
+        const char *msgPtr = tlmMsgs.back().c_str();
+
+        TEST_ASSERT_EQUAL_INT(0, strncmp(msgPtr, "{\"replay\": [[", 13));
+
+        for (msgPtr += 12; ; msgPtr += 2) { // Each record, "[<age>, "<type>", ...]".
+            TEST_ASSERT_EQUAL_INT(2, sscanf(msgPtr, "[%u, \"%15[^\"]\"", &ageSecs, typeStr));
+            recSecs = (long)(simMillis / MSECS_PER_SEC) - (long)ageSecs;
+            TEST_ASSERT_TRUE(recSecs + 1 >= lastSecs); // Oldest first (age is whole seconds).
+            TEST_ASSERT_TRUE(recSecs <= (long)(outageEnd / MSECS_PER_SEC));
+            lastSecs = recSecs;
+
+            if (replayCnt == 0) { // The start of the outage is kept.
+                TEST_ASSERT_EQUAL_STRING("offline", typeStr);
+                TEST_ASSERT_EQUAL_INT(1, sscanf(msgPtr, "[%*u, \"offline\", \"%15[^\"]\"", detailStr));
+                TEST_ASSERT_EQUAL_STRING(wifiFlg ? "broker" : "wifi", detailStr);
+            }
+            else if (!strcmp(typeStr, "cmd")) {
+                TEST_ASSERT_EQUAL_INT(0, strncmp(strchr(msgPtr, ','), cmdRecStr, sizeof(cmdRecStr) - 1));
+            }
+            else {
+                TEST_ASSERT_EQUAL_STRING("meas", typeStr);
+                measCnt++;
+            }
+            replayCnt++;
+            msgPtr = strchr(msgPtr, ']') + 1;
+
+            if (strncmp(msgPtr, ", [", 3)) {
+                break;
+            }
+        }
+        TEST_ASSERT_EQUAL_INT(1, sscanf(msgPtr, "], \"left\": %u}", &leftCnt));
+        TEST_ASSERT_EQUAL_UINT32(savedCnt - replayCnt, leftCnt);
+    }
+
+    snprintf(msgBuff, sizeof(msgBuff), "%lu min outage: %u records saved (%u meas), %u dropped, %u replay messages, %u file bytes max.",
+             outageMillis / 60000, replayCnt, measCnt, *dropCnt, (unsigned)tlmMsgs.size(), *maxFileSize);
+    TEST_MESSAGE(msgBuff);
+
+    TEST_ASSERT_EQUAL_UINT32(savedCnt, replayCnt);
+    TEST_ASSERT_EQUAL_UINT32(0, leftCnt);
+    TEST_ASSERT_TRUE(outageEnd / MSECS_PER_SEC - lastSecs <= TLM_SAMPLE_TIME / MSECS_PER_SEC); // The end is kept.
+    TEST_ASSERT_EQUAL_UINT32(1 + cmdCnt + outageMillis / TLM_SAMPLE_TIME, replayCnt + *dropCnt);
+    TEST_ASSERT_FALSE(LittleFS.exists(TLM_FILE_NAME));
+    TEST_ASSERT_EQUAL_UINT32(0, getTelemetryCnt());
+}
+
+// *********************************************************************************************
+void setUp(void)    {}
+void tearDown(void) {}
+
+// *********************************************************************************************
+void test_online(void)
+{
+    uint32_t maxFileSize = 0;
+
+    stubMicrosFn = simMicros;
+    initTelemetry();
+    runLoop(60000, &maxFileSize);
+    TEST_ASSERT_EQUAL_UINT32(0, getTelemetryCnt()); // Nothing saved while online.
+    TEST_ASSERT_EQUAL_UINT32(0, maxFileSize);
+    startTelemetryReplay();
+    TEST_ASSERT_FALSE(tlmReplayFlg);
+}
+
+// *********************************************************************************************
+void test_short_outage(void)
+{
+    uint32_t dropCnt;
+    uint32_t maxFileSize;
+
+    replayOutage(SHORT_OUTAGE, false, &dropCnt, &maxFileSize);
+    TEST_ASSERT_EQUAL_UINT32(0, dropCnt);
+    TEST_ASSERT_GREATER_THAN(0, maxFileSize); // Spilled.
+}
+
+// *********************************************************************************************
+void test_long_outage(void)
+{
+    uint32_t dropCnt;
+    uint32_t maxFileSize;
+
+    replayOutage(LONG_OUTAGE, true, &dropCnt, &maxFileSize);
+    TEST_ASSERT_GREATER_THAN(0, dropCnt);
+    TEST_ASSERT_LESS_OR_EQUAL(TLM_FILE_MAX_SZ, maxFileSize);
+    TEST_ASSERT_GREATER_THAN(TLM_FILE_MAX_SZ - TLM_SPILL_CNT * sizeof(tlmRec_t), maxFileSize); // Filled.
+
+    replayOutage(SHORT_OUTAGE, true, &dropCnt, &maxFileSize); // The file is reused.
+    TEST_ASSERT_EQUAL_UINT32(0, dropCnt);
+    TEST_ASSERT_EQUAL_UINT32(0, Log.errorCnt);
+}
+
+// *********************************************************************************************
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_online);
+    RUN_TEST(test_short_outage);
+    RUN_TEST(test_long_outage);
+    return UNITY_END();
+}
+
+// *********************************************************************************************
+// EOF
@@ -0,0 +1,265 @@
+/*
+   File: test_main.cpp (test_udp_control)
+   Project: PixelRadio, an RBDS/RDS FM Transmitter (QN8027 Digital FM IC)
+   Version: 1.1.2
+   Creation: Oct-18-2022
+   Revised:  Oct-18-2022
+   Revision History: See PixelRadio.cpp
+   Project Leader: T. Black (thomastech)
+   Contributors: thomastech
+
+   (c) copyright T. Black 2021-2022, Licensed under GNU GPL 3.0 and later, under this
+   license absolutely no warranty is given.
+   This Code was formatted with the uncrustify extension.
+
+   Note 1: UDP Controller tests. Run on the host: pio test -e native -f test_udp_control
+   Note 2: test_lossy_network sends numbered commands from several senders through a network that
+           loses, repeats, and reorders datagrams. Each command must run at most once, in order.
+ */
+
+// *********************************************************************************************
+
+#include <unity.h>
+#include <map>
+#include "../../src/udpControl.cpp" // Not in [env:native]'s source filter, it needs the stand-ins below.
+
+// *********************************************************************************************
+
+const uint32_t SIM_CMD_CNT = 5000; // Commands sent by each sender in the lossy network test.
+
+// *********************************************************************************************
+// Globals and functions used by udpControl.cpp.
+bool ctrlUdpFlg = true;
+
+static unsigned long simMillis = 1000;
+static std::map<uint16_t, std::vector<uint32_t> > ranCmds; // Commands run, by sender port.
+
+unsigned long getClockMillis(void)
+{
+    return simMillis;
+}
+
+static void testReply(char *replyBuff, const cmdEntry_t *cmd, bool successFlg, const String& payloadStr)
+{
+    sprintf(replyBuff, "{\"%s\": \"%s\"}", cmd->nameStr, successFlg ? "ok" : "fail");
+}
+
+static const cmdEntry_t rtmEntry = { CMD_RADIOTEXT_STR, "RadioText Message", NULL, testReply, CMD_CLASS_RDS, NULL, NULL,
+                                     RDS_TEXT_MAX_SZ, 0, (1 << UDP_CNTRL) };
+
+const cmdEntry_t* findCommand(const char *nameStr, uint8_t controller)
+{
+    return strcmp(nameStr, rtmEntry.nameStr) ? NULL : &rtmEntry;
+}
+
+int16_t getCommandArg(char *argStr, uint16_t maxSize)
+{
+    return strlen(argStr) ? strlen(argStr) : -1;
+}
+
+// dispatchCommand(): The test commands are "rtm=<port> <n>", saved in ranCmds.
+bool dispatchCommand(const cmdEntry_t *cmd, String payloadStr, uint8_t controller, char *replyBuff, uint32_t rxMicros)
+{
+    unsigned port;
+    unsigned n;
+
+    if (sscanf(payloadStr.c_str(), "%u %u", &port, &n) == 2) {
+        ranCmds[port].push_back(n);
+    }
+    cmd->replyFn(replyBuff, cmd, true, payloadStr);
+    return true;
+}
+
+// *********************************************************************************************
+// sendDatagram(): Deliver a datagram to the UDP Controller and run the UDP Task until it is idle.
+static void sendDatagram(const std::string& dataStr, uint16_t port)
+{
+    AsyncUDPPacket packet((const uint8_t *)dataStr.data(), dataStr.length(), IPAddress(192, 168, 1, 20), port);
+    udpPkt_t       pkt;
+
+    udpServer.packetFn(udpServer.packetArg, packet);
+
+    while (xQueueReceive(udpPktQueue, &pkt, 0) == pdTRUE) {
+        processUdpCommand(&pkt);
+    }
+}
+
+static uint32_t rng = 20221018;
+
+static uint32_t testRandom(void) // xorshift32.
+{
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return rng;
+}
+
+// *********************************************************************************************
+void setUp(void)    {}
+void tearDown(void) {}
+
+// *********************************************************************************************
+void test_parse_datagram(void)
+{
+    static const char *badTbl[] = { "", "rtm=Hello", "12rtm=Hello", "12 rtm", "12 =Hello", "-1 rtm=Hello", " 12 rtm=Hello" };
+    char     buff[40];
+    char    *argStr;
+    char    *cmdStr;
+    uint32_t seq;
+
+    for (uint8_t i = 0; i < sizeof(badTbl) / sizeof(badTbl[0]); i++) {
+        strcpy(buff, badTbl[i]);
+        TEST_ASSERT_FALSE(udpParseDatagram(buff, &seq, &cmdStr, &argStr));
+    }
+
+    strcpy(buff, "42  rtm=A=B\r\n");
+    TEST_ASSERT_TRUE(udpParseDatagram(buff, &seq, &cmdStr, &argStr));
+    TEST_ASSERT_EQUAL_UINT32(42, seq);
+    TEST_ASSERT_EQUAL_STRING(CMD_RADIOTEXT_STR, cmdStr);
+    TEST_ASSERT_EQUAL_STRING("A=B\r\n", argStr);
+
+    strcpy(buff, "4294967295 rtm=Max");
+    TEST_ASSERT_TRUE(udpParseDatagram(buff, &seq, &cmdStr, &argStr));
+    TEST_ASSERT_EQUAL_UINT32(0xFFFFFFFF, seq);
+}
+
+// *********************************************************************************************
+void test_sequence_filter(void)
+{
+    udpSender_t senders[UDP_SENDER_MAX];
+
+    memset(senders, 0, sizeof(senders));
+    TEST_ASSERT_TRUE(udpCheckSeq(senders, 0x0100007F, 5000, 10, 1000));                      // New sender.
+    TEST_ASSERT_FALSE(udpCheckSeq(senders, 0x0100007F, 5000, 10, 1010));                     // Duplicate.
+    TEST_ASSERT_FALSE(udpCheckSeq(senders, 0x0100007F, 5000, 9, 1020));                      // Late.
+    TEST_ASSERT_TRUE(udpCheckSeq(senders, 0x0100007F, 5001, 9, 1030));                       // Other sender.
+    TEST_ASSERT_TRUE(udpCheckSeq(senders, 0x0100007F, 5000, 11, 1040));                      // Next.
+    TEST_ASSERT_TRUE(udpCheckSeq(senders, 0x0100007F, 5000, 0, 1050));                       // Restart.
+    TEST_ASSERT_TRUE(udpCheckSeq(senders, 0x0100007F, 5000, 3, 1050 + UDP_SEQ_RESET_TIME));  // Quiet, restart.
+    TEST_ASSERT_FALSE(udpCheckSeq(senders, 0x0100007F, 5000, 0xFFFFFFFF, 20000));            // Wrap, older.
+    TEST_ASSERT_TRUE(udpCheckSeq(senders, 0x0100007F, 5000, 0x80000002, 20010));             // Wrap safe, newer.
+
+    for (uint16_t port = 6000; port < 6000 + UDP_SENDER_MAX; port++) {                       // Table full, the
+        TEST_ASSERT_TRUE(udpCheckSeq(senders, 0x0200007F, port, 1, 30000 + port));           // quietest leaves.
+    }
+    TEST_ASSERT_FALSE(udpCheckSeq(senders, 0x0200007F, 6000 + UDP_SENDER_MAX - 1, 1, 40000));
+}
+
+// *********************************************************************************************
+void test_command_reply(void)
+{
+    udpInit();
+    TEST_ASSERT_EQUAL_UINT16(UDP_PORT, udpServer.listenPort);
+
+    udpServer.replyStrs.clear();
+    sendDatagram("7 rtm=7000 1", 7000);
+    sendDatagram("7 rtm=7000 1", 7000);  // Repeated by the network, no reply.
+    sendDatagram("8 psn=Hello", 7000);   // Unknown command.
+    sendDatagram("9 rtm=", 7000);        // Missing value.
+    sendDatagram("hello", 7000);         // Not a command datagram.
+    TEST_ASSERT_EQUAL_UINT32(3, udpServer.replyStrs.size());
+    TEST_ASSERT_EQUAL_STRING("7 {\"rtm\": \"ok\"}", udpServer.replyStrs[0].c_str());
+    TEST_ASSERT_EQUAL_STRING("8 {\"cmd\": \"undefined\"}", udpServer.replyStrs[1].c_str());
+    TEST_ASSERT_EQUAL_STRING("9 {\"rtm\": \"fail\"}", udpServer.replyStrs[2].c_str());
+    TEST_ASSERT_EQUAL_UINT32(1, ranCmds[7000].size());
+    TEST_ASSERT_EQUAL_UINT32(3, Log.errorCnt); // Unknown command, missing value, and bad format.
+
+    ctrlUdpFlg = false;                  // Controller disabled, datagrams are ignored.
+    sendDatagram("10 rtm=7000 2", 7000);
+    ctrlUdpFlg = true;
+    TEST_ASSERT_EQUAL_UINT32(3, udpServer.replyStrs.size());
+}
+
+// *********************************************************************************************
+// test_lossy_network(): UDP_SENDER_MAX senders, each datagram is lost (5%), repeated (10%), or held
+// back behind later ones (10%). Every command that arrives in order must run once; Repeats and
+// late arrivals must not run.
+void test_lossy_network(void)
+{
+    typedef struct {
+        uint16_t port;
+        uint32_t seq;
+        unsigned long dueMillis; // Delivery time.
+    } simPkt_t;
+
+    std::vector<simPkt_t> inFlight;
+    char     msgBuff[100];
+    uint32_t sentCnt  = 0;
+    uint32_t lostCnt  = 0;
+    uint32_t dupCnt   = 0;
+    uint32_t lateCnt  = 0;
+    uint32_t staleStart = getUdpStaleCnt();
+    uint32_t deliverCnt = 0;
+
+    ranCmds.clear();
+    Log.errorCnt = 0;
+
+    for (uint32_t n = 1; n <= SIM_CMD_CNT; n++) {
+        for (uint16_t port = 8000; port < 8000 + UDP_SENDER_MAX; port++) {
+            uint32_t pick = testRandom() % 100;
+            unsigned long delayMillis = 1 + testRandom() % 3;
+
+            sentCnt++;
+
+            if (pick < 5) {
+                lostCnt++;
+                continue;
+            }
+            else if (pick < 15) {
+                dupCnt++;
+                inFlight.push_back({ port, n, simMillis + delayMillis + 40 });
+            }
+            else if (pick < 25) {
+                lateCnt++;
+                delayMillis += 20 + testRandom() % 100; // Overtaken by later datagrams.
+            }
+            inFlight.push_back({ port, n, simMillis + delayMillis });
+        }
+        simMillis += 10; // 100 commands/sec from each sender.
+
+        for (size_t i = 0; i < inFlight.size();) {
+            if (inFlight[i].dueMillis <= simMillis) {
+                sendDatagram(std::to_string(inFlight[i].seq) + " rtm=" + std::to_string(inFlight[i].port) + " " +
+                             std::to_string(inFlight[i].seq), inFlight[i].port);
+                deliverCnt++;
+                inFlight.erase(inFlight.begin() + i);
+            }
+            else {
+                i++;
+            }
+        }
+    }
+
+    for (auto& sender : ranCmds) { // Each command ran at most once, in order.
+        for (size_t i = 1; i < sender.second.size(); i++) {
+            TEST_ASSERT_TRUE(sender.second[i] > sender.second[i - 1]);
+        }
+    }
+
+    uint32_t ranCnt = 0;
+
+    for (auto& sender : ranCmds) {
+        ranCnt += sender.second.size();
+    }
+    snprintf(msgBuff, sizeof(msgBuff), "Lossy Network: %u sent, %u lost, %u repeated, %u late. %u ran, %u stale dropped.",
+             sentCnt, lostCnt, dupCnt, lateCnt, ranCnt, getUdpStaleCnt() - staleStart);
+    TEST_MESSAGE(msgBuff);
+    TEST_ASSERT_EQUAL_UINT32(UDP_SENDER_MAX, ranCmds.size());
+    TEST_ASSERT_EQUAL_UINT32(deliverCnt, ranCnt + getUdpStaleCnt() - staleStart);
+    TEST_ASSERT_GREATER_OR_EQUAL(sentCnt - lostCnt - lateCnt, ranCnt); // Only late datagrams may be dropped.
+    TEST_ASSERT_EQUAL_UINT32(0, Log.errorCnt);
+}
+
+// *********************************************************************************************
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_parse_datagram);
+    RUN_TEST(test_sequence_filter);
+    RUN_TEST(test_command_reply);
+    RUN_TEST(test_lossy_network);
+    return UNITY_END();
+}
+
+// *********************************************************************************************
+// EOF